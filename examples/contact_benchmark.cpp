@@ -0,0 +1,163 @@
+#include <chrono>
+#include <cmath>
+#include <algorithm>
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include <functional>
+#include "physics/ClothSimulation.h"
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+namespace {
+double elapsedMilliseconds(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+}
+
+/**
+ * @brief OGC 接觸路徑比較程序
+ *
+ * 相同的場景分別以只偵測頂點穿透的舊路徑、舊路徑加上連續碰撞偵測，以及偏移幾何接觸
+ * （頂點/邊/面偏移與保守位移界限）模擬，比較每步時間、接觸數、被界限截斷的粒子數、
+ * 布料最高點（碰撞體細部從頂點之間穿過時布料會整片掉下去），以及結束時布料三角形上
+ * 取樣點到碰撞體的最小距離（負值表示碰撞體穿過了布料的面）；偏移幾何路徑另外列出因位移仍在安全範圍內
+ * 而略過的頂點距離查詢比例。
+ */
+class ContactBenchmark {
+public:
+    using SceneSetup = std::function<void(Physics::ClothSimulation&)>;
+
+    ContactBenchmark(int steps) : m_steps(steps) {}
+
+    void runScene(const char* name, int resolution, float spacing, const SceneSetup& setup) {
+        std::cout << "\n場景: " << name << " (" << resolution << "x" << resolution << ", 間距 " << spacing
+                  << ", " << m_steps << " 步)" << std::endl;
+
+        std::cout << std::left << std::setw(22) << "路徑"
+                  << std::right << std::setw(12) << "每步(ms)"
+                  << std::setw(10) << "接觸數"
+                  << std::setw(10) << "截斷"
+                  << std::setw(16) << "略過查詢"
+                  << std::setw(12) << "最高點"
+                  << std::setw(14) << "最小距離" << std::endl;
+
+        struct Method {
+            const char* name;
+            bool offsetGeometry;
+            bool continuous;
+        };
+        const Method methods[] = {
+            {"頂點接觸", false, false},
+            {"頂點接觸 + CCD", false, true},
+            {"偏移幾何 (OGC)", true, false},
+        };
+
+        for (const Method& method : methods) {
+            Physics::ClothSimulation simulation(resolution, resolution, spacing);
+            simulation.initialize();
+            simulation.setTimeStep(1.0f / 60.0f);
+            simulation.setOffsetGeometryContacts(method.offsetGeometry);
+            simulation.setContinuousCollision(method.continuous);
+            for (int x = 0; x < resolution; ++x) {
+                simulation.setParticlePinned(x, 0, false);
+            }
+            setup(simulation);
+
+            double contacts = 0.0;
+            double clamped = 0.0;
+            double queries = 0.0;
+            double skipped = 0.0;
+            auto start = std::chrono::steady_clock::now();
+            for (int step = 0; step < m_steps; ++step) {
+                simulation.update(1.0f / 60.0f);
+                contacts += simulation.getContactCount();
+                clamped += simulation.getBoundClampCount();
+                queries += simulation.getCollisionQueryStats().queries;
+                skipped += simulation.getCollisionQueryStats().skipped;
+            }
+            double stepTime = elapsedMilliseconds(start) / m_steps;
+
+            float highest = -1e9f;
+            for (const auto& particle : simulation.getParticles()) {
+                highest = std::max(highest, static_cast<float>(particle->position.y()));
+            }
+
+            std::cout << std::left << std::setw(22) << method.name
+                      << std::right << std::fixed << std::setprecision(3)
+                      << std::setw(12) << stepTime
+                      << std::setw(10) << std::setprecision(0) << contacts / m_steps
+                      << std::setw(10) << clamped / m_steps
+                      << std::setw(11) << (queries + skipped > 0 ? 100.0 * skipped / (queries + skipped) : 0.0) << "%"
+                      << std::setw(12) << std::setprecision(3) << highest
+                      << std::setw(14) << std::setprecision(4) << minimumFaceDistance(simulation, resolution)
+                      << std::defaultfloat << std::setprecision(6) << std::endl;
+        }
+    }
+
+private:
+    int m_steps;
+
+    /**
+     * @brief 布料三角形上取樣點（頂點、邊中點、重心）到解析形狀碰撞體的最小距離
+     */
+    static float minimumFaceDistance(const Physics::ClothSimulation& simulation, int resolution) {
+        const auto& particles = simulation.getParticles();
+        const Physics::ColliderSet& colliders = simulation.getColliderSet();
+        const float samples[][3] = {
+            {1.0f, 0.0f, 0.0f}, {0.5f, 0.5f, 0.0f}, {0.0f, 0.5f, 0.5f}, {0.5f, 0.0f, 0.5f},
+            {1.0f / 3.0f, 1.0f / 3.0f, 1.0f / 3.0f},
+        };
+
+        float nearest = 1e9f;
+        for (int y = 0; y < resolution - 1; ++y) {
+            for (int x = 0; x < resolution - 1; ++x) {
+                int i1 = y * resolution + x;
+                int triangles[2][3] = {{i1, i1 + 1, i1 + resolution}, {i1 + 1, i1 + resolution + 1, i1 + resolution}};
+                for (const auto& triangle : triangles) {
+                    for (const auto& w : samples) {
+                        Physics::Vector3 point = particles[triangle[0]]->position * w[0] +
+                                                 particles[triangle[1]]->position * w[1] +
+                                                 particles[triangle[2]]->position * w[2];
+                        Physics::Vector3 normal, velocity;
+                        nearest = std::min(nearest, colliders.distance(point, nearest, normal, velocity));
+                    }
+                }
+            }
+        }
+        return nearest;
+    }
+};
+
+int main(int argc, char *argv[])
+{
+    std::cout << "=== OGC 接觸路徑比較 ===" << std::endl;
+
+    // 可由命令列指定步數，例如 ./ContactBenchmark 240
+    int steps = argc > 1 ? std::atoi(argv[1]) : 150;
+    if (steps < 1) steps = 150;
+
+    ContactBenchmark benchmark(steps);
+
+    // 光滑的大球：頂點接觸已足夠，比較成本
+    benchmark.runScene("球體", 48, 0.05f, [](Physics::ClothSimulation& simulation) {
+        simulation.addSphere(Physics::RigidTransform(Physics::Vector3(0.0f, 1.2f, 0.0f)), 0.6f);
+    });
+
+    // 比布料間距細很多的橫桿：落在兩個頂點之間，只靠頂點接觸擋不住
+    benchmark.runScene("細橫桿", 24, 0.1f, [](Physics::ClothSimulation& simulation) {
+        Physics::Quaternion alongX = Physics::Quaternion::fromAxisAngle(Physics::Vector3(0, 0, 1), float(M_PI) * 0.5f);
+        simulation.addCapsule(Physics::RigidTransform(Physics::Vector3(0.03f, 1.5f, 0.07f), alongX), 1.5f, 0.01f);
+    });
+
+    // 角朝上的盒：尖角頂在三角形內部
+    benchmark.runScene("盒角", 24, 0.1f, [](Physics::ClothSimulation& simulation) {
+        Physics::Quaternion cornerUp = Physics::Quaternion::fromAxisAngle(Physics::Vector3(1, 0, -1), 0.9553f);
+        simulation.addBox(Physics::RigidTransform(Physics::Vector3(0.04f, 1.2f, 0.06f), cornerUp),
+                          Physics::Vector3(0.25f, 0.25f, 0.25f));
+    });
+
+    return 0;
+}
@@ -1,21 +1,26 @@
-#include <QCoreApplication>
-#include <QDebug>
-#include <QTimer>
-#include <QElapsedTimer>
+#include <chrono>
 #include <iostream>
 #include <fstream>
 #include <vector>
 #include <cmath>
+#include <memory>
+#include <algorithm>
 #include "physics/ClothSimulation.h"
+#include "physics/ClothBatch.h"
+#include "physics/TaskScheduler.h"
+
+namespace {
+double elapsedMilliseconds(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+}
 
 /**
  * @brief 簡化的性能測試程序
  * 
- * 比較 OGC 模型和基本碰撞模型的性能差異，避免 Qt 類型輸出問題。
+ * 比較 OGC 模型和基本碰撞模型的性能差異，以及批次模擬與純量精度的吞吐量；不依賴 Qt。
  */
-class SimplePerformanceTest : public QObject {
-    Q_OBJECT
-
+class SimplePerformanceTest {
 public:
     struct TestResult {
         std::string name;
@@ -25,11 +30,10 @@ public:
         std::vector<double> frameTimes;
     };
 
-    SimplePerformanceTest(QObject* parent = nullptr) : QObject(parent) {
+    SimplePerformanceTest() {
         std::cout << "簡化性能測試程序初始化" << std::endl;
     }
 
-public slots:
     void runTests() {
         std::cout << "\n=== 開始性能測試 ===" << std::endl;
         
@@ -38,8 +42,8 @@ public slots:
         
         compareResults(basic, ogc);
         
-        // 退出應用程式
-        QCoreApplication::quit();
+        runBatchTest();
+        runPrecisionTest();
     }
 
 private:
@@ -47,25 +51,23 @@ private:
         std::cout << "\n測試基本碰撞模型..." << std::endl;
         
         auto simulation = std::make_unique<Physics::ClothSimulation>(15, 15, 0.2f);
-        simulation->addCylinder(QVector3D(0, -0.5f, 0), 1.0f, 2.0f);
-        simulation->setGravity(QVector3D(0, -9.8f, 0));
+        simulation->initialize();
+        simulation->addCylinder(Physics::Vector3(0, -0.5f, 0), 1.0f, 2.0f);
+        simulation->setGravity(Physics::Vector3(0, -9.8f, 0));
         simulation->setUseOGC(false); // 使用基本碰撞
         
         TestResult result;
         result.name = "基本碰撞模型";
         result.totalFrames = 300;
         
-        QElapsedTimer totalTimer;
-        totalTimer.start();
+        auto totalStart = std::chrono::steady_clock::now();
         
         for (int frame = 0; frame < result.totalFrames; ++frame) {
-            QElapsedTimer frameTimer;
-            frameTimer.start();
+            auto frameStart = std::chrono::steady_clock::now();
             
             simulation->update(0.016f);
             
-            qint64 frameTime = frameTimer.nsecsElapsed();
-            result.frameTimes.push_back(frameTime / 1000000.0); // 轉換為毫秒
+            result.frameTimes.push_back(elapsedMilliseconds(frameStart));
             
             if (frame % 60 == 0) {
                 std::cout << "  幀 " << frame << ": " 
@@ -73,7 +75,7 @@ private:
             }
         }
         
-        result.totalTime = totalTimer.elapsed();
+        result.totalTime = elapsedMilliseconds(totalStart);
         result.avgFrameTime = result.totalTime / double(result.totalFrames);
         
         std::cout << "基本碰撞模型測試完成" << std::endl;
@@ -84,8 +86,9 @@ private:
         std::cout << "\n測試 OGC 碰撞模型..." << std::endl;
         
         auto simulation = std::make_unique<Physics::ClothSimulation>(15, 15, 0.2f);
-        simulation->addCylinder(QVector3D(0, -0.5f, 0), 1.0f, 2.0f);
-        simulation->setGravity(QVector3D(0, -9.8f, 0));
+        simulation->initialize();
+        simulation->addCylinder(Physics::Vector3(0, -0.5f, 0), 1.0f, 2.0f);
+        simulation->setGravity(Physics::Vector3(0, -9.8f, 0));
         simulation->setUseOGC(true); // 啟用 OGC
         simulation->setOGCContactRadius(0.05f);
         
@@ -93,17 +96,14 @@ private:
         result.name = "OGC 碰撞模型";
         result.totalFrames = 300;
         
-        QElapsedTimer totalTimer;
-        totalTimer.start();
+        auto totalStart = std::chrono::steady_clock::now();
         
         for (int frame = 0; frame < result.totalFrames; ++frame) {
-            QElapsedTimer frameTimer;
-            frameTimer.start();
+            auto frameStart = std::chrono::steady_clock::now();
             
             simulation->update(0.016f);
             
-            qint64 frameTime = frameTimer.nsecsElapsed();
-            result.frameTimes.push_back(frameTime / 1000000.0); // 轉換為毫秒
+            result.frameTimes.push_back(elapsedMilliseconds(frameStart));
             
             if (frame % 60 == 0) {
                 std::cout << "  幀 " << frame << ": " 
@@ -111,13 +111,106 @@ private:
             }
         }
         
-        result.totalTime = totalTimer.elapsed();
+        result.totalTime = elapsedMilliseconds(totalStart);
         result.avgFrameTime = result.totalTime / double(result.totalFrames);
         
         std::cout << "OGC 碰撞模型測試完成" << std::endl;
         return result;
     }
     
+    /**
+     * @brief 比較大量獨立 ClothSimulation 物件與單一 ClothBatch 的效能
+     */
+    void runBatchTest(int instanceCount = 200, int frames = 120) {
+        std::cout << "\n測試批次模擬 (" << instanceCount << " 個小型布料)..." << std::endl;
+        
+        // 使用共用的工作竊取排程器
+        auto scheduler = std::make_shared<Physics::TaskScheduler>(Physics::TaskScheduler::hardwareThreadCount());
+        const int threadCount = scheduler->getThreadCount();
+        
+        // 各自獨立的模擬物件
+        std::vector<std::unique_ptr<Physics::ClothSimulation>> simulations;
+        for (int i = 0; i < instanceCount; ++i) {
+            auto simulation = std::make_unique<Physics::ClothSimulation>(8 + i % 8, 8, 0.1f);
+            simulation->initialize();
+            simulations.push_back(std::move(simulation));
+        }
+        
+        auto start = std::chrono::steady_clock::now();
+        for (int frame = 0; frame < frames; ++frame) {
+            for (auto& simulation : simulations) {
+                simulation->update(0.016f);
+            }
+        }
+        double separateTime = elapsedMilliseconds(start);
+        
+        // 共用陣列的批次模擬（相同網格與預設圓柱體）
+        Physics::ClothBatch batch;
+        batch.setTaskScheduler(scheduler);
+        for (int i = 0; i < instanceCount; ++i) {
+            batch.addInstance(8 + i % 8, 8, 0.1f, Physics::Vector3(0, 2.0f, 0));
+        }
+        batch.addCylinder(Physics::Vector3(0, -2, 0), 1.5f, 0.5f);
+        
+        start = std::chrono::steady_clock::now();
+        for (int frame = 0; frame < frames; ++frame) {
+            batch.update(0.016f);
+        }
+        double batchTime = elapsedMilliseconds(start);
+        
+        std::cout << "  獨立物件: " << separateTime / frames << " ms/幀" << std::endl;
+        std::cout << "  批次模擬 (" << threadCount << " 執行緒): " << batchTime / frames << " ms/幀" << std::endl;
+        std::cout << "  加速比: " << separateTime / batchTime << "x" << std::endl;
+    }
+    
+    /**
+     * @brief 純量型別與速度儲存精度：記憶體、吞吐量與遠離原點時的漂移
+     * 
+     * 純量型別在編譯期決定（OGC_DOUBLE_PRECISION），以兩種設定各編譯一次比較；
+     * 半精度速度可在執行期切換，同一次執行中直接比較。
+     */
+    void runPrecisionTest(int instanceCount = 200, int frames = 120) {
+        std::cout << "\n測試純量精度 (Real = " << (sizeof(Physics::Real) == 8 ? "double" : "float")
+                  << ", sizeof(ClothParticle) = " << sizeof(Physics::ClothParticle) << " 位元組)..." << std::endl;
+        
+        auto scheduler = std::make_shared<Physics::TaskScheduler>(Physics::TaskScheduler::hardwareThreadCount());
+        
+        for (bool halfVelocities : {false, true}) {
+            Physics::ClothBatch batch;
+            batch.setTaskScheduler(scheduler);
+            batch.setHalfPrecisionVelocities(halfVelocities);
+            
+            // 成對的實例：一個在原點附近，一個遠離原點，兩者應有相同的相對形狀
+            const Physics::Vector3 farOffset(10000.0f, 0, 0);
+            for (int i = 0; i < instanceCount / 2; ++i) {
+                batch.addInstance(16, 16, 0.1f, Physics::Vector3(0, 2.0f, 0));
+                batch.addInstance(16, 16, 0.1f, Physics::Vector3(0, 2.0f, 0) + farOffset);
+            }
+            
+            auto start = std::chrono::steady_clock::now();
+            for (int frame = 0; frame < frames; ++frame) {
+                batch.update(0.016f);
+            }
+            double elapsed = elapsedMilliseconds(start);
+            
+            // 遠離原點的實例扣除偏移後與原點附近實例的最大差異
+            const Physics::ClothBatch::Instance& nearInstance = batch.getInstance(0);
+            const Physics::ClothBatch::Instance& farInstance = batch.getInstance(1);
+            double drift = 0.0;
+            for (int p = 0; p < nearInstance.particleCount; ++p) {
+                Physics::Vector3 nearPosition = batch.getPositions()[nearInstance.firstParticle + p];
+                Physics::Vector3 farPosition = batch.getPositions()[farInstance.firstParticle + p] - farOffset;
+                drift = std::max(drift, static_cast<double>((farPosition - nearPosition).length()));
+            }
+            
+            std::cout << "  速度" << (halfVelocities ? "半精度" : "全精度") << ": "
+                      << elapsed / frames << " ms/幀, "
+                      << batch.getParticleCount() * double(frames) / (elapsed / 1000.0) / 1e6 << " M 粒子步/秒, "
+                      << batch.getMemoryUsage() / 1024.0 << " KB, "
+                      << "遠離原點漂移 " << drift << std::endl;
+        }
+    }
+    
     void compareResults(const TestResult& basic, const TestResult& ogc) {
         std::cout << "\n=== 性能比較結果 ===" << std::endl;
         
@@ -190,20 +283,12 @@ private:
     }
 };
 
-int main(int argc, char *argv[])
+int main()
 {
-    QCoreApplication app(argc, argv);
-    
     std::cout << "=== OGC 布料模擬簡化性能測試 ===" << std::endl;
     
     SimplePerformanceTest test;
+    test.runTests();
     
-    // 使用計時器延遲啟動測試
-    QTimer::singleShot(100, [&test]() {
-        test.runTests();
-    });
-    
-    return app.exec();
+    return 0;
 }
-
-#include "simple_performance_test.moc"
@@ -0,0 +1,299 @@
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <cstdlib>
+#include <cstdint>
+#include "physics/ClothSimulation.h"
+#include "physics/TaskScheduler.h"
+
+namespace {
+double elapsedMilliseconds(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+}
+
+/**
+ * @brief 約束求解器收斂測試程序
+ *
+ * 在不同解析度的網格上比較一般投影、SOR 與 Chebyshev 加速達到容差所需的迭代次數，
+ * 每個方法都從相同的暖機狀態出發（固定時間步長、確定性模式），只量測一步的求解；
+ * 另外比較每步只做少量細網格迭代時，各方法（包含階層式求解）長時間維持的應變，
+ * 以及半隱式 Euler、隱式 Euler 與 Projective Dynamics 在較大時間步長下的穩定性，
+ * 和編譯期特化的約束核心相對於通用路徑的速度。
+ */
+class SolverBenchmark {
+public:
+    struct Result {
+        std::string method;
+        int iterations;
+        float maxResidual;
+        float rmsResidual;
+        int resets;
+        double solveTime;
+    };
+
+    SolverBenchmark(float tolerance, int maxIterations, int warmupFrames)
+        : m_tolerance(tolerance)
+        , m_maxIterations(maxIterations)
+        , m_warmupFrames(warmupFrames)
+    {
+    }
+
+    void runGrid(int resolution) {
+        std::cout << "\n網格 " << resolution << "x" << resolution
+                  << " (容差 " << m_tolerance << ", 上限 " << m_maxIterations << " 次迭代)" << std::endl;
+
+        std::vector<Result> results;
+        results.push_back(runMethod(resolution, Physics::SolverAcceleration::None, "Gauss-Seidel"));
+        results.push_back(runMethod(resolution, Physics::SolverAcceleration::SOR, "SOR (w=1.5)"));
+        results.push_back(runMethod(resolution, Physics::SolverAcceleration::Chebyshev, "Chebyshev (rho=0.95)"));
+
+        std::cout << std::left << std::setw(22) << "方法"
+                  << std::right << std::setw(10) << "迭代"
+                  << std::setw(14) << "最大應變"
+                  << std::setw(14) << "RMS"
+                  << std::setw(8) << "重置"
+                  << std::setw(12) << "時間(ms)" << std::endl;
+
+        for (const Result& result : results) {
+            std::cout << std::left << std::setw(22) << result.method
+                      << std::right << std::setw(10) << result.iterations
+                      << std::setw(14) << result.maxResidual
+                      << std::setw(14) << result.rmsResidual
+                      << std::setw(8) << result.resets
+                      << std::setw(12) << std::fixed << std::setprecision(1) << result.solveTime
+                      << std::defaultfloat << std::setprecision(6) << std::endl;
+        }
+
+        const Result& baseline = results.front();
+        for (size_t i = 1; i < results.size(); ++i) {
+            if (results[i].maxResidual >= m_tolerance) {
+                std::cout << results[i].method << " 在上限內未達容差" << std::endl;
+            } else if (baseline.maxResidual >= m_tolerance) {
+                std::cout << results[i].method << " 達到容差，一般投影在上限內未達容差" << std::endl;
+            } else {
+                std::cout << results[i].method << " 迭代次數為一般投影的 "
+                          << std::setprecision(2) << double(results[i].iterations) / baseline.iterations
+                          << std::setprecision(6) << " 倍" << std::endl;
+            }
+        }
+    }
+
+    /**
+     * @brief 固定細網格迭代次數下的穩態應變：每步只做少量細網格迭代時各方法能維持的精度
+     */
+    void runSteadyState(int resolution, int fineIterations = 3, int frames = 300) {
+        std::cout << "\n網格 " << resolution << "x" << resolution
+                  << " 穩態應變 (每步 " << fineIterations << " 次細網格迭代, " << frames << " 幀)" << std::endl;
+
+        std::cout << std::left << std::setw(22) << "方法"
+                  << std::right << std::setw(14) << "平均最大應變"
+                  << std::setw(14) << "平均RMS"
+                  << std::setw(14) << "每幀(ms)" << std::endl;
+
+        struct Method {
+            const char* name;
+            Physics::SolverAcceleration acceleration;
+            bool hierarchical;
+        };
+        const Method methods[] = {
+            {"Gauss-Seidel", Physics::SolverAcceleration::None, false},
+            {"Chebyshev (rho=0.95)", Physics::SolverAcceleration::Chebyshev, false},
+            {"Multigrid", Physics::SolverAcceleration::None, true},
+        };
+
+        for (const Method& method : methods) {
+            Physics::ClothSimulation simulation(resolution, resolution, 4.0f / resolution);
+            simulation.setThreadCount(Physics::TaskScheduler::hardwareThreadCount());
+            simulation.setDeterministic(true);
+            simulation.initialize();
+
+            // 容差為 0 且上下限相同：固定迭代次數並量測每次迭代的殘差
+            simulation.setAdaptiveIterations(true);
+            simulation.setSolverTolerance(0.0f);
+            simulation.setMinConstraintIterations(fineIterations);
+            simulation.setMaxConstraintIterations(fineIterations);
+            simulation.setSolverAcceleration(method.acceleration);
+            simulation.setHierarchicalSolver(method.hierarchical);
+
+            // 前三分之一為暖機，不計入平均
+            const int warmupFrames = frames / 3;
+            double maxSum = 0.0;
+            double rmsSum = 0.0;
+            auto start = std::chrono::steady_clock::now();
+            for (int frame = 0; frame < frames; ++frame) {
+                simulation.update(0.016f);
+                if (frame >= warmupFrames) {
+                    maxSum += simulation.getSolverStats().maxResidual;
+                    rmsSum += simulation.getSolverStats().rmsResidual;
+                }
+            }
+            double frameTime = elapsedMilliseconds(start) / frames;
+
+            const int measured = frames - warmupFrames;
+            std::cout << std::left << std::setw(22) << method.name
+                      << std::right << std::setw(14) << maxSum / measured
+                      << std::setw(14) << rmsSum / measured
+                      << std::setw(14) << std::fixed << std::setprecision(2) << frameTime
+                      << std::defaultfloat << std::setprecision(6) << std::endl;
+        }
+    }
+
+    /**
+     * @brief 積分器穩定性：以基準步長的倍數模擬相同時間，比較最終最大應變與每步成本
+     */
+    void runIntegrators(int resolution, float simulatedSeconds = 3.0f) {
+        const float baseStep = 0.016f;
+        std::cout << "\n網格 " << resolution << "x" << resolution
+                  << " 積分器穩定性 (模擬 " << simulatedSeconds << " 秒)" << std::endl;
+        
+        std::cout << std::left << std::setw(22) << "積分器"
+                  << std::right << std::setw(8) << "步長"
+                  << std::setw(14) << "最大應變"
+                  << std::setw(10) << "CG迭代"
+                  << std::setw(14) << "每步(ms)" << std::endl;
+        
+        struct Method {
+            const char* name;
+            Physics::Integrator integrator;
+        };
+        const Method methods[] = {
+            {"Semi-implicit Euler", Physics::Integrator::SemiImplicitEuler},
+            {"Implicit Euler (PCG)", Physics::Integrator::ImplicitEuler},
+            {"Projective Dynamics", Physics::Integrator::ProjectiveDynamics},
+        };
+        
+        for (const Method& method : methods) {
+            for (int multiple : {1, 4, 8}) {
+                const float timeStep = baseStep * multiple;
+                Physics::ClothSimulation simulation(resolution, resolution, 4.0f / resolution);
+                simulation.setThreadCount(Physics::TaskScheduler::hardwareThreadCount());
+                simulation.setDeterministic(true);
+                simulation.initialize();
+                simulation.setIntegrator(method.integrator);
+                simulation.setTimeStep(timeStep);
+                
+                const int steps = static_cast<int>(simulatedSeconds / timeStep);
+                double cgIterations = 0.0;
+                auto start = std::chrono::steady_clock::now();
+                for (int step = 0; step < steps; ++step) {
+                    simulation.update(timeStep);
+                    cgIterations += simulation.getSolverStats().linearIterations;
+                }
+                double stepTime = elapsedMilliseconds(start) / steps;
+                
+                std::cout << std::left << std::setw(22) << method.name
+                          << std::right << std::setw(7) << multiple << "x"
+                          << std::setw(14) << simulation.computeMaxStrain()
+                          << std::setw(10) << std::fixed << std::setprecision(1) << cgIterations / steps
+                          << std::setw(14) << std::setprecision(2) << stepTime
+                          << std::defaultfloat << std::setprecision(6) << std::endl;
+            }
+        }
+    }
+
+    /**
+     * @brief 特化核心與通用路徑：相同的模擬分別以兩種路徑執行，比較每幀時間與最終狀態
+     */
+    void runKernels(int resolution, int iterations = 20, int frames = 120) {
+        std::cout << "\n網格 " << resolution << "x" << resolution
+                  << " 約束核心 (每步 " << iterations << " 次迭代, " << frames << " 幀)" << std::endl;
+        
+        std::cout << std::left << std::setw(22) << "執行緒"
+                  << std::right << std::setw(14) << "通用(ms)"
+                  << std::setw(14) << "特化(ms)"
+                  << std::setw(10) << "加速"
+                  << std::setw(10) << "結果" << std::endl;
+        
+        std::vector<int> threadCounts = {1};
+        if (Physics::TaskScheduler::hardwareThreadCount() > 1) {
+            threadCounts.push_back(Physics::TaskScheduler::hardwareThreadCount());
+        }
+        
+        for (int threadCount : threadCounts) {
+            double frameTime[2];
+            std::uint64_t hash[2];
+            for (int specialized = 0; specialized < 2; ++specialized) {
+                Physics::ClothSimulation simulation(resolution, resolution, 4.0f / resolution);
+                simulation.setThreadCount(threadCount);
+                simulation.setDeterministic(true);
+                simulation.initialize();
+                simulation.setConstraintIterations(iterations);
+                simulation.setSpecializedKernels(specialized != 0);
+                
+                auto start = std::chrono::steady_clock::now();
+                for (int frame = 0; frame < frames; ++frame) {
+                    simulation.update(0.016f);
+                }
+                frameTime[specialized] = elapsedMilliseconds(start) / frames;
+                hash[specialized] = simulation.computeStateHash();
+            }
+            
+            std::cout << std::left << std::setw(22) << threadCount
+                      << std::right << std::fixed << std::setprecision(2)
+                      << std::setw(14) << frameTime[0]
+                      << std::setw(14) << frameTime[1]
+                      << std::setw(9) << frameTime[0] / frameTime[1] << "x"
+                      << std::setw(10) << (hash[0] == hash[1] ? "相同" : "不同")
+                      << std::defaultfloat << std::setprecision(6) << std::endl;
+        }
+    }
+
+private:
+    float m_tolerance;
+    int m_maxIterations;
+    int m_warmupFrames;
+
+    Result runMethod(int resolution, Physics::SolverAcceleration acceleration, const std::string& name) {
+        // 布料實際尺寸固定，解析度越高約束鏈越長
+        Physics::ClothSimulation simulation(resolution, resolution, 4.0f / resolution);
+        simulation.setThreadCount(Physics::TaskScheduler::hardwareThreadCount());
+        simulation.setDeterministic(true);
+        simulation.initialize();
+
+        for (int frame = 0; frame < m_warmupFrames; ++frame) {
+            simulation.update(0.016f);
+        }
+
+        simulation.setAdaptiveIterations(true);
+        simulation.setSolverTolerance(m_tolerance);
+        simulation.setMaxConstraintIterations(m_maxIterations);
+        simulation.setSolverAcceleration(acceleration);
+
+        auto start = std::chrono::steady_clock::now();
+        simulation.update(0.016f);
+        double elapsed = elapsedMilliseconds(start);
+
+        const Physics::SolverStats& stats = simulation.getSolverStats();
+        return Result{name, stats.iterations, stats.maxResidual, stats.rmsResidual,
+                      stats.accelerationResets, elapsed};
+    }
+};
+
+int main(int argc, char *argv[])
+{
+    std::cout << "=== 約束求解器收斂測試 ===" << std::endl;
+
+    // 可由命令列指定網格解析度，例如 ./SolverBenchmark 512
+    std::vector<int> resolutions;
+    for (int i = 1; i < argc; ++i) {
+        resolutions.push_back(std::atoi(argv[i]));
+    }
+    if (resolutions.empty()) {
+        resolutions = {32, 64, 128};
+    }
+
+    SolverBenchmark benchmark(0.05f, 2000, 60);
+    for (int resolution : resolutions) {
+        if (resolution >= 4) {
+            benchmark.runGrid(resolution);
+            benchmark.runSteadyState(resolution);
+            benchmark.runIntegrators(resolution);
+            benchmark.runKernels(resolution);
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,178 @@
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include "physics/Vector3.h"
+#include "physics/ColliderMaterial.h"
+#include "physics/HalfFloat.h"
+#include "physics/TaskScheduler.h"
+
+namespace Physics {
+
+class OGCContactModel;
+
+/**
+ * @brief 多個獨立布料實例的批次模擬
+ *
+ * 所有實例的粒子與約束都存放在共用的連續陣列中（結構陣列 SoA），
+ * 實例之間共用同一組碰撞體與寬相位（broadphase）結構，
+ * 每一步以實例為單位交給工作竊取排程器，適合大量小型布料（旗幟、標籤、橫幅）。
+ *
+ * 每個實例的物理行為與 ClothSimulation 的規則網格相同。
+ */
+class ClothBatch {
+public:
+    /**
+     * @brief 實例在共用陣列中的範圍
+     */
+    struct Instance {
+        int firstParticle;      ///< 第一個粒子的全域索引
+        int particleCount;      ///< 粒子數
+        int firstConstraint;    ///< 第一個約束的全域索引
+        int constraintCount;    ///< 約束數
+        int width;              ///< 網格寬度
+        int height;             ///< 網格高度
+        Vector3 boundsMin;      ///< 上一步結束時的包圍盒最小角
+        Vector3 boundsMax;      ///< 上一步結束時的包圍盒最大角
+    };
+
+    /**
+     * @brief 構造函數
+     * @param threadCount 執行緒數
+     */
+    explicit ClothBatch(int threadCount = 1);
+    ~ClothBatch();
+
+    /**
+     * @brief 新增一個布料實例
+     * @param width 網格寬度
+     * @param height 網格高度
+     * @param spacing 粒子間距
+     * @param origin 布料中心位置（布料平放於 XZ 平面）
+     * @return 實例索引
+     */
+    int addInstance(int width, int height, float spacing, const Vector3& origin);
+
+    /**
+     * @brief 清除所有實例（保留碰撞體）
+     */
+    void clearInstances();
+
+    // 共用碰撞體
+    void addCylinder(const Vector3& center, float radius, float height,
+                     const ColliderMaterial& material = ColliderMaterial());
+    void clearColliders();
+
+    // 模擬控制
+    void update(float deltaTime);
+
+    // 物理參數（所有實例共用）
+    void setGravity(const Vector3& gravity) { m_gravity = gravity; }
+    void setWind(const Vector3& wind) { m_wind = wind; }
+    void setDamping(float damping) { m_damping = damping; }
+    void setTimeStep(float timeStep) { m_timeStep = timeStep; }
+    void setConstraintIterations(int iterations) { m_constraintIterations = iterations; }
+    void setUseOGC(bool enable) { m_useOGC = enable; }
+    void setOGCContactRadius(float radius);
+    void setThreadCount(int threadCount);
+    void setTaskScheduler(std::shared_ptr<TaskScheduler> scheduler) { m_scheduler = std::move(scheduler); }
+
+    /**
+     * @brief 以半精度（fp16）儲存速度，運算仍以單精度進行
+     *
+     * 速度每個粒子只佔 6 位元組。每個實例在步驟開始時把速度解碼到執行緒區域的緩衝區，
+     * 結束時再編碼回去；切換時會轉換現有的速度資料。
+     */
+    void setHalfPrecisionVelocities(bool enable);
+    bool isHalfPrecisionVelocities() const { return m_halfPrecisionVelocities; }
+
+    // 統計資訊
+    int getInstanceCount() const { return static_cast<int>(m_instances.size()); }
+    int getParticleCount() const { return static_cast<int>(m_positions.size()); }
+    int getConstraintCount() const { return static_cast<int>(m_constraints.size()); }
+    int getThreadCount() const { return m_scheduler ? m_scheduler->getThreadCount() : 1; }
+    float getSimulationTime() const { return m_simulationTime; }
+    std::size_t getMemoryUsage() const;     // 粒子、約束與實例資料佔用的位元組數
+
+    // 資料存取（供渲染與導出）
+    const Instance& getInstance(int index) const { return m_instances[index]; }
+    const std::vector<Vector3>& getPositions() const { return m_positions; }
+    const std::vector<Vector3>& getNormals() const { return m_normals; }
+    Vector3 getVelocity(int index) const;
+
+    /**
+     * @brief 計算所有實例狀態的 64 位元雜湊
+     * @return FNV-1a 雜湊值
+     */
+    std::uint64_t computeStateHash() const;
+
+private:
+    /**
+     * @brief 以索引表示的距離約束
+     */
+    struct BatchConstraint {
+        int particle1;
+        int particle2;
+        float restLength;
+    };
+
+    /**
+     * @brief 共用的圓柱體碰撞體（與 CylinderCollider 相同的幾何定義）
+     */
+    struct Cylinder {
+        Vector3 center;
+        float radius;
+        float height;
+        ColliderMaterial material;
+        Vector3 boundsMin;
+        Vector3 boundsMax;
+    };
+
+    // 共用的粒子資料（所有實例連續存放）
+    std::vector<Vector3> m_positions;
+    std::vector<Vector3> m_velocities;
+    std::vector<HalfVector3> m_halfVelocities;          // 半精度模式時取代 m_velocities
+    std::vector<Vector3> m_forces;
+    std::vector<Vector3> m_normals;
+    std::vector<float> m_invMass;
+    std::vector<unsigned char> m_pinned;
+
+    // 共用的約束資料
+    std::vector<BatchConstraint> m_constraints;
+
+    // 實例
+    std::vector<Instance> m_instances;
+
+    // 共用碰撞體與寬相位：碰撞體依包圍盒最小 X 排序
+    std::vector<Cylinder> m_cylinders;
+    bool m_broadphaseDirty;
+
+    // OGC 接觸模型（所有實例共用參數）
+    std::unique_ptr<OGCContactModel> m_ogcModel;
+    bool m_useOGC;
+
+    // 物理參數
+    Vector3 m_gravity;
+    Vector3 m_wind;
+    float m_damping;
+    float m_timeStep;
+    int m_constraintIterations;
+    float m_constraintStiffness;
+    float m_constraintDamping;
+    bool m_halfPrecisionVelocities;
+
+    // 執行緒
+    std::shared_ptr<TaskScheduler> m_scheduler;
+
+    float m_simulationTime;
+
+    // 私有方法
+    void rebuildBroadphase();
+    void stepInstance(Instance& instance, float deltaTime);
+    void handleInstanceCollisions(const Instance& instance, Vector3* velocities, float deltaTime);
+    void calculateInstanceNormals(const Instance& instance);
+    void updateInstanceBounds(Instance& instance);
+};
+
+} // namespace Physics
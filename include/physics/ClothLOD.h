@@ -0,0 +1,96 @@
+#pragma once
+
+#include "physics/ClothSimulation.h"
+#include <memory>
+#include <vector>
+
+namespace Physics {
+
+/**
+ * @brief 規則網格布料的細節層級（LOD）
+ *
+ * 以建立時的解析度為第 0 層，每往下一層把格數減半（至少 3x3 個粒子），布料的實際尺寸不變。
+ * 切換層級時以 ClothSimulation::resample() 轉移位置與速度，碰撞體與求解設定都保留。
+ * 層級可依相機距離選擇（投影大小與距離成反比，第 l 層從 switchDistance * 2^(l-1) 開始），
+ * 或依每步的 CPU 時間預算選擇；兩者都有遲滯區間，避免在門檻附近來回切換。
+ *
+ * 第 0 層的 (寬 - 1) 與 (高 - 1) 可被 2^(層數 - 1) 整除時，每一層的粒子都落在第 0 層的粒子上；
+ * 不能整除時較粗層級的固定點取最近的粒子。離開第 0 層時記錄其固定點的索引與位置，
+ * 回到第 0 層時原樣還原，來回切換不會移動固定點。
+ */
+class ClothLOD {
+public:
+    /**
+     * @brief 一個層級的網格解析度
+     */
+    struct Level {
+        int width;
+        int height;
+    };
+
+    /**
+     * @brief 構造函數
+     * @param simulation 已初始化的布料，目前的解析度作為第 0 層（匯入的網格布料只有一層）
+     * @param levelCount 層級數上限
+     */
+    ClothLOD(std::shared_ptr<ClothSimulation> simulation, int levelCount = 3);
+
+    int getLevelCount() const { return static_cast<int>(m_levels.size()); }
+    const Level& getLevelResolution(int level) const { return m_levels[level]; }
+    int getLevel() const { return m_level; }
+    int getSwitchCount() const { return m_switchCount; }   // 累計的層級切換次數
+
+    /**
+     * @brief 切換到指定層級（超出範圍時夾到最近的層級）
+     * @return 層級改變時回傳 true
+     */
+    bool setLevel(int level);
+
+    /**
+     * @brief 以第 0 層的解析度與間距重新初始化布料（取代 ClothSimulation::reset()，否則會以目前層級重建）
+     */
+    void reset();
+
+    // 選擇參數
+    void setSwitchDistance(float distance) { m_switchDistance = distance; }  // 第 1 層開始的相機距離（預設 15）
+    float getSwitchDistance() const { return m_switchDistance; }
+    void setHysteresis(float fraction) { m_hysteresis = fraction; }          // 門檻兩側的遲滯比例（預設 0.1）
+    void setFrameBudget(float milliseconds) { m_frameBudget = milliseconds; } // 每步模擬的時間預算，0 表示不限制
+    float getFrameBudget() const { return m_frameBudget; }
+
+    /**
+     * @brief 依相機到布料的距離選擇層級
+     *
+     * 距離超過下一層門檻的 (1 + 遲滯比例) 倍才換到較粗的層級，低於目前層級門檻的 (1 - 遲滯比例) 倍才換回較細的層級。
+     * @return 目前的層級
+     */
+    int selectByDistance(float cameraDistance);
+
+    /**
+     * @brief 依每步的模擬時間選擇層級
+     *
+     * 以指數移動平均估計目前層級的每步時間，假設時間與粒子數成正比估計其他層級的成本，
+     * 選擇估計值不超過預算的最細層級；換到較細的層級時估計值需低於預算的 (1 - 遲滯比例) 倍。
+     * 切換後重新累積平均，至少經過數步才會再次切換。
+     * @param stepMilliseconds 上一次 ClothSimulation::update() 花費的毫秒數
+     * @return 目前的層級
+     */
+    int selectByBudget(float stepMilliseconds);
+
+private:
+    std::shared_ptr<ClothSimulation> m_simulation;
+    std::vector<Level> m_levels;
+    float m_baseSpacing;                // 第 0 層的粒子間距
+    std::vector<PinnedParticle> m_basePins;  // 離開第 0 層時的固定點
+    int m_level;
+    int m_switchCount;
+
+    float m_switchDistance;
+    float m_hysteresis;
+
+    float m_frameBudget;
+    float m_averageStep;                // 目前層級每步時間的移動平均（毫秒）
+    int m_budgetSamples;                // 切換後累積的樣本數
+};
+
+} // namespace Physics
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <array>
+#include <string>
+#include <vector>
+#include "physics/Vector2.h"
+#include "physics/Vector3.h"
+
+namespace Physics {
+
+/**
+ * @brief 頂點排列方式
+ */
+enum class VertexOrder {
+    Original,               ///< 保留檔案中的順序
+    Morton,                 ///< 依包圍盒內量化座標的 Morton（Z 曲線）碼排序
+    ReverseCuthillMcKee     ///< 反向 Cuthill-McKee：以鄰接關係的廣度優先順序縮小頻寬
+};
+
+/**
+ * @brief 任意拓撲的三角網格布料（由 OBJ 或 PLY 匯入）
+ *
+ * 讀取時把整個檔案映射到記憶體（不支援 mmap 的平台改為一次讀入緩衝區），
+ * 以指標直接掃描文字或二進位資料，不建立逐行字串。多邊形以扇形分割為三角形。
+ *
+ * 檔案中的頂點順序通常與空間位置無關，reorder() 依 Morton 碼或 RCM 重新排列頂點，
+ * 並把三角形依最小頂點索引排序，讓約束求解與法線計算依序存取相鄰的粒子。
+ */
+class ClothMesh {
+public:
+    ClothMesh() = default;
+    ClothMesh(std::vector<Vector3> vertices, std::vector<std::array<int, 3>> triangles);
+
+    /**
+     * @brief 依副檔名（.obj 或 .ply，不分大小寫）讀取網格
+     * @param path 檔案路徑
+     * @param mesh 輸出：讀取成功時取代原有內容
+     * @return 檔案無法開啟或格式錯誤時記錄日誌並回傳 false
+     */
+    static bool load(const std::string& path, ClothMesh& mesh);
+    static bool loadOBJ(const std::string& path, ClothMesh& mesh);
+    static bool loadPLY(const std::string& path, ClothMesh& mesh);
+
+    /**
+     * @brief 從記憶體中的檔案內容解析（不需要以 '\0' 結尾）
+     */
+    static bool parseOBJ(const char* data, std::size_t size, ClothMesh& mesh);
+    static bool parsePLY(const char* data, std::size_t size, ClothMesh& mesh);
+
+    /**
+     * @brief 重新排列頂點並依新的索引排序三角形
+     * @return 每個原始頂點的新索引（用於對應固定點等外部資料）
+     */
+    std::vector<int> reorder(VertexOrder order);
+
+    /**
+     * @brief 移除退化（重複頂點）的三角形並丟棄未被使用的頂點
+     * @return 被移除的三角形數
+     */
+    int removeDegenerateTriangles();
+
+    bool empty() const { return m_triangles.empty(); }
+    int getVertexCount() const { return static_cast<int>(m_vertices.size()); }
+    int getTriangleCount() const { return static_cast<int>(m_triangles.size()); }
+    bool hasTexCoords() const { return m_texCoords.size() == m_vertices.size(); }
+
+    const std::vector<Vector3>& getVertices() const { return m_vertices; }
+    const std::vector<Vector2>& getTexCoords() const { return m_texCoords; }
+    const std::vector<std::array<int, 3>>& getTriangles() const { return m_triangles; }
+
+    /**
+     * @brief 三角形的邊依頂點索引排序且不重複，每條邊以 (較小索引, 較大索引) 表示
+     */
+    std::vector<std::array<int, 2>> buildEdges() const;
+
+    /**
+     * @brief 頂點索引的頻寬（三角形內最大索引差，RCM 排序以此為目標）
+     */
+    int computeBandwidth() const;
+
+private:
+    std::vector<Vector3> m_vertices;
+    std::vector<Vector2> m_texCoords;       // 每個頂點一個，或是空的
+    std::vector<std::array<int, 3>> m_triangles;
+
+    void applyPermutation(const std::vector<int>& newIndex);
+};
+
+} // namespace Physics
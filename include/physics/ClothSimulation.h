@@ -1,35 +1,45 @@
 #pragma once
 
+#include <array>
 #include <vector>
 #include <memory>
-#include <QVector3D>
-#include <QVector2D>
-#include <QMatrix4x4>
+#include <cstdint>
+#include <algorithm>
+#include "physics/Vector2.h"
+#include "physics/Vector3.h"
+#include "physics/ClothMesh.h"
+#include "physics/TaskScheduler.h"
+#include "physics/OGCContactModel.h"
+#include "physics/ColliderSet.h"
 
 namespace Physics {
 
+class ImplicitSolver;
+class ProjectiveSolver;
+
 /**
  * @brief 布料粒子類別
  */
 class ClothParticle {
 public:
-    ClothParticle(const QVector3D& position, float mass = 1.0f);
+    ClothParticle(const Vector3& position, float mass = 1.0f);
     
     // 物理屬性
-    QVector3D position;
-    QVector3D velocity;
-    QVector3D acceleration;
-    QVector3D force;
+    Vector3 position;
+    Vector3 velocity;
+    Vector3 acceleration;
+    Vector3 force;
     float mass;
     float invMass;
     bool pinned;  // 是否固定
+    bool sleeping;  // 所在區塊是否休眠中（不積分也不求解）
     
     // 渲染屬性
-    QVector3D normal;
-    QVector2D texCoord;
+    Vector3 normal;
+    Vector2 texCoord;
     
     void update(float deltaTime);
-    void addForce(const QVector3D& f);
+    void addForce(const Vector3& f);
     void clearForces();
 };
 
@@ -40,8 +50,24 @@ class ClothConstraint {
 public:
     ClothConstraint(ClothParticle* p1, ClothParticle* p2, float restLength = -1.0f);
     
-    void satisfy();
-    void render();
+    /**
+     * @brief 投影約束
+     * @param relaxation 修正量的鬆弛係數（SOR 的 ω，1 表示一般投影）
+     * @return 投影前的相對應變 |L - L0| / L0（用於殘差統計）
+     */
+    float satisfy(float relaxation = 1.0f);
+    
+    /**
+     * @brief 特化的投影核心，結果與 satisfy() 逐位元相同
+     * 
+     * 兩端是否固定與是否套用阻尼在編譯期決定，批次迴圈內不需要分支；
+     * CheckSleep 為 false 時連休眠檢查也一併省略。
+     */
+    template <bool Movable1, bool Movable2, bool Damped, bool CheckSleep>
+    float project(float relaxation);
+    
+    float getRestLength() const { return restLength; }
+    float getDamping() const { return damping; }
     
     // 公開成員變數以便渲染訪問
     ClothParticle* particle1;
@@ -58,19 +84,82 @@ private:
  */
 class CylinderCollider {
 public:
-    CylinderCollider(const QVector3D& center, float radius, float height);
+    CylinderCollider(const Vector3& center, float radius, float height);
     
-    bool checkCollision(ClothParticle* particle, QVector3D& contactPoint, QVector3D& contactNormal);
-    void render();
+    bool checkCollision(ClothParticle* particle, Vector3& contactPoint, Vector3& contactNormal);
     
-    QVector3D center;
+    /**
+     * @brief 到有蓋圓柱表面的有號距離（內部為負）
+     * @param normal 輸出：最近表面的外向法線
+     */
+    float signedDistance(const Vector3& position, Vector3& normal) const;
+    
+    Vector3 center;
     float radius;
     float height;
-    QMatrix4x4 transform;
+    
+    // 動畫：姿態的平移決定中心，圓柱保持直立；旋轉只影響表面速度（例如滾筒）
+    ColliderMotion motion;
+    ColliderVelocity velocity;
+    ColliderMaterial material;
+};
+
+/**
+ * @brief 約束求解統計（上一步）
+ */
+struct SolverStats {
+    int iterations = 0;         ///< 實際執行的約束迭代次數
+    float maxResidual = 0.0f;   ///< 最後一次迭代前的最大相對應變（自適應模式或啟用加速時量測）
+    float rmsResidual = 0.0f;   ///< 最後一次迭代前的均方根相對應變（自適應模式或啟用加速時量測）
+    int accelerationResets = 0; ///< 殘差上升而退回一般投影的次數
+    int linearIterations = 0;   ///< 隱式積分：共軛梯度迭代次數
+    float linearResidual = 0.0f;///< 隱式積分：共軛梯度的相對殘差
+};
+
+/**
+ * @brief 上一步頂點距離查詢的統計
+ */
+struct CollisionQueryStats {
+    int queries = 0;            ///< 實際執行的頂點距離查詢次數
+    int skipped = 0;            ///< 位移仍在安全範圍內而略過的查詢次數
+};
+
+/**
+ * @brief 固定點的粒子索引與位置
+ */
+struct PinnedParticle {
+    int index;
+    Vector3 position;
+};
+
+/**
+ * @brief 上一步使用的模擬品質（時間預算模式依耗時選擇）
+ */
+struct StepQuality {
+    int level = 0;                  ///< 品質等級，0 為完整品質
+    int substeps = 1;               ///< 子步數
+    int constraintIterations = 0;   ///< 每個子步的約束迭代次數（自適應模式為上限）
+    bool normalsUpdated = true;     ///< 這一步是否重算法線
+    float stepMilliseconds = 0.0f;  ///< 這一步 update() 實際花費的時間
+};
+
+/**
+ * @brief 時間積分方式
+ */
+enum class Integrator {
+    SemiImplicitEuler,  ///< 半隱式 Euler 加位置約束投影（預設）
+    ImplicitEuler,      ///< 隱式 Euler：約束視為彈簧，與接觸彈簧一起以共軛梯度求解
+    ProjectiveDynamics  ///< Projective Dynamics：平行局部投影加預先分解的全域求解
 };
 
-// OGC 接觸模型前向聲明
-class OGCContactModel;
+/**
+ * @brief 約束求解加速方式
+ */
+enum class SolverAcceleration {
+    None,       ///< 一般 Gauss-Seidel 投影
+    SOR,        ///< 逐次超鬆弛：每個約束的修正量乘上 ω
+    Chebyshev   ///< Chebyshev 半迭代：以前兩次迭代的位置外插
+};
 
 /**
  * @brief 布料模擬主類別
@@ -83,6 +172,39 @@ public:
     // 模擬控制
     void initialize();
     void initialize(int width, int height, float spacing);  // 帶參數的初始化
+    
+    /**
+     * @brief 以任意三角網格建立布料
+     * 
+     * 每條三角形邊一個結構約束，每條內部邊在兩側三角形的對角頂點之間加一個彎曲約束；
+     * 靜止長度取自網格的頂點座標。粒子依網格的頂點順序存放（匯入後可先以 ClothMesh::reorder()
+     * 重新排列），getWidth() 為頂點數、getHeight() 為 1。不會自動固定任何粒子，
+     * 網格會保留下來，reset() 與 initialize() 以同一個網格重建；階層式求解只適用規則網格。
+     */
+    void initialize(const ClothMesh& mesh);
+    bool isMeshCloth() const { return m_meshCloth; }
+    
+    /**
+     * @brief 在模擬中途改變規則網格的解析度，保留目前的形狀與運動
+     * 
+     * 布料的實際寬度不變（間距依寬度調整），新粒子的位置與速度取自舊網格在相同參數座標的雙線性內插，
+     * 每個舊固定點固定新網格中最近的粒子，位置沿用內插結果，因此 (寬 - 1) 不能整除時也不會拉扯布料。
+     * 碰撞體、求解設定與模擬時間都保留，所有區塊喚醒。
+     * 高度方向以相同的間距建立靜止長度，長寬比與原本不同時布料會沿高度方向伸縮。
+     * @return 匯入的網格布料不支援，記錄日誌並回傳 false
+     */
+    bool resample(int width, int height);
+    
+    /**
+     * @brief 改變解析度並以指定的固定點取代最近粒子的對應（例如回到先前記錄的解析度）
+     * @param pins 新網格上的固定點索引與位置
+     */
+    bool resample(int width, int height, const std::vector<PinnedParticle>& pins);
+    
+    /**
+     * @brief 目前所有固定點的索引與位置
+     */
+    std::vector<PinnedParticle> getPinnedParticles() const;
     void update(float deltaTime);
     void reset();
     void pause() { m_paused = true; }
@@ -90,28 +212,100 @@ public:
     bool isPaused() const { return m_paused; }
     
     // 場景設定
-    void addCylinder(const QVector3D& center, float radius, float height);
-    void setGravity(const QVector3D& gravity) { m_gravity = gravity; }
-    void setWind(const QVector3D& wind) { m_wind = wind; }
-    void setDamping(float damping) { m_damping = damping; }
+    void addCylinder(const Vector3& center, float radius, float height);
+    
+    /**
+     * @brief 加入由封閉三角網格體素化而成的有號距離場碰撞體
+     * 
+     * 距離場在呼叫時一次建好（使用模擬的排程器平行建構），之後每步只做三線性查詢。
+     * 與圓柱體不同，initialize() 與 reset() 不會移除距離場碰撞體。
+     * @param vertices 網格頂點
+     * @param indices 三角形頂點索引，每三個一組
+     * @param voxelSize 網格間距
+     * @param bandVoxels 精確計算距離的窄帶寬度（體素數）
+     * @return 建立的碰撞體（由模擬擁有）
+     */
+    SDFCollider* addSDFCollider(const std::vector<Vector3>& vertices, const std::vector<int>& indices,
+                                float voxelSize = 0.05f, int bandVoxels = 3);
+    void clearSDFColliders();
+    
+    /**
+     * @brief 加入解析形狀碰撞體（球體、膠囊、盒、平面）
+     * 
+     * 形狀依型別分區儲存並以批次查詢；膠囊沿局部 Y 軸，平面法線為局部 +Y。
+     * 與距離場相同，initialize() 與 reset() 不會移除這些碰撞體。
+     */
+    ColliderHandle addSphere(const RigidTransform& transform, float radius);
+    ColliderHandle addCapsule(const RigidTransform& transform, float halfHeight, float radius);
+    ColliderHandle addBox(const RigidTransform& transform, const Vector3& halfExtents);
+    ColliderHandle addPlane(const RigidTransform& transform);
+    void clearPrimitiveColliders();
+    
+    /**
+     * @brief 設定碰撞體的運動（關鍵影格或等速）
+     * 
+     * 每一步開始時以該步結束的時間求值一次，更新姿態與表面速度；接觸的阻尼、反彈與摩擦
+     * 使用粒子相對於碰撞體表面的速度。網格碰撞體以 refit 更新 BVH，距離場只更新變換。
+     */
+    void setColliderMotion(const ColliderHandle& handle, const ColliderMotion& motion);
+    ColliderHandle getColliderHandle(const SDFCollider* collider) const { return m_colliders.getHandle(collider); }
+    ColliderHandle getColliderHandle(const MeshCollider* collider) const { return m_colliders.getHandle(collider); }
+    
+    /**
+     * @brief 設定圓柱體（依加入順序的索引）的運動
+     */
+    void setCylinderMotion(int index, const ColliderMotion& motion);
+    
+    /**
+     * @brief 設定碰撞體的庫倫摩擦係數
+     * 
+     * OGC 與基本碰撞模式都在接觸響應的同一個迴圈內套用位置層級的靜/動摩擦，
+     * 布料可以停在碰撞體上而不需要提高阻尼或迭代次數。
+     */
+    void setColliderMaterial(const ColliderHandle& handle, const ColliderMaterial& material);
+    void setCylinderMaterial(int index, const ColliderMaterial& material);
+    
+    /**
+     * @brief 加入三角網格碰撞體（BVH 加速，可隨頂點動畫更新）
+     * @param vertices 網格頂點
+     * @param indices 三角形頂點索引，每三個一組（逆時針為正面）
+     * @param thickness 表面厚度，距離表面小於此值的粒子產生接觸
+     * @return 建立的碰撞體（由模擬擁有）
+     */
+    MeshCollider* addMeshCollider(const std::vector<Vector3>& vertices, const std::vector<int>& indices,
+                                  float thickness = 0.02f);
+    
+    /**
+     * @brief 更新網格碰撞體的頂點（角色動畫），以 O(n) 重算 BVH 包圍盒並喚醒布料
+     */
+    void updateMeshCollider(MeshCollider* collider, const std::vector<Vector3>& vertices);
+    void clearMeshColliders();
+    void setGravity(const Vector3& gravity) { if (gravity != m_gravity) { m_gravity = gravity; wakeUp(); } }
+    void setWind(const Vector3& wind) { if (wind != m_wind) { m_wind = wind; wakeUp(); } }
+    void setDamping(float damping) { if (damping != m_damping) { m_damping = damping; wakeUp(); } }
     
     // OGC 設定
     void enableOGC(bool enable) { m_useOGC = enable; }
     void setUseOGC(bool enable) { m_useOGC = enable; }  // 別名方法
     void setOGCContactRadius(float radius);
     
-    // 渲染
-    void render();
-    void renderWireframe();
-    void renderParticles();
-    void renderConstraints();
-    void renderColliders();
-    
     // 統計資訊
     int getParticleCount() const { return m_particles.size(); }
     int getConstraintCount() const { return m_constraints.size(); }
     float getSimulationTime() const { return m_simulationTime; }
     
+    // 唯讀存取（渲染轉接層與匯出使用，規則網格的粒子索引為 y * width + x）
+    int getWidth() const { return m_width; }
+    int getHeight() const { return m_height; }
+    float getSpacing() const { return m_spacing; }
+    const std::vector<std::array<int, 3>>& getTriangles() const { return m_triangles; }  // 逆時針為正面
+    const std::vector<ClothParticle*>& getParticles() const { return m_particles; }
+    const std::vector<std::unique_ptr<ClothConstraint>>& getConstraints() const { return m_constraints; }
+    const std::vector<std::unique_ptr<CylinderCollider>>& getCylinders() const { return m_cylinders; }
+    const std::vector<std::unique_ptr<SDFCollider>>& getSDFColliders() const { return m_colliders.getSDFs(); }
+    const std::vector<std::unique_ptr<MeshCollider>>& getMeshColliders() const { return m_colliders.getMeshes(); }
+    const ColliderSet& getColliderSet() const { return m_colliders; }
+    
     // OGC 狀態查詢
     bool getUseOGC() const { return m_useOGC; }
     float getOGCContactRadius() const;
@@ -119,50 +313,436 @@ public:
     // 時間步長設定
     void setTimeStep(float timeStep) { m_timeStep = timeStep; }
     
+    /**
+     * @brief 每一步拆成的子步數（預設 1），每個子步各自執行外力、碰撞、積分與約束求解
+     */
+    void setSubsteps(int substeps) { m_substeps = std::max(1, substeps); }
+    int getSubsteps() const { return m_substeps; }
+    
+    /**
+     * @brief 設定每步的時間預算（毫秒，0 表示停用，預設停用）
+     * 
+     * 以內部計時器量測每次 update() 的耗時並取移動平均，超過預算時降低一級品質，
+     * 連續一段時間低於預算的 60% 才回升一級（相鄰等級的成本最多差約 1.6 倍，回升後仍在預算內）。
+     * 品質依序降低：隔步重算法線、子步數減半直到 1、約束迭代降為 3/4、1/2、1/4，最後每 4 步才重算法線。
+     * 自適應迭代時降低的是迭代上限；隱式積分與 Projective Dynamics 只受子步與法線影響。
+     * 布料沒有自身碰撞，與碰撞體的接觸偵測維持每個子步一次，不會因降級而穿透。
+     */
+    void setFrameBudget(float milliseconds);
+    float getFrameBudget() const { return m_frameBudget; }
+    const StepQuality& getStepQuality() const { return m_stepQuality; }
+    
+    /**
+     * @brief 設定時間積分方式
+     * 
+     * 隱式 Euler 以彈簧取代位置約束投影，彈簧與 OGC 接觸彈簧的剛度都隱式處理，
+     * 因此可以用 setTimeStep() 設定比半隱式 Euler 大數倍的時間步長而保持穩定。
+     * Projective Dynamics 的全域矩陣在拓撲固定時為常數，只在初始化、固定點、
+     * 剛度或時間步長改變時重新分解，每步只需前代與回代，適合較硬的布料。
+     */
+    void setIntegrator(Integrator integrator) { m_integrator = integrator; }
+    Integrator getIntegrator() const { return m_integrator; }
+    void setImplicitStiffness(float stiffness);
+    void setImplicitDamping(float damping);
+    void setImplicitSolverIterations(int iterations);
+    void setImplicitSolverTolerance(float tolerance);
+    void setProjectiveStiffness(float stiffness);
+    void setProjectiveIterations(int iterations);
+    int getFactorizationCount() const;                  // Projective Dynamics 累計的矩陣分解次數
+    
+    /**
+     * @brief 固定或釋放網格上的粒子（會喚醒所有區塊）
+     */
+    void setParticlePinned(int x, int y, bool pinned);
+    bool isParticlePinned(int x, int y) const;
+    void setParticlePinned(int index, bool pinned);     // 以粒子索引（網格布料的頂點索引）
+    
+    // 約束求解設定
+    void setConstraintIterations(int iterations) { m_constraintIterations = iterations; }
+    int getConstraintIterations() const { return m_constraintIterations; }
+    
+    /**
+     * @brief 啟用殘差驅動的自適應迭代
+     * 
+     * 每次迭代時量測約束的最大與均方根相對應變，最大值低於容差時提早結束；
+     * 劇烈運動時則持續迭代直到上限。啟用時忽略 setConstraintIterations()。
+     * 預設容差 0.25：懸掛的布料在角落固定點附近的應變，20 次 Gauss-Seidel 迭代後仍約有 0.14 到 0.21，
+     * 更小的容差在靜止時也達不到，每一步都會迭代到上限。
+     */
+    void setAdaptiveIterations(bool enable) { m_adaptiveIterations = enable; }
+    bool isAdaptiveIterations() const { return m_adaptiveIterations; }
+    void setSolverTolerance(float tolerance) { m_solverTolerance = tolerance; }  // 最大相對應變
+    void setMinConstraintIterations(int iterations) { m_minConstraintIterations = iterations; }
+    void setMaxConstraintIterations(int iterations) { m_maxConstraintIterations = iterations; }
+    const SolverStats& getSolverStats() const { return m_solverStats; }
+    
+    /**
+     * @brief 設定約束求解加速方式
+     * 
+     * 兩種加速都會量測每次迭代的殘差；殘差上升時，該步剩餘的迭代退回一般投影（SOR），
+     * 或重新開始 Chebyshev 序列，避免發散。
+     */
+    void setSolverAcceleration(SolverAcceleration acceleration) { m_solverAcceleration = acceleration; }
+    SolverAcceleration getSolverAcceleration() const { return m_solverAcceleration; }
+    void setRelaxationFactor(float omega) { m_relaxationFactor = std::clamp(omega, 1.0f, 1.95f); }     // SOR 的 ω
+    void setSpectralRadius(float rho) { m_spectralRadius = std::clamp(rho, 0.0f, 0.9999f); }          // Chebyshev 的 ρ
+    
+    /**
+     * @brief 使用編譯期特化的約束投影核心（預設開啟）
+     * 
+     * 約束依兩端固定狀態與阻尼預先分組，每組以對應的樣板實例求解；
+     * 關閉時退回逐一呼叫 ClothConstraint::satisfy() 的通用路徑，兩者結果相同。
+     */
+    void setSpecializedKernels(bool enable) { m_specializedKernels = enable; }
+    bool isSpecializedKernels() const { return m_specializedKernels; }
+    
+    /**
+     * @brief 啟用階層式（多重網格）求解
+     * 
+     * 以步距 2^l 取樣規則網格建立較粗的布料層級，每一步先由最粗層往細層求解約束，
+     * 並將各層節點的位移以雙線性內插延拓到細網格，再進行一般的細網格迭代。
+     * 低頻誤差在粗層只需少量迭代即可消除，高解析度布料收斂所需的細網格迭代因此大幅減少。
+     */
+    void setHierarchicalSolver(bool enable);
+    bool isHierarchicalSolver() const { return m_hierarchicalSolver; }
+    void setHierarchyLevels(int levels);                 // 最多的粗層數（受網格大小限制）
+    void setCoarseIterations(int iterations) { m_coarseIterations = iterations; }
+    int getHierarchyLevelCount() const { return static_cast<int>(m_hierarchy.size()); }
+    
+    // 多執行緒設定
+    void setThreadCount(int threadCount);  // 建立專用的排程器，1 表示序列執行
+    int getThreadCount() const { return m_scheduler ? m_scheduler->getThreadCount() : 1; }
+    
+    /**
+     * @brief 使用外部排程器（可與其他模擬或 GUI 共用同一組工作執行緒）
+     *
+     * 共用排程器的模擬可以在不同執行緒上同時 update()，呼叫端會依序取得槽位 0。
+     * @param scheduler 排程器，nullptr 表示序列執行
+     */
+    void setTaskScheduler(std::shared_ptr<TaskScheduler> scheduler) { m_scheduler = std::move(scheduler); }
+    std::shared_ptr<TaskScheduler> getTaskScheduler() const { return m_scheduler; }
+    
+    /**
+     * @brief 設定確定性模式
+     * 
+     * 啟用後所有平行階段都使用固定分區，並依分區順序合併局部結果，
+     * 因此在相同執行緒數下每次執行的輸出都逐位元相同。
+     */
+    void setDeterministic(bool deterministic) { m_deterministic = deterministic; }
+    bool isDeterministic() const { return m_deterministic; }
+    
+    /**
+     * @brief 啟用區塊休眠
+     * 
+     * 網格被切成固定大小的區塊，區塊內平均動能連續 K 步低於門檻時進入休眠，
+     * 不再積分與求解，直到外部事件（重力、風力、碰撞體變更）或相鄰區塊運動將其喚醒。
+     */
+    void setSleepingEnabled(bool enable);
+    bool isSleepingEnabled() const { return m_sleepingEnabled; }
+    void setSleepThreshold(float kineticEnergy) { m_sleepThreshold = kineticEnergy; }
+    void setSleepFrames(int frames) { m_sleepFrames = frames; }
+    
+    /**
+     * @brief 喚醒所有休眠區塊
+     */
+    void wakeUp();
+    
+    int getTileCount() const { return static_cast<int>(m_tileAwake.size()); }
+    int getAwakeTileCount() const { return m_awakeTileCount; }
+    
+    /**
+     * @brief 啟用連續碰撞偵測（CCD）
+     * 
+     * 積分與約束求解之後，以每個粒子這一步的起點與終點做保守推進：沿線段反覆前進
+     * 「到最近碰撞體的距離 /（位移長度 + 碰撞體移動上界）」，距離小於容差時即為碰撞時間（TOI），
+     * 粒子停在碰撞點外側並移除朝向碰撞體的法向速度。大步長也不會穿過薄的碰撞體；
+     * 起點已經穿透的粒子仍由離散碰撞處理。
+     */
+    void setContinuousCollision(bool enable) { m_continuousCollision = enable; }
+    bool isContinuousCollisionEnabled() const { return m_continuousCollision; }
+    int getContinuousHitCount() const { return m_continuousHitCount; }
+    
+    /**
+     * @brief 啟用 OGC 偏移幾何接觸（預設啟用，只在 OGC 模式下有效）
+     * 
+     * 布料的頂點、邊與三角形各自向外偏移接觸半徑 r，碰撞體進入偏移幾何時產生接觸；
+     * 邊與面只處理頂點接觸涵蓋不到的部分（碰撞體的尖角或細部卡在兩個頂點之間）。
+     * 偵測時同時求出每個特徵到碰撞體的距離，這一步每個頂點的位移限制在
+     * γ 倍相鄰特徵（頂點、邊、面）的最小距離以內，因此不需要連續碰撞偵測也不會穿透。
+     * 停用時使用只偵測頂點穿透的舊路徑（與 ClothBatch 相同）。
+     */
+    void setOffsetGeometryContacts(bool enable) { m_offsetContacts = enable; }
+    bool isOffsetGeometryContactsEnabled() const { return m_offsetContacts; }
+    
+    /**
+     * @brief 上一步位移被保守界限截斷的粒子數
+     */
+    int getBoundClampCount() const { return m_boundClampCount; }
+    
+    /**
+     * @brief 上一步偵測到的接觸數（包含邊與面接觸）
+     */
+    int getContactCount() const { return static_cast<int>(m_contacts.size()); }
+    
+    /**
+     * @brief 略過位移仍在安全範圍內的頂點距離查詢（預設啟用，只在偏移幾何接觸時有效）
+     * 
+     * 每次查詢記下頂點位置與到碰撞體的距離（查詢上限放寬為所需範圍的兩倍）；之後的步驟中，
+     * 頂點自查詢以來的位移加上碰撞體的移動量仍小於距離減去這一步所需的查詢範圍時，
+     * 查詢結果必定是範圍上限，直接沿用而不再查詢，接觸與位移界限與每步查詢完全相同。
+     * 加入、移除碰撞體或更新網格碰撞體時所有頂點重新查詢。
+     */
+    void setQuerySkipping(bool enable);
+    bool isQuerySkippingEnabled() const { return m_querySkipping; }
+    const CollisionQueryStats& getCollisionQueryStats() const { return m_queryStats; }
+    
+    /**
+     * @brief 計算目前粒子狀態（位置與速度）的 64 位元雜湊
+     * @return FNV-1a 雜湊值，可用於快取比對與確定性測試
+     */
+    std::uint64_t computeStateHash() const;
+    
+    /**
+     * @brief 計算所有約束目前的最大相對應變 |L - L0| / L0（不修改狀態）
+     * @return 最大相對應變；任一粒子位置非有限值時回傳無限大
+     */
+    float computeMaxStrain() const;
+    
 private:
     // 布料網格
     int m_width, m_height;
     float m_spacing;
-    std::vector<std::unique_ptr<ClothParticle>> m_particles;
+    std::vector<ClothParticle> m_particleStorage;        // 連續存放的粒子資料（規則網格為列優先順序）
+    std::vector<ClothParticle*> m_particles;             // 以粒子索引存取 m_particleStorage
     std::vector<std::unique_ptr<ClothConstraint>> m_constraints;
+    std::vector<std::array<int, 3>> m_triangles;         // 法線、偏移幾何接觸與渲染共用的三角形
+    bool m_meshCloth;                                    // 粒子來自 m_mesh 而不是規則網格
+    ClothMesh m_mesh;
     
     // 碰撞體
     std::vector<std::unique_ptr<CylinderCollider>> m_cylinders;
+    ColliderSet m_colliders;        // 解析形狀、距離場與三角網格，依型別分區
     
     // OGC 接觸模型
     std::unique_ptr<OGCContactModel> m_ogcModel;
     bool m_useOGC;
     
     // 物理參數
-    QVector3D m_gravity;
-    QVector3D m_wind;
+    Vector3 m_gravity;
+    Vector3 m_wind;
     float m_damping;
     float m_timeStep;
     int m_constraintIterations;
     
+    // 自適應迭代
+    bool m_adaptiveIterations;
+    float m_solverTolerance;
+    int m_minConstraintIterations;
+    int m_maxConstraintIterations;
+    SolverStats m_solverStats;
+    
+    // 求解加速
+    SolverAcceleration m_solverAcceleration;
+    float m_relaxationFactor;
+    float m_spectralRadius;
+    std::vector<Vector3> m_iteratePrevious;              // Chebyshev：前一次迭代前的位置
+    std::vector<Vector3> m_iterateCurrent;               // Chebyshev：本次迭代前的位置
+    
+    /**
+     * @brief 階層式求解的一個粗層
+     */
+    struct HierarchyLevel {
+        struct Constraint {
+            int node1;
+            int node2;
+            float restLength;
+        };
+        
+        std::vector<int> columns;                        // 取樣的細網格 x 座標
+        std::vector<int> rows;                           // 取樣的細網格 y 座標
+        std::vector<int> fineIndex;                      // 節點對應的細網格粒子索引
+        std::vector<Vector3> positions;
+        std::vector<Vector3> displacements;              // 求解前存放起始位置，求解後改存位移
+        std::vector<unsigned char> fixed;                // 固定或休眠中的節點
+        std::vector<Constraint> constraints;
+        
+        // 細網格到粗層格子的對應：格子索引與雙線性權重
+        std::vector<int> cellX, cellY;
+        std::vector<float> weightX, weightY;
+    };
+    
+    bool m_hierarchicalSolver;
+    int m_hierarchyLevels;
+    int m_coarseIterations;
+    std::vector<HierarchyLevel> m_hierarchy;
+    
+    // 隱式積分
+    Integrator m_integrator;
+    std::unique_ptr<ImplicitSolver> m_implicitSolver;
+    std::unique_ptr<ProjectiveSolver> m_projectiveSolver;
+    
+    /**
+     * @brief 每個槽位的殘差局部結果（對齊快取行避免偽共享）
+     */
+    struct alignas(64) SlotResidual {
+        float maxStrain;
+        double sumSquares;
+    };
+    std::vector<SlotResidual> m_slotResiduals;
+    
     // 模擬狀態
     bool m_paused;
     float m_simulationTime;
     
+    // 多執行緒
+    std::shared_ptr<TaskScheduler> m_scheduler;
+    bool m_deterministic;
+    TaskGraph m_stepGraph;                               // 多執行緒時每一步的階段相依圖
+    bool m_stepGraphUsesOGC;                             // 任務圖建立時的碰撞模式
+    Integrator m_stepGraphIntegrator;                    // 任務圖建立時的積分方式
+    float m_stepDeltaTime;                               // 目前這個子步的時間步長（供任務圖使用）
+    
+    /**
+     * @brief 時間預算模式的一個品質等級
+     */
+    struct QualitySetting {
+        int substeps;
+        int iterations;
+        int normalInterval;     // 每幾步重算一次法線
+        
+        bool operator==(const QualitySetting& other) const {
+            return substeps == other.substeps && iterations == other.iterations && normalInterval == other.normalInterval;
+        }
+    };
+    
+    // 子步與時間預算
+    int m_substeps;
+    float m_frameBudget;
+    int m_qualityLevel;
+    float m_averageStepTime;                             // 目前等級每步耗時的移動平均（毫秒）
+    int m_qualitySamples;                                // 換到目前等級後量測的步數
+    int m_underBudgetSteps;                              // 連續低於回升門檻的步數
+    int m_normalStepCounter;
+    int m_stepIterations;                                // 這一步的約束迭代次數（自適應模式為上限）
+    bool m_updateNormals;                                // 這一步是否重算法線（任務圖的法線階段依此略過）
+    StepQuality m_stepQuality;
+    std::vector<OGCContactModel::ContactInfo> m_contacts;
+    std::vector<std::vector<OGCContactModel::ContactInfo>> m_slotContacts;
+    std::vector<ClothConstraint*> m_batchedConstraints;  // 依著色批次排序的約束
+    std::vector<int> m_batchOffsets;                     // 每個批次在 m_batchedConstraints 中的起點
+    
+    /**
+     * @brief 一段使用同一個特化核心的連續約束
+     */
+    struct ConstraintRun {
+        int kernel;     // 位元 0、1：兩端可移動；位元 2：有阻尼
+        int begin;
+        int end;
+    };
+    bool m_specializedKernels;
+    std::vector<ConstraintRun> m_serialRuns;             // m_constraints 原始順序中的連續區段
+    std::vector<ConstraintRun> m_batchRuns;              // 各批次內依核心分組的區段（相對批次起點）
+    std::vector<int> m_batchRunOffsets;                  // 每個批次在 m_batchRuns 中的起點
+    std::vector<Vector3> m_faceNormals;                  // 平行法線計算用的三角形法線
+    
+    // 區塊休眠
+    bool m_sleepingEnabled;
+    float m_sleepThreshold;                              // 平均動能門檻
+    int m_sleepFrames;                                   // 連續低於門檻多少步後休眠
+    int m_tilesX, m_tilesY;
+    std::vector<unsigned char> m_tileAwake;
+    std::vector<int> m_tileQuietFrames;                  // 連續低於門檻的步數
+    std::vector<float> m_tileEnergy;
+    std::vector<Vector3> m_previousPositions;            // 上一步的位置，用於估計實際速度
+    int m_awakeTileCount;
+    
+    // 連續碰撞
+    bool m_continuousCollision;
+    int m_continuousHitCount;                            // 上一步 CCD 攔下的粒子數
+    std::vector<Vector3> m_stepStartPositions;           // 積分前的位置（CCD 線段起點）
+    std::vector<int> m_slotHitCounts;
+    float m_cylinderMotionBound;                         // 這一步圓柱體中心的最大位移
+    
+    // OGC 偏移幾何：布料特徵（邊與三角形）、特徵到碰撞體的距離與頂點的保守位移界限
+    bool m_offsetContacts;
+    std::vector<std::array<int, 2>> m_featureEdges;
+    std::vector<int> m_vertexFeatureOffsets;             // 每個頂點相鄰特徵在 m_vertexFeatures 中的起點
+    std::vector<int> m_vertexFeatures;                   // 邊 e 存為 e，面 f（m_triangles 的索引）存為 邊數 + f
+    float m_maxFeatureEdge;                              // 靜止狀態下最長的邊
+    std::vector<float> m_vertexDistances;                // 頂點到碰撞體的距離（超過查詢上限時為上限）
+    std::vector<Vector3> m_vertexNormals;
+    std::vector<float> m_featureDistances;               // 邊與面到碰撞體距離的估計（邊在前）
+    std::vector<float> m_displacementBounds;             // 這一步每個頂點的最大位移
+    std::vector<unsigned char> m_featureLimited;         // 界限由明顯更近的邊或面決定（不能只以頂點重新查詢放寬）
+    std::vector<float> m_lastDisplacements;              // 上一步每個頂點的實際位移（決定查詢範圍）
+    std::vector<int> m_slotClampCounts;
+    int m_boundClampCount;
+    
+    // 略過查詢：上一次查詢時的頂點位置、距離（含碰撞體當時的累計移動量）
+    bool m_querySkipping;
+    bool m_queryCacheValid;
+    std::vector<Vector3> m_queryAnchors;
+    std::vector<float> m_queryDistances;
+    std::vector<float> m_queryTravel;
+    float m_colliderTravel;                              // 碰撞體表面累計移動量的上界
+    std::vector<int> m_slotQueryCounts;
+    std::vector<int> m_slotSkipCounts;
+    CollisionQueryStats m_queryStats;
+    
     // 私有方法
+    void createCloth();                                  // 清除並建立粒子、約束與依拓撲而定的資料
+    void buildSolverData();                              // 固定點設定後建立求解器資料
+    bool resampleGrid(int width, int height, const std::vector<PinnedParticle>* pins);  // pins 為 nullptr 時對應最近粒子
     void createClothMesh();
     void createConstraints();
+    void createMeshParticles();
+    void createMeshConstraints();
+    void buildContactFeatures();
+    std::vector<QualitySetting> buildQualityLadder() const;
+    void adjustQuality(float milliseconds, int levelCount);
     void applyForces();
-    void satisfyConstraints();
+    void solveConstraints();
+    void satisfyConstraints(bool measureResidual, float relaxation);
+    void storeIterate(std::vector<Vector3>& iterate);
+    void extrapolateIterate(float omega);
+    void buildHierarchy();
+    void solveHierarchy();
+    void solveHierarchyLevel(HierarchyLevel& level);
     void handleCollisions();
+    template <typename Callback>
+    void forEachColliderContact(int begin, int end, Callback&& callback) const;
+    void detectContacts();
+    void detectOffsetContacts();
+    void collidersChanged();
+    void resolveContacts();
+    void resolveBasicCollisions();
     void updateParticles(float deltaTime);
+    void integrate(float deltaTime);
+    void advance(float deltaTime);
+    float colliderDistance(const Vector3& position, float maxDistance, Vector3& normal, Vector3& velocity,
+                           ColliderMaterial* material = nullptr) const;
+    bool usesDisplacementBounds() const;
+    void enforceDisplacementBounds(float deltaTime);
+    void updateColliderMotion(float time, float deltaTime);
+    void resolveContinuousCollisions();
+    
+    // 平行化輔助
+    void buildConstraintBatches();
+    void buildConstraintKernels();                       // 固定點改變後需重建
+    void buildStepGraph();
+    void runParallel(int count, int grainSize, const TaskScheduler::RangeFunction& fn);
+    void calculateNormalsParallel();
+    void calculateMeshNormals();
+    
+    // 休眠輔助
+    void buildSleepTiles();
+    void updateSleepState(float deltaTime);
+    void setTileAwake(int tile, bool awake);
     
     // 輔助方法
     ClothParticle* getParticle(int x, int y);
     int getParticleIndex(int x, int y) const;
     void calculateNormals();
-    
-    // 渲染輔助
-    void setupRenderData();
-    std::vector<float> m_vertices;
-    std::vector<unsigned int> m_indices;
-    unsigned int m_VAO = 0, m_VBO = 0, m_EBO = 0;  // 初始化為 0
-    bool m_renderDataDirty;
 };
 
 } // namespace Physics
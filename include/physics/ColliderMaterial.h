@@ -0,0 +1,15 @@
+#pragma once
+
+namespace Physics {
+
+/**
+ * @brief 碰撞體的接觸材質（庫倫摩擦係數）
+ *
+ * 靜摩擦係數應不小於動摩擦係數；兩者皆為 0 時接觸沒有切向摩擦。
+ */
+struct ColliderMaterial {
+    float staticFriction = 0.5f;    ///< 靜摩擦係數 μs
+    float kineticFriction = 0.4f;   ///< 動摩擦係數 μk
+};
+
+} // namespace Physics
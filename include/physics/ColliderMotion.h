@@ -0,0 +1,68 @@
+#pragma once
+
+#include <vector>
+#include "physics/RigidTransform.h"
+
+namespace Physics {
+
+/**
+ * @brief 碰撞體在某一時刻的剛體速度
+ */
+struct ColliderVelocity {
+    Vector3 linear;     ///< 旋轉中心的線速度
+    Vector3 angular;    ///< 角速度（世界座標）
+    Vector3 pivot;      ///< 旋轉中心（碰撞體姿態的原點）
+
+    /// 碰撞體上一點的速度
+    Vector3 at(const Vector3& point) const { return linear + Vector3::crossProduct(angular, point - pivot); }
+};
+
+/**
+ * @brief 碰撞體的運動：關鍵影格或等速運動
+ *
+ * 預設建構為靜止。關鍵影格之間平移線性內插、旋轉以 slerp 內插，因此每段之內線速度與角速度固定；
+ * 超出最後一個影格時停在最後的姿態，loop 模式則從第一個影格重播。
+ * 等速運動由起始姿態、固定的線速度與繞姿態原點的角速度解析求值。時間一律為模擬時間。
+ */
+class ColliderMotion {
+public:
+    struct Keyframe {
+        float time;
+        RigidTransform transform;
+    };
+
+    ColliderMotion() = default;
+
+    /**
+     * @param keyframes 關鍵影格（不需排序）
+     * @param loop 是否循環播放
+     */
+    static ColliderMotion keyframed(std::vector<Keyframe> keyframes, bool loop = false);
+
+    /**
+     * @param start 時間 0 的姿態
+     * @param linear 線速度
+     * @param angular 繞姿態原點的角速度（世界座標，大小為弧度/秒）
+     */
+    static ColliderMotion constantVelocity(const RigidTransform& start, const Vector3& linear, const Vector3& angular);
+
+    bool isAnimated() const { return m_mode != Mode::Static; }
+
+    RigidTransform evaluate(float time) const;
+    ColliderVelocity velocity(float time) const;
+
+private:
+    enum class Mode { Static, Keyframed, ConstantVelocity };
+
+    Mode m_mode = Mode::Static;
+    std::vector<Keyframe> m_keyframes;  // 依時間排序
+    bool m_loop = false;
+    RigidTransform m_start;
+    Vector3 m_linear;
+    Vector3 m_angular;
+
+    float wrapTime(float time) const;
+    int findSegment(float time) const;
+};
+
+} // namespace Physics
@@ -0,0 +1,220 @@
+#pragma once
+
+#include <vector>
+#include <memory>
+#include "physics/Vector3.h"
+#include "physics/RigidTransform.h"
+#include "physics/ColliderMaterial.h"
+#include "physics/ColliderMotion.h"
+#include "physics/SDFCollider.h"
+#include "physics/MeshCollider.h"
+
+namespace Physics {
+
+/**
+ * @brief 球體碰撞體
+ */
+struct SphereCollider {
+    Vector3 center;
+    float radius;
+    ColliderVelocity velocity;  ///< 動畫碰撞體的速度（靜止時為零）
+    ColliderMaterial material;  ///< 摩擦係數
+};
+
+/**
+ * @brief 膠囊碰撞體（線段加半徑，兩端為半球）
+ */
+struct CapsuleCollider {
+    Vector3 pointA;
+    Vector3 pointB;
+    float radius;
+    ColliderVelocity velocity;
+    ColliderMaterial material;
+};
+
+/**
+ * @brief 有向盒碰撞體
+ */
+struct BoxCollider {
+    RigidTransform transform;
+    Vector3 halfExtents;
+    ColliderVelocity velocity;
+    ColliderMaterial material;
+};
+
+/**
+ * @brief 無限平面碰撞體：dot(normal, x) = offset，法線指向外側
+ */
+struct PlaneCollider {
+    Vector3 normal;
+    float offset;
+    ColliderVelocity velocity;
+    ColliderMaterial material;
+};
+
+/**
+ * @brief 碰撞查詢結果
+ */
+struct ColliderContact {
+    int index;              ///< 查詢點在輸入陣列中的索引
+    Vector3 point;          ///< 碰撞體表面上的接觸點
+    Vector3 normal;         ///< 指向碰撞體外側的單位法線
+    float depth;            ///< 穿透深度（> 0）
+    Vector3 velocity;       ///< 碰撞體表面在接觸點的速度
+    ColliderMaterial material;  ///< 碰撞體的摩擦係數
+};
+
+/**
+ * @brief 碰撞體型別
+ */
+enum class ColliderType {
+    Sphere,
+    Capsule,
+    Box,
+    Plane,
+    SDF,
+    Mesh
+};
+
+/**
+ * @brief 碰撞體識別（型別加上在該型別陣列中的索引），用於設定運動與材質
+ */
+struct ColliderHandle {
+    ColliderType type = ColliderType::Sphere;
+    int index = -1;
+
+    bool isValid() const { return index >= 0; }
+};
+
+/**
+ * @brief 依型別分區儲存的碰撞體集合
+ *
+ * 每種碰撞體各自存放在連續陣列中，查詢時對每個型別執行一個緊湊的迴圈：
+ * 先計算整個區塊所有點到該碰撞體的有號距離（無分支、可向量化），再把穿透的點壓縮成接觸。
+ * 查詢點每 64 個一個區塊，區塊內的輸出順序固定為 球體、膠囊、盒、平面、距離場、三角網格，
+ * 同型別內依加入順序，因此結果可重現。
+ */
+class ColliderSet {
+public:
+    /**
+     * @brief 加入碰撞體
+     *
+     * 球體以變換的平移為球心；膠囊沿局部 Y 軸，兩端點在 ±halfHeight；
+     * 盒以變換為中心與方向；平面通過變換的原點，法線為局部 +Y。
+     */
+    ColliderHandle addSphere(const RigidTransform& transform, float radius);
+    ColliderHandle addCapsule(const RigidTransform& transform, float halfHeight, float radius);
+    ColliderHandle addBox(const RigidTransform& transform, const Vector3& halfExtents);
+    ColliderHandle addPlane(const RigidTransform& transform);
+    SDFCollider* addSDF(std::unique_ptr<SDFCollider> collider);
+    MeshCollider* addMesh(std::unique_ptr<MeshCollider> collider);
+
+    /**
+     * @brief 取得距離場或網格碰撞體的識別，不屬於這個集合時回傳無效識別
+     */
+    ColliderHandle getHandle(const SDFCollider* collider) const;
+    ColliderHandle getHandle(const MeshCollider* collider) const;
+
+    /**
+     * @brief 設定碰撞體的運動，取代加入時的姿態
+     *
+     * 基本形狀的尺寸保留，姿態改由運動決定；距離場與網格以建構時的頂點座標為局部座標。
+     * 傳入靜止的運動會移除動畫，碰撞體停在目前的位置。
+     */
+    void setMotion(const ColliderHandle& handle, const ColliderMotion& motion);
+    bool isAnimated() const { return !m_animations.empty(); }
+
+    /**
+     * @brief 設定碰撞體的摩擦係數（預設為 ColliderMaterial 的預設值）
+     */
+    void setMaterial(const ColliderHandle& handle, const ColliderMaterial& material);
+
+    /**
+     * @brief 上一次 updateMotion() 時是否有碰撞體在移動（位移或表面速度不為零）
+     */
+    bool isMoving() const { return m_moving; }
+
+    /**
+     * @brief 在每一步開始時求值所有動畫碰撞體
+     *
+     * 更新姿態與速度，網格碰撞體以變換後的頂點 refit（不重建 BVH），距離場只更新變換；
+     * 同時以 time - deltaTime 的姿態估計這一步中表面移動量的上界。
+     */
+    void updateMotion(float time, float deltaTime);
+
+    /**
+     * @brief 移除所有基本形狀（球體、膠囊、盒、平面），保留距離場與三角網格
+     */
+    void clearPrimitives();
+    void clearSDFs();
+    void clearMeshes();
+
+    bool empty() const {
+        return m_spheres.empty() && m_capsules.empty() && m_boxes.empty() && m_planes.empty() && m_sdfs.empty() &&
+               m_meshes.empty();
+    }
+
+    /**
+     * @brief 查詢一組點與所有碰撞體的穿透接觸
+     * @param positions 查詢點
+     * @param count 點數
+     * @param contacts 輸出：接觸附加在尾端（不清除既有內容）
+     */
+    void collide(const Vector3* positions, int count, std::vector<ColliderContact>& contacts) const;
+
+    /**
+     * @brief 點到所有碰撞體的最小有號距離（連續碰撞的保守推進使用）
+     *
+     * 回傳值不大於真實距離：距離場網格外的點以到網格範圍的距離代替，
+     * 網格碰撞體以到表面的無號距離減去厚度計算（兩面皆可阻擋）。
+     * @param position 查詢點
+     * @param maxDistance 搜尋上限，超過時直接回傳此值
+     * @param normal 輸出：最近碰撞體在該點的外向法線（回傳值小於 maxDistance 時有效）
+     * @param velocity 輸出：最近碰撞體表面在該點的速度
+     * @param material 輸出（可為 nullptr）：最近碰撞體的材質，回傳值小於 maxDistance 時才寫入
+     */
+    float distance(const Vector3& position, float maxDistance, Vector3& normal, Vector3& velocity,
+                   ColliderMaterial* material = nullptr) const;
+
+    /**
+     * @brief 這一步中碰撞體表面移動量的上界（動畫碰撞體與網格 refit 的位移）
+     *
+     * 平面的旋轉不計入（無限大平面上的點移動量沒有上界），只計算沿法線的平移。
+     */
+    float getMotionBound() const;
+
+    const std::vector<SphereCollider>& getSpheres() const { return m_spheres; }
+    const std::vector<CapsuleCollider>& getCapsules() const { return m_capsules; }
+    const std::vector<BoxCollider>& getBoxes() const { return m_boxes; }
+    const std::vector<PlaneCollider>& getPlanes() const { return m_planes; }
+    const std::vector<std::unique_ptr<SDFCollider>>& getSDFs() const { return m_sdfs; }
+    const std::vector<std::unique_ptr<MeshCollider>>& getMeshes() const { return m_meshes; }
+
+private:
+    std::vector<SphereCollider> m_spheres;
+    std::vector<CapsuleCollider> m_capsules;
+    std::vector<BoxCollider> m_boxes;
+    std::vector<PlaneCollider> m_planes;
+    std::vector<std::unique_ptr<SDFCollider>> m_sdfs;
+    std::vector<std::unique_ptr<MeshCollider>> m_meshes;
+    std::vector<ColliderVelocity> m_sdfVelocities;
+    std::vector<ColliderVelocity> m_meshVelocities;
+    std::vector<ColliderMaterial> m_sdfMaterials;
+    std::vector<ColliderMaterial> m_meshMaterials;
+
+    // 動畫碰撞體
+    struct Animation {
+        ColliderHandle handle;
+        ColliderMotion motion;
+        float halfHeight = 0.0f;            // 膠囊
+        float reach = 0.0f;                 // 表面到旋轉中心的最大距離（估計旋轉造成的位移）
+        std::vector<Vector3> restVertices;  // 網格的局部頂點
+    };
+    std::vector<Animation> m_animations;
+    float m_animationBound = 0.0f;
+    bool m_moving = false;
+
+    void removeAnimations(ColliderType type);
+};
+
+} // namespace Physics
@@ -0,0 +1,82 @@
+#pragma once
+
+#include "physics/Vector3.h"
+
+namespace Physics {
+
+/**
+ * @brief 點到三角形的最近點
+ *
+ * 依 Voronoi 區域分類（頂點、邊、面），只使用點積，不需要開根號。
+ * @param p 查詢點
+ * @param a 三角形頂點
+ * @param b 三角形頂點
+ * @param c 三角形頂點
+ * @return 三角形上距離 p 最近的點
+ */
+inline Vector3 closestPointOnTriangle(const Vector3& p, const Vector3& a, const Vector3& b, const Vector3& c) {
+    const Vector3 ab = b - a;
+    const Vector3 ac = c - a;
+    const Vector3 ap = p - a;
+
+    const Real d1 = Vector3::dotProduct(ab, ap);
+    const Real d2 = Vector3::dotProduct(ac, ap);
+    if (d1 <= 0 && d2 <= 0) return a;
+
+    const Vector3 bp = p - b;
+    const Real d3 = Vector3::dotProduct(ab, bp);
+    const Real d4 = Vector3::dotProduct(ac, bp);
+    if (d3 >= 0 && d4 <= d3) return b;
+
+    const Real vc = d1 * d4 - d3 * d2;
+    if (vc <= 0 && d1 >= 0 && d3 <= 0) {
+        return a + ab * (d1 / (d1 - d3));
+    }
+
+    const Vector3 cp = p - c;
+    const Real d5 = Vector3::dotProduct(ab, cp);
+    const Real d6 = Vector3::dotProduct(ac, cp);
+    if (d6 >= 0 && d5 <= d6) return c;
+
+    const Real vb = d5 * d2 - d1 * d6;
+    if (vb <= 0 && d2 >= 0 && d6 <= 0) {
+        return a + ac * (d2 / (d2 - d6));
+    }
+
+    const Real va = d3 * d6 - d5 * d4;
+    if (va <= 0 && (d4 - d3) >= 0 && (d5 - d6) >= 0) {
+        return b + (c - b) * ((d4 - d3) / ((d4 - d3) + (d5 - d6)));
+    }
+
+    const Real denom = Real(1) / (va + vb + vc);
+    return a + ab * (vb * denom) + ac * (vc * denom);
+}
+
+/**
+ * @brief 沿 +X 方向的射線與三角形求交（Möller–Trumbore 的軸向特化）
+ * @param origin 射線起點
+ * @param a 三角形頂點
+ * @param b 三角形頂點
+ * @param c 三角形頂點
+ * @param hitX 輸出：交點的 X 座標
+ * @return 射線（含反方向）所在直線是否穿過三角形內部
+ */
+inline bool intersectLineX(const Vector3& origin, const Vector3& a, const Vector3& b, const Vector3& c, Real& hitX) {
+    // 投影到 YZ 平面，以有向面積判斷點是否在三角形內
+    const Real ay = a.y() - origin.y(), az = a.z() - origin.z();
+    const Real by = b.y() - origin.y(), bz = b.z() - origin.z();
+    const Real cy = c.y() - origin.y(), cz = c.z() - origin.z();
+
+    const Real w0 = by * cz - bz * cy;
+    const Real w1 = cy * az - cz * ay;
+    const Real w2 = ay * bz - az * by;
+    if ((w0 < 0 || w1 < 0 || w2 < 0) && (w0 > 0 || w1 > 0 || w2 > 0)) return false;
+
+    const Real sum = w0 + w1 + w2;
+    if (sum == 0) return false;  // 三角形與 X 軸平行
+
+    hitX = (w0 * a.x() + w1 * b.x() + w2 * c.x()) / sum;
+    return true;
+}
+
+} // namespace Physics
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include "physics/Vector3.h"
+
+namespace Physics {
+
+/**
+ * @brief IEEE 754 半精度（binary16）與單精度之間的轉換
+ *
+ * 只用於儲存：運算一律轉回 float 進行。採用最接近偶數的捨入，
+ * 超出範圍的值飽和為無限大，非正規數完整保留。
+ */
+inline std::uint16_t floatToHalf(float value) {
+    std::uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+
+    const std::uint32_t sign = (bits >> 16) & 0x8000u;
+    const std::uint32_t absolute = bits & 0x7fffffffu;
+
+    if (absolute >= 0x7f800000u) {
+        // 無限大與 NaN（NaN 保留為 quiet NaN）
+        return static_cast<std::uint16_t>(sign | 0x7c00u | (absolute > 0x7f800000u ? 0x0200u : 0u));
+    }
+    if (absolute >= 0x477ff000u) {
+        // 捨入後超過最大的半精度有限值
+        return static_cast<std::uint16_t>(sign | 0x7c00u);
+    }
+    if (absolute < 0x38800000u) {
+        // 非正規數或零：把隱含的 1 補回尾數後右移，並依最接近偶數捨入
+        if (absolute < 0x33000000u) return static_cast<std::uint16_t>(sign);
+        const std::uint32_t mantissa = (absolute & 0x007fffffu) | 0x00800000u;
+        const int totalShift = 126 - static_cast<int>(absolute >> 23);
+        std::uint32_t result = mantissa >> totalShift;
+        const std::uint32_t remainder = mantissa & ((1u << totalShift) - 1u);
+        const std::uint32_t halfway = 1u << (totalShift - 1);
+        if (remainder > halfway || (remainder == halfway && (result & 1u))) {
+            ++result;
+        }
+        return static_cast<std::uint16_t>(sign | result);
+    }
+
+    // 正規數：重新偏移指數並捨入尾數（進位可能自然進到指數）
+    std::uint32_t result = ((absolute - 0x38000000u) >> 13);
+    const std::uint32_t remainder = absolute & 0x1fffu;
+    if (remainder > 0x1000u || (remainder == 0x1000u && (result & 1u))) {
+        ++result;
+    }
+    return static_cast<std::uint16_t>(sign | result);
+}
+
+inline float halfToFloat(std::uint16_t half) {
+    const std::uint32_t sign = static_cast<std::uint32_t>(half & 0x8000u) << 16;
+    const std::uint32_t exponent = (half >> 10) & 0x1fu;
+    std::uint32_t mantissa = half & 0x03ffu;
+    std::uint32_t bits;
+
+    if (exponent == 0x1fu) {
+        bits = sign | 0x7f800000u | (mantissa << 13);
+    } else if (exponent != 0) {
+        bits = sign | ((exponent + 112u) << 23) | (mantissa << 13);
+    } else if (mantissa == 0) {
+        bits = sign;
+    } else {
+        // 非正規數：正規化尾數
+        int shift = 0;
+        while ((mantissa & 0x0400u) == 0) {
+            mantissa <<= 1;
+            ++shift;
+        }
+        bits = sign | (static_cast<std::uint32_t>(113 - shift) << 23) | ((mantissa & 0x03ffu) << 13);
+    }
+
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+/**
+ * @brief 以半精度儲存的三維向量（6 位元組）
+ */
+struct HalfVector3 {
+    std::uint16_t x = 0;
+    std::uint16_t y = 0;
+    std::uint16_t z = 0;
+
+    HalfVector3() = default;
+    explicit HalfVector3(const Vector3& value)
+        : x(floatToHalf(static_cast<float>(value.x())))
+        , y(floatToHalf(static_cast<float>(value.y())))
+        , z(floatToHalf(static_cast<float>(value.z())))
+    {
+    }
+
+    Vector3 toVector() const {
+        return Vector3(halfToFloat(x), halfToFloat(y), halfToFloat(z));
+    }
+};
+
+} // namespace Physics
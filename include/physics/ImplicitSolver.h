@@ -0,0 +1,118 @@
+#pragma once
+
+#include <vector>
+#include <memory>
+#include "physics/Vector3.h"
+#include "physics/SpringGraph.h"
+#include "physics/OGCContactModel.h"
+#include "physics/TaskScheduler.h"
+
+namespace Physics {
+
+class ClothParticle;
+class ClothConstraint;
+
+/**
+ * @brief 隱式（後向）Euler 積分器
+ *
+ * 將布料約束視為彈簧，並把彈簧與 OGC 接觸彈簧的剛度一起隱式處理：
+ *
+ *     (M - h D - h² K) Δv = h (f + h K v)
+ *
+ * 以不顯式組裝矩陣的預條件共軛梯度法（Jacobi 預條件）求解。矩陣乘法以每個粒子
+ * 收集其相鄰彈簧的方式計算，規則網格上每個粒子的鄰接數固定，可平行且不需原子操作。
+ * 固定與休眠粒子以過濾（filter）方式排除在求解之外。
+ */
+class ImplicitSolver {
+public:
+    /**
+     * @brief 求解參數
+     */
+    struct Settings {
+        float springStiffness = 2000.0f;    ///< 彈簧剛度 k
+        float springDamping = 2.0f;         ///< 彈簧沿方向的阻尼係數
+        int maxIterations = 50;             ///< 共軛梯度最多迭代次數
+        float tolerance = 1e-4f;            ///< 相對殘差 |r| / |b| 的收斂容差
+    };
+
+    ImplicitSolver();
+    ~ImplicitSolver();
+
+    /**
+     * @brief 由約束建立彈簧與粒子鄰接表（拓撲改變時呼叫）
+     */
+    void build(const std::vector<ClothParticle*>& particles,
+               const std::vector<std::unique_ptr<ClothConstraint>>& constraints);
+
+    /**
+     * @brief 執行一個隱式步驟：更新速度與位置並清除累積的外力
+     * @param particles 粒子（外力已累積在 force 中）
+     * @param contacts 本步的接觸，接觸彈簧沿法線方向隱式處理
+     * @param contactStiffness 接觸彈簧剛度
+     * @param deltaTime 時間步長
+     * @param scheduler 排程器，nullptr 表示序列執行
+     * @param deterministic 是否使用固定分區（歸約結果逐位元可重現）
+     */
+    void step(std::vector<ClothParticle*>& particles,
+              const std::vector<OGCContactModel::ContactInfo>& contacts,
+              float contactStiffness, float deltaTime,
+              TaskScheduler* scheduler, bool deterministic);
+
+    Settings& settings() { return m_settings; }
+    const Settings& settings() const { return m_settings; }
+
+    // 上一步的統計
+    int getLastIterations() const { return m_lastIterations; }
+    float getLastResidual() const { return m_lastResidual; }
+
+private:
+    using Spring = SpringGraph::Spring;
+    using Neighbour = SpringGraph::Neighbour;
+
+    /**
+     * @brief 每個槽位的歸約局部結果（對齊快取行避免偽共享）
+     */
+    struct alignas(64) SlotSum {
+        double value[2];
+    };
+
+    Settings m_settings;
+
+    SpringGraph m_graph;
+
+    // 每一步的線性化資料
+    std::vector<Vector3> m_springDirections;             // 彈簧單位方向 d（particle1 - particle2）
+    std::vector<float> m_springStretch;                  // 伸長量 L - L0
+    std::vector<float> m_springTransverse;               // 橫向剛度比例 max(0, 1 - L0/L)
+    std::vector<Vector3> m_contactNormals;               // 每個粒子的接觸法線（無接觸時為零）
+    std::vector<unsigned char> m_fixed;
+
+    // 共軛梯度向量
+    std::vector<Vector3> m_rhs;
+    std::vector<Vector3> m_deltaVelocity;
+    std::vector<Vector3> m_residual;
+    std::vector<Vector3> m_preconditioned;
+    std::vector<Vector3> m_direction;
+    std::vector<Vector3> m_product;
+    std::vector<Vector3> m_inverseDiagonal;
+    std::vector<SlotSum> m_slotSums;
+
+    int m_lastIterations;
+    float m_lastResidual;
+
+    // 目前步驟的設定
+    TaskScheduler* m_scheduler;
+    bool m_deterministic;
+    float m_h;
+    float m_contactStiffness;
+
+    void linearize(const std::vector<ClothParticle*>& particles,
+                   const std::vector<OGCContactModel::ContactInfo>& contacts);
+    void buildRightHandSide(const std::vector<ClothParticle*>& particles);
+    Vector3 applySystem(const std::vector<ClothParticle*>& particles,
+                        const std::vector<Vector3>& x, int i) const;
+    void solve(const std::vector<ClothParticle*>& particles);
+    double mergeSlots(int component) const;
+};
+
+} // namespace Physics
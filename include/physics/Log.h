@@ -0,0 +1,37 @@
+#pragma once
+
+#include <functional>
+#include <sstream>
+#include <string>
+
+namespace Physics {
+
+/**
+ * @brief 日誌輸出函數
+ *
+ * 物理核心不依賴 Qt：預設輸出到 std::cerr，GUI 程式可改為轉送到 qDebug()。
+ */
+using LogHandler = std::function<void(const std::string& message)>;
+
+/**
+ * @brief 設定日誌輸出函數
+ * @param handler 輸出函數，傳入空函數時恢復預設輸出
+ */
+void setLogHandler(LogHandler handler);
+
+/**
+ * @brief 輸出一則日誌訊息
+ */
+void logMessage(const std::string& message);
+
+/**
+ * @brief 將所有參數串接成一則日誌訊息後輸出
+ */
+template <typename... Args>
+void logInfo(const Args&... args) {
+    std::ostringstream stream;
+    (stream << ... << args);
+    logMessage(stream.str());
+}
+
+} // namespace Physics
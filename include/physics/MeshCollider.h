@@ -0,0 +1,89 @@
+#pragma once
+
+#include <vector>
+#include "physics/Vector3.h"
+
+namespace Physics {
+
+struct ColliderContact;
+
+/**
+ * @brief 以 BVH 加速的三角網格碰撞體，支援頂點動畫
+ *
+ * 建構時以分箱 SAH 建立 BVH，並攤平成深度優先順序的節點陣列：左子節點緊接在父節點之後，
+ * 只記錄右子節點索引，每個節點 32 位元組，一條快取線放兩個節點；三角形索引也依葉節點順序重排，
+ * 葉節點內的三角形連續存放。網格變形時以 refit() 由下而上重算包圍盒，時間與節點數成正比，
+ * 不改變樹的拓撲。
+ *
+ * 網格視為帶厚度的單面表面：距離表面小於 thickness 的點產生接觸，
+ * 位於三角形背面（與逆時針法線反向）的點一律推回正面。
+ */
+class MeshCollider {
+public:
+    /**
+     * @param vertices 網格頂點
+     * @param indices 三角形頂點索引，每三個一組（逆時針為正面）
+     * @param thickness 表面厚度（接觸距離）
+     */
+    MeshCollider(const std::vector<Vector3>& vertices, const std::vector<int>& indices, float thickness = 0.02f);
+
+    /**
+     * @brief 更新頂點位置並重算 BVH 包圍盒（三角形拓撲不變）
+     *
+     * 同時記錄頂點的最大位移，連續碰撞以此作為這一步碰撞體移動量的上界。
+     * 頂點數與建構時不同時改為重建整棵樹。
+     */
+    void refit(const std::vector<Vector3>& vertices);
+
+    /**
+     * @brief 查詢距離 maxDistance 以內的最近點
+     * @param position 查詢點
+     * @param maxDistance 搜尋半徑
+     * @param closest 輸出：網格上的最近點
+     * @param triangle 輸出：最近點所在的三角形（重排後的索引）
+     * @return 搜尋半徑內有三角形時回傳 true
+     */
+    bool closestPoint(const Vector3& position, float maxDistance, Vector3& closest, int& triangle) const;
+
+    /**
+     * @brief 批次查詢一組點的接觸
+     * @param contacts 輸出：接觸附加在尾端，index 為點在輸入陣列中的索引
+     */
+    void collide(const Vector3* positions, int count, std::vector<ColliderContact>& contacts) const;
+
+    /**
+     * @brief 三角形的單位面法線（逆時針為正面，triangle 為重排後的索引）
+     */
+    Vector3 getFaceNormal(int triangle) const;
+
+    /**
+     * @brief 上一次 refit() 中頂點的最大位移
+     */
+    float getLastDisplacement() const { return m_lastDisplacement; }
+
+    const std::vector<Vector3>& getVertices() const { return m_vertices; }
+    const std::vector<int>& getIndices() const { return m_indices; }
+    int getTriangleCount() const { return static_cast<int>(m_indices.size() / 3); }
+    int getNodeCount() const { return static_cast<int>(m_nodes.size()); }
+    float getThickness() const { return m_thickness; }
+
+private:
+    // 攤平的 BVH 節點：葉節點 count > 0、offset 為第一個三角形；內部節點 count == 0、offset 為右子節點
+    struct Node {
+        float boundsMin[3];
+        int offset;
+        float boundsMax[3];
+        int count;
+    };
+
+    std::vector<Vector3> m_vertices;
+    std::vector<int> m_indices;         // 依葉節點順序重排
+    std::vector<Node> m_nodes;
+    float m_thickness;
+    float m_lastDisplacement;
+
+    void build();
+    void computeTriangleBounds(int triangle, float* boundsMin, float* boundsMax) const;
+};
+
+} // namespace Physics
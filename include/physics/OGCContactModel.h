@@ -1,29 +1,49 @@
 #pragma once
 
 #include <vector>
-#include <QVector3D>
+#include "physics/Vector3.h"
+#include "physics/ColliderMaterial.h"
 
 namespace Physics {
 
 class ClothParticle;
 
+/**
+ * @brief 布料上產生接觸的幾何特徵
+ */
+enum class ContactFeature {
+    Vertex,     ///< 頂點
+    Edge,       ///< 邊的內部
+    Face        ///< 三角形的內部
+};
+
 /**
  * @brief OGC (Offset Geometry Contact) 接觸模型
  * 
  * 這個類別實現了偏移幾何接觸模型，用於處理布料與剛體之間的接觸。
- * OGC模型通過在接觸點周圍創建偏移幾何來提供更穩定和真實的接觸響應。
+ * 布料的頂點、邊與三角形各自向外偏移接觸半徑 r，碰撞體表面進入偏移幾何時產生接觸，
+ * 接觸點的力與位置修正依重心座標分配到特徵的頂點上。
+ * 切向以位置層級的庫倫摩擦處理，係數取自每個碰撞體的 ColliderMaterial。
  */
 class OGCContactModel {
 public:
     /**
      * @brief 接觸資訊結構
+     * 
+     * 頂點接觸只使用 particle；邊與面接觸的接觸點是 Σ weights[i] · particles[i]，
+     * particle 指向權重最大的頂點（供只處理單一粒子的隱式求解器使用）。
      */
     struct ContactInfo {
         ClothParticle* particle;        ///< 參與接觸的粒子
-        QVector3D contactPoint;         ///< 接觸點位置
-        QVector3D contactNormal;        ///< 接觸法線
+        Vector3 contactPoint;           ///< 接觸點位置
+        Vector3 contactNormal;          ///< 接觸法線
         float penetrationDepth;         ///< 穿透深度
         float contactRadius;            ///< 接觸半徑
+        Vector3 colliderVelocity;       ///< 碰撞體表面在接觸點的速度（靜止碰撞體為零）
+        ColliderMaterial material;      ///< 碰撞體的摩擦係數
+        ContactFeature feature = ContactFeature::Vertex;        ///< 接觸的布料特徵
+        ClothParticle* particles[3] = {nullptr, nullptr, nullptr};  ///< 邊（2 個）或面（3 個）的頂點
+        float weights[3] = {1.0f, 0.0f, 0.0f};                  ///< 接觸點的重心座標
     };
     
     /**
@@ -44,6 +64,35 @@ public:
      */
     void processContacts(const std::vector<ContactInfo>& contacts, float deltaTime);
     
+    /**
+     * @brief 計算單一接觸的響應，不直接修改粒子
+     * 
+     * 供以連續陣列儲存粒子的批次模擬使用，結果與 processContacts 相同。
+     * @param velocity 粒子相對於碰撞體表面的速度
+     * @param contactNormal 接觸法線
+     * @param penetrationDepth 穿透深度
+     * @param force 輸出：接觸力與阻尼力的總和
+     * @param correction 輸出：位置修正量
+     */
+    void computeResponse(const Vector3& velocity, const Vector3& contactNormal, float penetrationDepth,
+                         Vector3& force, Vector3& correction) const;
+    
+    /**
+     * @brief 位置層級的庫倫摩擦
+     * 
+     * 以這一步接觸沿法向推動粒子的距離 d 作為正向量：預測的切向相對位移 |Δx_t| ≤ μs·d 時
+     * 完全黏住（靜摩擦錐內），否則沿滑動方向減少 μk·d 的位移（動摩擦）。位移修正換算成速度，
+     * 由接下來的積分帶入位置，因此在休息狀態下不需要額外的求解迭代。
+     * @param velocity 粒子相對於碰撞體表面的預測速度（已含這一步累積的力）
+     * @param contactNormal 接觸法線
+     * @param normalDisplacement 接觸在這一步沿法向造成的位移 d
+     * @param material 碰撞體的摩擦係數
+     * @param deltaTime 時間步長
+     * @return 粒子速度的修正量
+     */
+    static Vector3 computeFriction(const Vector3& velocity, const Vector3& contactNormal, float normalDisplacement,
+                                   const ColliderMaterial& material, float deltaTime);
+    
     /**
      * @brief 設定接觸半徑
      * @param radius 新的接觸半徑
@@ -93,25 +142,27 @@ private:
     void applyOGCForce(const ContactInfo& contact, float deltaTime);
     
     /**
-     * @brief 計算偏移幾何
+     * @brief 對邊或面接觸應用OGC力，依重心座標分配到特徵的頂點
      * @param contact 接觸資訊
-     * @return 偏移後的位置
+     * @param deltaTime 時間步長
      */
-    QVector3D calculateOffsetGeometry(const ContactInfo& contact);
+    void applyFeatureForce(const ContactInfo& contact, float deltaTime);
     
     /**
      * @brief 計算接觸力
-     * @param contact 接觸資訊
+     * @param contactNormal 接觸法線
+     * @param penetrationDepth 穿透深度
      * @return 接觸力向量
      */
-    QVector3D calculateContactForce(const ContactInfo& contact);
+    Vector3 calculateContactForce(const Vector3& contactNormal, float penetrationDepth) const;
     
     /**
      * @brief 計算阻尼力
-     * @param contact 接觸資訊
+     * @param velocity 粒子相對於碰撞體表面的速度
+     * @param contactNormal 接觸法線
      * @return 阻尼力向量
      */
-    QVector3D calculateDampingForce(const ContactInfo& contact);
+    Vector3 calculateDampingForce(const Vector3& velocity, const Vector3& contactNormal) const;
 };
 
 } // namespace Physics
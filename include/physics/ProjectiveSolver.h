@@ -0,0 +1,110 @@
+#pragma once
+
+#include <vector>
+#include <memory>
+#include "physics/Vector3.h"
+#include "physics/SpringGraph.h"
+#include "physics/TaskScheduler.h"
+
+namespace Physics {
+
+class ClothParticle;
+class ClothConstraint;
+
+/**
+ * @brief Projective Dynamics 求解器
+ *
+ * 每次迭代分為兩步：
+ * - 局部步：各約束獨立地把目前邊向量投影回靜止長度（平行）
+ * - 全域步：求解 (M/h² + w L) q = M/h² s + w Σ Aᵀp，L 為約束圖的 Laplacian
+ *
+ * 拓撲固定時全域矩陣為常數，只在拓撲、固定點、剛度或時間步長改變時重新分解；
+ * 每幀只需前代與回代。粒子依網格的列優先順序編號，矩陣為帶狀，
+ * 以包絡（skyline）Cholesky 分解，填入只發生在帶寬內。固定粒子自系統中消去。
+ */
+class ProjectiveSolver {
+public:
+    /**
+     * @brief 求解參數
+     */
+    struct Settings {
+        float stiffness = 1.0e6f;       ///< 約束權重 w
+        int iterations = 5;             ///< 每步的局部／全域迭代次數
+    };
+
+    ProjectiveSolver();
+    ~ProjectiveSolver();
+
+    /**
+     * @brief 由約束建立拓撲（拓撲改變時呼叫），並使現有分解失效
+     */
+    void build(const std::vector<ClothParticle*>& particles,
+               const std::vector<std::unique_ptr<ClothConstraint>>& constraints);
+
+    /**
+     * @brief 執行一個步驟：更新位置與速度並清除累積的外力
+     * @param particles 粒子（外力已累積在 force 中）
+     * @param deltaTime 時間步長
+     * @param scheduler 排程器，nullptr 表示序列執行
+     * @param deterministic 是否使用固定分區
+     */
+    void step(std::vector<ClothParticle*>& particles, float deltaTime,
+              TaskScheduler* scheduler, bool deterministic);
+
+    Settings& settings() { return m_settings; }
+    const Settings& settings() const { return m_settings; }
+
+    // 統計
+    int getFactorizationCount() const { return m_factorizationCount; }
+    float getLastMaxStrain() const { return m_lastMaxStrain; }
+
+private:
+    using Spring = SpringGraph::Spring;
+    using Neighbour = SpringGraph::Neighbour;
+
+    /**
+     * @brief 每個槽位的最大應變（對齊快取行避免偽共享）
+     */
+    struct alignas(64) SlotMax {
+        float value;
+    };
+
+    Settings m_settings;
+
+    SpringGraph m_graph;
+
+    // 分解快取：建立分解時的固定點、剛度與時間步長
+    bool m_factorized;
+    std::vector<unsigned char> m_factorPinned;
+    float m_factorStiffness;
+    float m_factorDeltaTime;
+    int m_factorizationCount;
+
+    // 包絡 Cholesky 因子 L（列儲存：第 i 列存放第 m_envelopeFirst[i] 行到對角線）
+    std::vector<int> m_unknownIndex;                     // 粒子 -> 未知數編號，固定粒子為 -1
+    std::vector<int> m_unknownParticle;                  // 未知數 -> 粒子
+    std::vector<int> m_envelopeFirst;
+    std::vector<size_t> m_envelopeOffset;
+    std::vector<double> m_factor;
+
+    // 每一步的資料
+    std::vector<Vector3> m_startPositions;
+    std::vector<Vector3> m_inertia;                      // s = x + h v + h² M⁻¹ f
+    std::vector<Vector3> m_projections;                  // 每個約束的投影邊向量 p
+    std::vector<double> m_rhs;                           // 未知數 × 3
+    std::vector<SlotMax> m_slotMax;
+
+    float m_lastMaxStrain;
+
+    // 目前步驟的設定
+    TaskScheduler* m_scheduler;
+    bool m_deterministic;
+
+    bool needsFactorization(const std::vector<ClothParticle*>& particles, float deltaTime) const;
+    void factorize(const std::vector<ClothParticle*>& particles, float deltaTime);
+    void projectConstraints(const std::vector<ClothParticle*>& particles);
+    void buildRightHandSide(const std::vector<ClothParticle*>& particles, float deltaTime);
+    void substitute();
+};
+
+} // namespace Physics
@@ -0,0 +1,131 @@
+#pragma once
+
+#include <cmath>
+#include "physics/Vector3.h"
+
+namespace Physics {
+
+/**
+ * @brief 單位四元數（旋轉）
+ */
+struct Quaternion {
+    Real w = 1, x = 0, y = 0, z = 0;
+
+    Quaternion() = default;
+    Quaternion(Real w, Real x, Real y, Real z) : w(w), x(x), y(y), z(z) {}
+
+    /**
+     * @brief 繞軸旋轉
+     * @param axis 旋轉軸（不需正規化）
+     * @param angle 旋轉角（弧度）
+     */
+    static Quaternion fromAxisAngle(const Vector3& axis, Real angle) {
+        Vector3 n = axis.normalized();
+        Real s = std::sin(angle * Real(0.5));
+        return Quaternion(std::cos(angle * Real(0.5)), n.x() * s, n.y() * s, n.z() * s);
+    }
+
+    friend Quaternion operator*(const Quaternion& a, const Quaternion& b) {
+        return Quaternion(a.w * b.w - a.x * b.x - a.y * b.y - a.z * b.z,
+                          a.w * b.x + a.x * b.w + a.y * b.z - a.z * b.y,
+                          a.w * b.y - a.x * b.z + a.y * b.w + a.z * b.x,
+                          a.w * b.z + a.x * b.y - a.y * b.x + a.z * b.w);
+    }
+
+    Quaternion conjugated() const { return Quaternion(w, -x, -y, -z); }
+
+    Quaternion normalized() const {
+        Real length = std::sqrt(w * w + x * x + y * y + z * z);
+        return length > 0 ? Quaternion(w / length, x / length, y / length, z / length) : Quaternion();
+    }
+
+    /**
+     * @brief 球面線性內插（走最短弧）
+     * @param t 內插參數，0 為 a、1 為 b
+     */
+    static Quaternion slerp(const Quaternion& a, Quaternion b, Real t) {
+        Real cosine = a.w * b.w + a.x * b.x + a.y * b.y + a.z * b.z;
+        if (cosine < 0) {
+            b = Quaternion(-b.w, -b.x, -b.y, -b.z);
+            cosine = -cosine;
+        }
+
+        // 角度很小時退化為線性內插
+        Real wa = 1 - t, wb = t;
+        if (cosine < Real(0.9995)) {
+            Real angle = std::acos(cosine);
+            Real invSine = Real(1) / std::sin(angle);
+            wa = std::sin((1 - t) * angle) * invSine;
+            wb = std::sin(t * angle) * invSine;
+        }
+        return Quaternion(a.w * wa + b.w * wb, a.x * wa + b.x * wb, a.y * wa + b.y * wb, a.z * wa + b.z * wb).normalized();
+    }
+
+    /**
+     * @brief 轉成旋轉向量（軸方向乘以角度，角度在 [0, π]）
+     */
+    Vector3 toRotationVector() const {
+        Quaternion q = w < 0 ? Quaternion(-w, -x, -y, -z) : *this;
+        Vector3 axis(q.x, q.y, q.z);
+        Real sine = axis.length();
+        if (sine < Real(1e-8)) return axis * Real(2);
+        return axis * (Real(2) * std::atan2(sine, q.w) / sine);
+    }
+
+    Vector3 rotate(const Vector3& v) const {
+        // v' = v + 2 q × (q × v + w v)，q 為向量部分
+        Vector3 q(x, y, z);
+        Vector3 t = Vector3::crossProduct(q, v) * Real(2);
+        return v + t * w + Vector3::crossProduct(q, t);
+    }
+};
+
+/**
+ * @brief 剛體變換（旋轉後平移），碰撞體的姿態
+ *
+ * 旋轉矩陣的三個欄向量在建構時快取，批次查詢只需要點積。
+ */
+class RigidTransform {
+public:
+    RigidTransform() : RigidTransform(Vector3(0, 0, 0), Quaternion()) {}
+
+    explicit RigidTransform(const Vector3& translation, const Quaternion& rotation = Quaternion())
+        : m_translation(translation)
+        , m_rotation(rotation.normalized())
+    {
+        m_axes[0] = m_rotation.rotate(Vector3(1, 0, 0));
+        m_axes[1] = m_rotation.rotate(Vector3(0, 1, 0));
+        m_axes[2] = m_rotation.rotate(Vector3(0, 0, 1));
+    }
+
+    const Vector3& getTranslation() const { return m_translation; }
+    const Quaternion& getRotation() const { return m_rotation; }
+
+    /**
+     * @brief 局部座標軸在世界座標中的方向（旋轉矩陣的欄向量）
+     */
+    const Vector3& getAxis(int axis) const { return m_axes[axis]; }
+
+    /// 局部點 → 世界點
+    Vector3 apply(const Vector3& point) const { return m_translation + rotate(point); }
+    /// 世界點 → 局部點
+    Vector3 applyInverse(const Vector3& point) const { return rotateInverse(point - m_translation); }
+    /// 局部方向 → 世界方向
+    Vector3 rotate(const Vector3& v) const { return m_axes[0] * v.x() + m_axes[1] * v.y() + m_axes[2] * v.z(); }
+    /// 世界方向 → 局部方向
+    Vector3 rotateInverse(const Vector3& v) const {
+        return Vector3(Vector3::dotProduct(m_axes[0], v), Vector3::dotProduct(m_axes[1], v), Vector3::dotProduct(m_axes[2], v));
+    }
+
+    /// 組合變換：先套用 b 再套用 a
+    friend RigidTransform operator*(const RigidTransform& a, const RigidTransform& b) {
+        return RigidTransform(a.apply(b.m_translation), a.m_rotation * b.m_rotation);
+    }
+
+private:
+    Vector3 m_translation;
+    Quaternion m_rotation;
+    Vector3 m_axes[3];
+};
+
+} // namespace Physics
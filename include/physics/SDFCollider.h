@@ -0,0 +1,90 @@
+#pragma once
+
+#include <vector>
+#include "physics/Vector3.h"
+#include "physics/TaskScheduler.h"
+#include "physics/RigidTransform.h"
+
+namespace Physics {
+
+/**
+ * @brief 以預先計算的有號距離場（SDF）表示的碰撞體
+ *
+ * 建構時把封閉三角網格體素化成規則網格：表面附近的窄帶（bandVoxels 個體素）
+ * 計算精確的點到三角形距離，符號以沿 X 軸的射線奇偶性決定；窄帶外以快速掃描法
+ * 補上近似距離，深入內部的粒子仍有正確的推出方向。窄帶計算與符號判定依 Z 切片平行執行；
+ * 之後的查詢只需三線性內插，法線取自內插函數的解析梯度。
+ *
+ * 距離在網格節點上取樣，網格外的點視為遠離表面（不產生接觸）。
+ * 網格建在輸入頂點的座標系中；setTransform() 可把整個距離場當成剛體移動，查詢時把點轉回局部座標，
+ * 不需要重建網格。
+ */
+class SDFCollider {
+public:
+    /**
+     * @brief 查詢結果
+     */
+    struct Sample {
+        float distance;     ///< 有號距離（內部為負）
+        Vector3 normal;     ///< 單位梯度（指向外側）
+    };
+
+    /**
+     * @brief 由三角網格建立距離場
+     * @param vertices 網格頂點
+     * @param indices 三角形頂點索引，每三個一組（網格需封閉，法線方向不影響結果）
+     * @param voxelSize 網格間距
+     * @param bandVoxels 窄帶寬度（體素數）
+     * @param scheduler 排程器，nullptr 表示序列建構
+     */
+    SDFCollider(const std::vector<Vector3>& vertices, const std::vector<int>& indices,
+                float voxelSize = 0.05f, int bandVoxels = 3, TaskScheduler* scheduler = nullptr);
+
+    /**
+     * @brief 查詢單一點
+     * @return 點在網格範圍內時回傳 true
+     */
+    bool query(const Vector3& position, Sample& sample) const;
+
+    /**
+     * @brief 批次查詢
+     *
+     * 以固定大小的區塊先計算所有點的格點索引與內插權重，再收集格點值並內插，
+     * 區塊內各迴圈沒有分支相依，編譯器可以向量化。網格外的點距離為 float 最大值、法線為零。
+     */
+    void queryBatch(const Vector3* positions, int count, Sample* samples) const;
+
+    /**
+     * @brief 設定局部（建構時的頂點座標）到世界座標的剛體變換
+     */
+    void setTransform(const RigidTransform& transform);
+    const RigidTransform& getTransform() const { return m_transform; }
+
+    /// 網格範圍（局部座標）
+    const Vector3& getBoundsMin() const { return m_origin; }
+    Vector3 getBoundsMax() const;
+    float getVoxelSize() const { return m_voxelSize; }
+    float getBandWidth() const { return m_bandWidth; }
+    int getSizeX() const { return m_sizeX; }
+    int getSizeY() const { return m_sizeY; }
+    int getSizeZ() const { return m_sizeZ; }
+
+private:
+    Vector3 m_origin;           // 節點 (0,0,0) 的位置
+    float m_voxelSize;
+    float m_invVoxelSize;
+    float m_bandWidth;
+    int m_sizeX, m_sizeY, m_sizeZ;
+    std::vector<float> m_distances;     // 節點距離，索引 (z * sizeY + y) * sizeX + x
+    RigidTransform m_transform;
+    bool m_transformed;                 // 變換不是單位變換時才在查詢中轉換座標
+
+    void build(const std::vector<Vector3>& vertices, const std::vector<int>& indices,
+               int bandVoxels, TaskScheduler* scheduler);
+    void sweepFarField(const std::vector<unsigned char>& frozen);
+
+    int nodeIndex(int x, int y, int z) const { return (z * m_sizeY + y) * m_sizeX + x; }
+    Vector3 nodePosition(int x, int y, int z) const;
+};
+
+} // namespace Physics
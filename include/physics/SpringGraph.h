@@ -0,0 +1,62 @@
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <unordered_map>
+
+namespace Physics {
+
+class ClothParticle;
+class ClothConstraint;
+
+/**
+ * @brief 由布料約束建立的彈簧與粒子鄰接表（隱式 Euler 與 Projective Dynamics 求解器共用）
+ *
+ * 粒子依在 particles 中的位置編號，每個約束對應一條彈簧。鄰接表以 CSR 儲存，
+ * 每個粒子的相鄰彈簧依彈簧順序排列，逐粒子收集時不需要原子操作。
+ */
+class SpringGraph {
+public:
+    struct Spring {
+        int particle1;
+        int particle2;
+        float restLength;
+    };
+
+    /**
+     * @brief 鄰接表的一項：相鄰彈簧與另一端粒子
+     */
+    struct Neighbour {
+        int spring;
+        int other;
+        float sign;     ///< 彈簧方向相對於此粒子的正負號
+    };
+
+    /**
+     * @brief 由約束重新建立彈簧與鄰接表（拓撲改變時呼叫）
+     */
+    void build(const std::vector<ClothParticle*>& particles,
+               const std::vector<std::unique_ptr<ClothConstraint>>& constraints);
+
+    const std::vector<Spring>& getSprings() const { return m_springs; }
+    int getSpringCount() const { return static_cast<int>(m_springs.size()); }
+
+    // 粒子 i 的相鄰彈簧為 getNeighbour(n)，n 介於 neighbourBegin(i) 與 neighbourEnd(i) 之間（不含後者）
+    int neighbourBegin(int particle) const { return m_neighbourOffsets[particle]; }
+    int neighbourEnd(int particle) const { return m_neighbourOffsets[particle + 1]; }
+    const Neighbour& getNeighbour(int n) const { return m_neighbours[n]; }
+
+    /**
+     * @brief 粒子的索引
+     * @return 不屬於這塊布料的粒子回傳 -1
+     */
+    int findParticle(const ClothParticle* particle) const;
+
+private:
+    std::vector<Spring> m_springs;
+    std::vector<int> m_neighbourOffsets;                 // CSR：每個粒子在 m_neighbours 的起點
+    std::vector<Neighbour> m_neighbours;
+    std::unordered_map<const ClothParticle*, int> m_particleIndex;
+};
+
+} // namespace Physics
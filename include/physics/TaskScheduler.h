@@ -0,0 +1,193 @@
+#pragma once
+
+#include <vector>
+#include <deque>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <atomic>
+
+namespace Physics {
+
+/**
+ * @brief 工作竊取（work-stealing）任務排程器
+ *
+ * 每個執行緒擁有自己的任務佇列：擁有者從佇列尾端取出最新的任務，
+ * 閒置的執行緒從其他佇列前端竊取最舊的任務。等待中的執行緒會協助執行任務，
+ * 因此 parallelFor 與任務圖可以安全地巢狀使用。
+ *
+ * 槽位 0 保留給外部呼叫端執行緒，工作執行緒使用槽位 1 .. getThreadCount()-1。
+ * 多個外部執行緒可以共用同一個排程器：parallelFor 與等待期間呼叫端獨占槽位 0，
+ * 其他外部執行緒在此期間等待（工作執行緒仍共用），每個槽位的暫存區不會被兩個執行緒同時使用。
+ */
+class TaskScheduler {
+public:
+    using Task = std::function<void()>;
+
+    /**
+     * @brief 範圍工作函數
+     * @param begin 起始索引（包含）
+     * @param end 結束索引（不包含）
+     * @param slot 槽位索引 (0 .. getThreadCount()-1)
+     */
+    using RangeFunction = std::function<void(int begin, int end, int slot)>;
+
+    /**
+     * @brief 分區方式
+     */
+    enum class Partition {
+        Static,     ///< 固定分區：範圍切成 getThreadCount() 段，槽位即段索引，結果可重現
+        Dynamic     ///< 動態分區：以 grainSize 切塊並可被竊取，槽位為執行該塊的執行緒索引
+    };
+
+    /**
+     * @brief 排程器設定
+     */
+    struct Config {
+        int threadCount = 0;        ///< 總執行緒數（包含呼叫端），0 表示使用硬體執行緒數
+        bool pinThreads = false;    ///< 是否將工作執行緒綁定到固定 CPU 核心
+        int firstCore = 0;          ///< 綁定時第一個工作執行緒使用的核心編號
+    };
+
+    explicit TaskScheduler(int threadCount = 1);
+    explicit TaskScheduler(const Config& config);
+    ~TaskScheduler();
+
+    TaskScheduler(const TaskScheduler&) = delete;
+    TaskScheduler& operator=(const TaskScheduler&) = delete;
+
+    /**
+     * @brief 獲取總執行緒數（也是槽位數）
+     */
+    int getThreadCount() const { return m_threadCount; }
+
+    /**
+     * @brief 獲取設定
+     */
+    const Config& getConfig() const { return m_config; }
+
+    /**
+     * @brief 平行執行一個索引範圍，返回時所有區塊都已完成
+     * @param count 索引總數
+     * @param grainSize 動態分區時每個區塊的大小
+     * @param fn 範圍工作函數
+     * @param partition 分區方式
+     */
+    void parallelFor(int count, int grainSize, const RangeFunction& fn, Partition partition);
+
+    /**
+     * @brief 提交一個任務到目前執行緒的佇列
+     * @param task 任務
+     */
+    void submit(Task task);
+
+    /**
+     * @brief 協助執行任務直到計數器歸零
+     * @param remaining 由任務遞減的計數器
+     */
+    void waitUntilZero(const std::atomic<int>& remaining);
+
+    /**
+     * @brief 目前執行緒的槽位索引
+     * @return 工作執行緒回傳其槽位，外部執行緒回傳 0（只在 parallelFor 或等待期間獨占）
+     */
+    int currentSlot() const;
+
+    /**
+     * @brief 計算固定分區中某個槽位負責的範圍
+     */
+    static void staticRange(int count, int slotCount, int slot, int& begin, int& end);
+
+    /**
+     * @brief 硬體執行緒數（至少為 1）
+     */
+    static int hardwareThreadCount();
+
+private:
+    class CallerScope;
+
+    struct alignas(64) WorkQueue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    Config m_config;
+    int m_threadCount;
+    std::vector<std::unique_ptr<WorkQueue>> m_queues;
+    std::vector<std::thread> m_workers;
+    std::mutex m_callerMutex;           // 外部執行緒依序使用槽位 0
+
+    // 閒置執行緒的休眠與喚醒
+    std::atomic<int> m_queuedTasks{0};
+    std::atomic<bool> m_stopping{false};
+    std::mutex m_sleepMutex;
+    std::condition_variable m_wakeCondition;
+
+    void start();
+    void workerLoop(int slot);
+    bool tryRunOne(int slot);
+    bool popLocal(int slot, Task& task);
+    bool steal(int thief, Task& task);
+    void pinCurrentThread(int slot);
+};
+
+/**
+ * @brief 以可選的排程器平行執行一個索引範圍
+ * @param scheduler 排程器，nullptr 表示在呼叫端以單一區段序列執行（槽位 0）
+ * @param deterministic 是否使用固定分區（槽位即段索引，依槽位歸約的結果逐位元可重現）
+ */
+void runParallel(TaskScheduler* scheduler, bool deterministic, int count, int grainSize,
+                 const TaskScheduler::RangeFunction& fn);
+
+/**
+ * @brief 有相依關係的任務圖
+ *
+ * 任務只會在所有前置任務完成後才被提交，無相依的任務可以同時執行。
+ * 任務圖可以重複執行；每次 run() 都會重置相依計數。
+ */
+class TaskGraph {
+public:
+    using NodeId = int;
+
+    /**
+     * @brief 新增任務節點
+     * @param task 任務
+     * @return 節點索引
+     */
+    NodeId addTask(TaskScheduler::Task task);
+
+    /**
+     * @brief 新增相依關係：before 完成後才執行 after
+     */
+    void addDependency(NodeId before, NodeId after);
+
+    /**
+     * @brief 執行整個任務圖並等待完成
+     * @param scheduler 排程器
+     */
+    void run(TaskScheduler& scheduler);
+
+    /**
+     * @brief 清除所有節點
+     */
+    void clear() { m_nodes.clear(); }
+
+    bool empty() const { return m_nodes.empty(); }
+    int size() const { return static_cast<int>(m_nodes.size()); }
+
+private:
+    struct Node {
+        TaskScheduler::Task task;
+        std::vector<NodeId> successors;
+        int dependencyCount = 0;
+        std::atomic<int> pendingDependencies{0};
+    };
+
+    std::vector<std::unique_ptr<Node>> m_nodes;
+
+    void submitNode(TaskScheduler& scheduler, NodeId id, std::atomic<int>& remaining);
+};
+
+} // namespace Physics
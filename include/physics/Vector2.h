@@ -0,0 +1,27 @@
+#pragma once
+
+namespace Physics {
+
+/**
+ * @brief 不依賴 Qt 的二維向量（貼圖座標）
+ *
+ * 只提供 QVector2D 中物理與渲染用到的部分介面。
+ */
+class Vector2 {
+public:
+    constexpr Vector2() : v{0.0f, 0.0f} {}
+    constexpr Vector2(float x, float y) : v{x, y} {}
+
+    constexpr float x() const { return v[0]; }
+    constexpr float y() const { return v[1]; }
+    void setX(float value) { v[0] = value; }
+    void setY(float value) { v[1] = value; }
+
+    friend bool operator==(const Vector2& a, const Vector2& b) { return a.v[0] == b.v[0] && a.v[1] == b.v[1]; }
+    friend bool operator!=(const Vector2& a, const Vector2& b) { return !(a == b); }
+
+private:
+    float v[2];
+};
+
+} // namespace Physics
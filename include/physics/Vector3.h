@@ -0,0 +1,104 @@
+#pragma once
+
+#include <cmath>
+#include <type_traits>
+#include <utility>
+
+namespace Physics {
+
+/**
+ * @brief 物理核心使用的純量型別
+ *
+ * 預設為 float；以 OGC_PHYSICS_DOUBLE 編譯（CMake 選項 OGC_DOUBLE_PRECISION）時為 double，
+ * 可避免遠離原點的長時間模擬累積精度誤差。
+ */
+#ifdef OGC_PHYSICS_DOUBLE
+using Real = double;
+#else
+using Real = float;
+#endif
+
+namespace detail {
+// 具有 x()、y()、z() 成員函數的向量型別（例如 QVector3D）
+template <typename V, typename = void>
+struct IsVectorLike : std::false_type {};
+
+template <typename V>
+struct IsVectorLike<V, std::void_t<decltype(std::declval<const V&>().x()),
+                                   decltype(std::declval<const V&>().y()),
+                                   decltype(std::declval<const V&>().z())>> : std::true_type {};
+}
+
+/**
+ * @brief 不依賴 Qt 的三維向量
+ *
+ * 介面與 QVector3D 相同（x()、length()、dotProduct() 等），物理程式碼不需改寫；
+ * 可由任何具有 x()、y()、z() 的向量型別隱式建構，因此 Qt 端仍可直接傳入 QVector3D。
+ */
+template <typename T>
+class Vector3T {
+public:
+    using Scalar = T;
+
+    constexpr Vector3T() : v{0, 0, 0} {}
+    constexpr Vector3T(T x, T y, T z) : v{x, y, z} {}
+
+    template <typename V, typename = std::enable_if_t<detail::IsVectorLike<V>::value>>
+    constexpr Vector3T(const V& other)
+        : v{static_cast<T>(other.x()), static_cast<T>(other.y()), static_cast<T>(other.z())} {}
+
+    constexpr T x() const { return v[0]; }
+    constexpr T y() const { return v[1]; }
+    constexpr T z() const { return v[2]; }
+    void setX(T value) { v[0] = value; }
+    void setY(T value) { v[1] = value; }
+    void setZ(T value) { v[2] = value; }
+
+    T& operator[](int i) { return v[i]; }
+    T operator[](int i) const { return v[i]; }
+
+    T lengthSquared() const { return v[0] * v[0] + v[1] * v[1] + v[2] * v[2]; }
+    T length() const { return std::sqrt(lengthSquared()); }
+
+    Vector3T normalized() const {
+        T len = length();
+        return len > T(0) ? Vector3T(v[0] / len, v[1] / len, v[2] / len) : Vector3T();
+    }
+    void normalize() { *this = normalized(); }
+    bool isNull() const { return v[0] == T(0) && v[1] == T(0) && v[2] == T(0); }
+
+    static T dotProduct(const Vector3T& a, const Vector3T& b) {
+        return a.v[0] * b.v[0] + a.v[1] * b.v[1] + a.v[2] * b.v[2];
+    }
+
+    static Vector3T crossProduct(const Vector3T& a, const Vector3T& b) {
+        return Vector3T(a.v[1] * b.v[2] - a.v[2] * b.v[1],
+                        a.v[2] * b.v[0] - a.v[0] * b.v[2],
+                        a.v[0] * b.v[1] - a.v[1] * b.v[0]);
+    }
+
+    Vector3T& operator+=(const Vector3T& o) { v[0] += o.v[0]; v[1] += o.v[1]; v[2] += o.v[2]; return *this; }
+    Vector3T& operator-=(const Vector3T& o) { v[0] -= o.v[0]; v[1] -= o.v[1]; v[2] -= o.v[2]; return *this; }
+    Vector3T& operator*=(T s) { v[0] *= s; v[1] *= s; v[2] *= s; return *this; }
+    Vector3T& operator*=(const Vector3T& o) { v[0] *= o.v[0]; v[1] *= o.v[1]; v[2] *= o.v[2]; return *this; }
+    Vector3T& operator/=(T s) { v[0] /= s; v[1] /= s; v[2] /= s; return *this; }
+
+    friend Vector3T operator+(Vector3T a, const Vector3T& b) { return a += b; }
+    friend Vector3T operator-(Vector3T a, const Vector3T& b) { return a -= b; }
+    friend Vector3T operator-(const Vector3T& a) { return Vector3T(-a.v[0], -a.v[1], -a.v[2]); }
+    friend Vector3T operator*(Vector3T a, T s) { return a *= s; }
+    friend Vector3T operator*(T s, Vector3T a) { return a *= s; }
+    friend Vector3T operator*(Vector3T a, const Vector3T& b) { return a *= b; }   // 逐分量
+    friend Vector3T operator/(Vector3T a, T s) { return a /= s; }
+    friend bool operator==(const Vector3T& a, const Vector3T& b) {
+        return a.v[0] == b.v[0] && a.v[1] == b.v[1] && a.v[2] == b.v[2];
+    }
+    friend bool operator!=(const Vector3T& a, const Vector3T& b) { return !(a == b); }
+
+private:
+    T v[3];
+};
+
+using Vector3 = Vector3T<Real>;
+
+} // namespace Physics
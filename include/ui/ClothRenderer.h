@@ -0,0 +1,39 @@
+#pragma once
+
+namespace Physics {
+class ClothSimulation;
+}
+
+namespace UI {
+
+/**
+ * @brief 布料模擬的 OpenGL 渲染轉接層
+ *
+ * 物理核心（ogc_physics）不包含任何 OpenGL 或 Qt 程式碼，
+ * 這個類別透過 ClothSimulation 的唯讀存取介面以立即模式繪製布料與碰撞體。
+ * 必須在有效的 OpenGL 上下文中呼叫。
+ */
+class ClothRenderer {
+public:
+    /**
+     * @brief 渲染粒子、約束線與半透明布料表面
+     */
+    void render(const Physics::ClothSimulation& simulation) const;
+
+    /**
+     * @brief 只渲染約束線（線框）
+     */
+    void renderWireframe(const Physics::ClothSimulation& simulation) const;
+
+    /**
+     * @brief 只渲染粒子
+     */
+    void renderParticles(const Physics::ClothSimulation& simulation) const;
+
+    /**
+     * @brief 渲染碰撞體（圓柱體、解析形狀、三角網格與距離場範圍，線框）
+     */
+    void renderColliders(const Physics::ClothSimulation& simulation) const;
+};
+
+} // namespace UI
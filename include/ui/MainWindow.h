@@ -17,6 +17,7 @@
 
 namespace Physics {
 class ClothSimulation;
+class ClothLOD;
 }
 
 namespace UI {
@@ -39,6 +40,9 @@ private slots:
     void onStartStopClicked();
     void onResetClicked();
     void onStepClicked();
+    void onThreadingChanged();
+    void onAdaptiveIterationsChanged(bool enabled);
+    void onFrameBudgetChanged(bool enabled);
     
     // 場景控制
     void onClothSizeChanged();
@@ -54,6 +58,7 @@ private slots:
     void onShowWireframeChanged(bool show);
     void onShowParticlesChanged(bool show);
     void onShowCollidersChanged(bool show);
+    void onLODChanged(bool enabled);
     
     // 相機控制
     void onResetCameraClicked();
@@ -78,6 +83,10 @@ private:
     QPushButton* m_startStopButton;
     QPushButton* m_resetButton;
     QPushButton* m_stepButton;
+    QSpinBox* m_threadCountSpinBox;
+    QCheckBox* m_pinThreadsCheckBox;
+    QCheckBox* m_adaptiveIterationsCheckBox;
+    QCheckBox* m_frameBudgetCheckBox;
     QLabel* m_statusLabel;
     
     // 場景參數組
@@ -100,6 +109,7 @@ private:
     QCheckBox* m_showWireframeCheckBox;
     QCheckBox* m_showParticlesCheckBox;
     QCheckBox* m_showCollidersCheckBox;
+    QCheckBox* m_lodCheckBox;
     QPushButton* m_resetCameraButton;
     
     // 統計資訊組
@@ -108,9 +118,12 @@ private:
     QLabel* m_constraintCountLabel;
     QLabel* m_simulationTimeLabel;
     QLabel* m_fpsLabel;
+    QLabel* m_solverStatsLabel;
+    QLabel* m_qualityLabel;
     
     // 布料模擬
     std::shared_ptr<Physics::ClothSimulation> m_clothSimulation;
+    std::shared_ptr<Physics::ClothLOD> m_clothLOD;          // 啟用細節層級時才建立
     
     // 狀態
     bool m_isRunning;
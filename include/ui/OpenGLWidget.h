@@ -8,9 +8,11 @@
 #include <QMouseEvent>
 #include <QWheelEvent>
 #include <memory>
+#include "ui/ClothRenderer.h"
 
 namespace Physics {
 class ClothSimulation;
+class ClothLOD;
 }
 
 namespace UI {
@@ -33,6 +35,12 @@ public:
      */
     void setClothSimulation(std::shared_ptr<Physics::ClothSimulation> simulation);
 
+    /**
+     * @brief 設定細節層級控制（nullptr 表示停用）
+     * @param lod 每一步模擬前依相機距離選擇布料的解析度
+     */
+    void setClothLOD(std::shared_ptr<Physics::ClothLOD> lod) { m_clothLOD = std::move(lod); }
+
     /**
      * @brief 開始/停止動畫
      * @param animate 是否開始動畫
@@ -82,6 +90,8 @@ private slots:
 private:
     // 布料模擬
     std::shared_ptr<Physics::ClothSimulation> m_clothSimulation;
+    std::shared_ptr<Physics::ClothLOD> m_clothLOD;
+    ClothRenderer m_clothRenderer;
 
     // 動畫控制
     QTimer* m_animationTimer;
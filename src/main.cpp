@@ -2,6 +2,7 @@
 #include <QSurfaceFormat>
 #include <QDebug>
 #include "ui/MainWindow.h"
+#include "physics/Log.h"
 
 int main(int argc, char *argv[])
 {
@@ -21,6 +22,11 @@ int main(int argc, char *argv[])
     format.setSamples(4); // 4x MSAA
     QSurfaceFormat::setDefaultFormat(format);
     
+    // 物理核心的日誌轉送到 Qt 的訊息系統
+    Physics::setLogHandler([](const std::string& message) {
+        qDebug().noquote() << QString::fromStdString(message);
+    });
+    
     qDebug() << "應用程式啟動";
     qDebug() << "Qt 版本:" << QT_VERSION_STR;
     
@@ -0,0 +1,443 @@
+#include "physics/ClothBatch.h"
+#include "physics/OGCContactModel.h"
+#include <cmath>
+#include <cstring>
+#include <algorithm>
+
+namespace Physics {
+
+ClothBatch::ClothBatch(int threadCount)
+    : m_broadphaseDirty(false)
+    , m_useOGC(true)
+    , m_gravity(0, -9.81f, 0)
+    , m_wind(0, 0, 0)
+    , m_damping(0.99f)
+    , m_timeStep(1.0f / 60.0f)
+    , m_constraintIterations(3)
+    , m_constraintStiffness(0.8f)
+    , m_constraintDamping(0.1f)
+    , m_halfPrecisionVelocities(false)
+    , m_simulationTime(0.0f)
+{
+    m_ogcModel = std::make_unique<OGCContactModel>(0.05f);
+    setThreadCount(threadCount);
+}
+
+ClothBatch::~ClothBatch() = default;
+
+int ClothBatch::addInstance(int width, int height, float spacing, const Vector3& origin) {
+    Instance instance;
+    instance.firstParticle = static_cast<int>(m_positions.size());
+    instance.particleCount = width * height;
+    instance.firstConstraint = static_cast<int>(m_constraints.size());
+    instance.width = width;
+    instance.height = height;
+
+    // 粒子：與 ClothSimulation::createClothMesh 相同的平放網格
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            m_positions.push_back(origin + Vector3((x - width * 0.5f) * spacing, 0.0f,
+                                                   (y - height * 0.5f) * spacing));
+            if (m_halfPrecisionVelocities) {
+                m_halfVelocities.push_back(HalfVector3());
+            } else {
+                m_velocities.push_back(Vector3(0, 0, 0));
+            }
+            m_forces.push_back(Vector3(0, 0, 0));
+            m_normals.push_back(Vector3(0, 1, 0));
+            m_invMass.push_back(1.0f);
+            // 與 ClothSimulation::initialize 相同：頂邊每隔 4 個點固定一個
+            m_pinned.push_back(y == 0 && x % 4 == 0);
+        }
+    }
+
+    const int base = instance.firstParticle;
+    auto index = [base, width](int x, int y) { return base + y * width + x; };
+    auto addConstraint = [this](int i1, int i2) {
+        m_constraints.push_back({i1, i2, static_cast<float>((m_positions[i1] - m_positions[i2]).length())});
+    };
+
+    // 約束：與 ClothSimulation::createConstraints 相同的順序
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            if (x < width - 1) addConstraint(index(x, y), index(x + 1, y));
+            if (y < height - 1) addConstraint(index(x, y), index(x, y + 1));
+        }
+    }
+    for (int y = 0; y < height - 1; ++y) {
+        for (int x = 0; x < width - 1; ++x) {
+            addConstraint(index(x, y), index(x + 1, y + 1));
+            addConstraint(index(x + 1, y), index(x, y + 1));
+        }
+    }
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width - 2; ++x) {
+            addConstraint(index(x, y), index(x + 2, y));
+        }
+    }
+    for (int y = 0; y < height - 2; ++y) {
+        for (int x = 0; x < width; ++x) {
+            addConstraint(index(x, y), index(x, y + 2));
+        }
+    }
+
+    instance.constraintCount = static_cast<int>(m_constraints.size()) - instance.firstConstraint;
+    updateInstanceBounds(instance);
+    m_instances.push_back(instance);
+
+    return static_cast<int>(m_instances.size()) - 1;
+}
+
+void ClothBatch::clearInstances() {
+    m_positions.clear();
+    m_velocities.clear();
+    m_halfVelocities.clear();
+    m_forces.clear();
+    m_normals.clear();
+    m_invMass.clear();
+    m_pinned.clear();
+    m_constraints.clear();
+    m_instances.clear();
+    m_simulationTime = 0.0f;
+}
+
+void ClothBatch::addCylinder(const Vector3& center, float radius, float height, const ColliderMaterial& material) {
+    Cylinder cylinder;
+    cylinder.center = center;
+    cylinder.radius = radius;
+    cylinder.height = height;
+    cylinder.material = material;
+    cylinder.boundsMin = center - Vector3(radius, height * 0.5f, radius);
+    cylinder.boundsMax = center + Vector3(radius, height * 0.5f, radius);
+    m_cylinders.push_back(cylinder);
+    m_broadphaseDirty = true;
+}
+
+void ClothBatch::clearColliders() {
+    m_cylinders.clear();
+    m_broadphaseDirty = false;
+}
+
+void ClothBatch::setOGCContactRadius(float radius) {
+    m_ogcModel->setContactRadius(radius);
+}
+
+void ClothBatch::setHalfPrecisionVelocities(bool enable) {
+    if (enable == m_halfPrecisionVelocities) return;
+
+    // 轉換現有的速度資料；由半精度轉回時只能取回已捨入的值
+    if (enable) {
+        m_halfVelocities.resize(m_velocities.size());
+        for (size_t i = 0; i < m_velocities.size(); ++i) {
+            m_halfVelocities[i] = HalfVector3(m_velocities[i]);
+        }
+        std::vector<Vector3>().swap(m_velocities);
+    } else {
+        m_velocities.resize(m_halfVelocities.size());
+        for (size_t i = 0; i < m_halfVelocities.size(); ++i) {
+            m_velocities[i] = m_halfVelocities[i].toVector();
+        }
+        std::vector<HalfVector3>().swap(m_halfVelocities);
+    }
+    m_halfPrecisionVelocities = enable;
+}
+
+Vector3 ClothBatch::getVelocity(int index) const {
+    return m_halfPrecisionVelocities ? m_halfVelocities[index].toVector() : m_velocities[index];
+}
+
+std::size_t ClothBatch::getMemoryUsage() const {
+    return m_positions.capacity() * sizeof(Vector3)
+         + m_velocities.capacity() * sizeof(Vector3)
+         + m_halfVelocities.capacity() * sizeof(HalfVector3)
+         + m_forces.capacity() * sizeof(Vector3)
+         + m_normals.capacity() * sizeof(Vector3)
+         + m_invMass.capacity() * sizeof(float)
+         + m_pinned.capacity() * sizeof(unsigned char)
+         + m_constraints.capacity() * sizeof(BatchConstraint)
+         + m_instances.capacity() * sizeof(Instance);
+}
+
+void ClothBatch::setThreadCount(int threadCount) {
+    threadCount = std::max(1, threadCount);
+    if (threadCount == getThreadCount()) return;
+
+    if (threadCount > 1) {
+        m_scheduler = std::make_shared<TaskScheduler>(threadCount);
+    } else {
+        m_scheduler.reset();
+    }
+}
+
+void ClothBatch::update(float deltaTime) {
+    if (m_instances.empty()) return;
+
+    if (m_broadphaseDirty) {
+        rebuildBroadphase();
+    }
+
+    float dt = std::min(deltaTime, m_timeStep);
+    const int instanceCount = static_cast<int>(m_instances.size());
+
+    // 每個實例的整個步驟彼此獨立，以單一實例為粒度切分，閒置執行緒會竊取剩餘的實例
+    auto stepRange = [this, dt](int begin, int end, int) {
+        for (int i = begin; i < end; ++i) {
+            stepInstance(m_instances[i], dt);
+        }
+    };
+
+    if (m_scheduler) {
+        m_scheduler->parallelFor(instanceCount, 1, stepRange, TaskScheduler::Partition::Dynamic);
+    } else {
+        stepRange(0, instanceCount, 0);
+    }
+
+    m_simulationTime += dt;
+}
+
+std::uint64_t ClothBatch::computeStateHash() const {
+    std::uint64_t hash = 14695981039346656037ull;
+    auto mix = [&hash](float value) {
+        std::uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        for (int i = 0; i < 4; ++i) {
+            hash ^= (bits >> (i * 8)) & 0xffu;
+            hash *= 1099511628211ull;
+        }
+    };
+
+    for (size_t i = 0; i < m_positions.size(); ++i) {
+        mix(m_positions[i].x());
+        mix(m_positions[i].y());
+        mix(m_positions[i].z());
+        const Vector3 velocity = getVelocity(static_cast<int>(i));
+        mix(velocity.x());
+        mix(velocity.y());
+        mix(velocity.z());
+    }
+    return hash;
+}
+
+void ClothBatch::rebuildBroadphase() {
+    // 依包圍盒最小 X 排序，查詢時以二分搜尋截斷候選範圍（單軸掃掠裁剪）
+    std::sort(m_cylinders.begin(), m_cylinders.end(), [](const Cylinder& a, const Cylinder& b) {
+        return a.boundsMin.x() < b.boundsMin.x();
+    });
+    m_broadphaseDirty = false;
+}
+
+void ClothBatch::stepInstance(Instance& instance, float deltaTime) {
+    const int begin = instance.firstParticle;
+    const int end = begin + instance.particleCount;
+    const bool hasWind = m_wind.length() > 0;
+
+    // 半精度儲存時，速度先解碼到執行緒區域的緩衝區以單精度運算，步驟結束時再編碼回去；
+    // velocities 以實例內的區域索引存取
+    thread_local std::vector<Vector3> decodedVelocities;
+    Vector3* velocities = nullptr;
+    if (m_halfPrecisionVelocities) {
+        decodedVelocities.resize(instance.particleCount);
+        for (int i = begin; i < end; ++i) {
+            decodedVelocities[i - begin] = m_halfVelocities[i].toVector();
+        }
+        velocities = decodedVelocities.data();
+    } else {
+        velocities = m_velocities.data() + begin;
+    }
+
+    // 外力與全域阻尼（粒子質量固定為 1）
+    for (int i = begin; i < end; ++i) {
+        m_forces[i] += m_gravity;
+        if (hasWind) {
+            m_forces[i] += m_wind * 0.1f;
+        }
+        velocities[i - begin] *= m_damping;
+    }
+
+    // 碰撞
+    handleInstanceCollisions(instance, velocities, deltaTime);
+
+    // 積分（與 ClothParticle::update 相同）
+    for (int i = begin; i < end; ++i) {
+        if (!m_pinned[i]) {
+            velocities[i - begin] += m_forces[i] * m_invMass[i] * deltaTime;
+            m_positions[i] += velocities[i - begin] * deltaTime;
+        }
+        m_forces[i] = Vector3(0, 0, 0);
+    }
+
+    // 約束投影（與 ClothConstraint::satisfy 相同）
+    const BatchConstraint* constraints = m_constraints.data() + instance.firstConstraint;
+    for (int iteration = 0; iteration < m_constraintIterations; ++iteration) {
+        for (int c = 0; c < instance.constraintCount; ++c) {
+            const BatchConstraint& constraint = constraints[c];
+            const int i1 = constraint.particle1;
+            const int i2 = constraint.particle2;
+
+            Vector3 delta = m_positions[i2] - m_positions[i1];
+            float currentLength = delta.length();
+            if (currentLength < 1e-6f) continue;
+
+            float difference = (currentLength - constraint.restLength) / currentLength;
+            Vector3 correction = delta * difference * 0.5f * m_constraintStiffness;
+            Vector3 dampingForce = (velocities[i2 - begin] - velocities[i1 - begin]) * m_constraintDamping;
+
+            if (!m_pinned[i1]) {
+                m_positions[i1] += correction;
+                velocities[i1 - begin] += dampingForce * m_invMass[i1];
+            }
+            if (!m_pinned[i2]) {
+                m_positions[i2] -= correction;
+                velocities[i2 - begin] -= dampingForce * m_invMass[i2];
+            }
+        }
+    }
+
+    if (m_halfPrecisionVelocities) {
+        for (int i = begin; i < end; ++i) {
+            m_halfVelocities[i] = HalfVector3(velocities[i - begin]);
+        }
+    }
+
+    calculateInstanceNormals(instance);
+    updateInstanceBounds(instance);
+}
+
+void ClothBatch::handleInstanceCollisions(const Instance& instance, Vector3* velocities, float deltaTime) {
+    if (m_cylinders.empty()) return;
+
+    // 寬相位：只保留包圍盒與實例重疊的碰撞體
+    auto last = std::upper_bound(m_cylinders.begin(), m_cylinders.end(), instance.boundsMax.x(),
+                                 [](float value, const Cylinder& cylinder) {
+                                     return value < cylinder.boundsMin.x();
+                                 });
+
+    // 每個執行緒重複使用自己的候選清單，避免每步配置記憶體
+    thread_local std::vector<const Cylinder*> candidates;
+    candidates.clear();
+
+    for (auto it = m_cylinders.begin(); it != last; ++it) {
+        if (it->boundsMax.x() < instance.boundsMin.x() ||
+            it->boundsMax.y() < instance.boundsMin.y() || it->boundsMin.y() > instance.boundsMax.y() ||
+            it->boundsMax.z() < instance.boundsMin.z() || it->boundsMin.z() > instance.boundsMax.z()) {
+            continue;
+        }
+        candidates.push_back(&*it);
+    }
+    if (candidates.empty()) return;
+
+    const int begin = instance.firstParticle;
+    const int end = begin + instance.particleCount;
+
+    for (int i = begin; i < end; ++i) {
+        if (!m_useOGC && m_pinned[i]) continue;
+
+        // 接觸以碰撞前的位置偵測，再依序套用，與 ClothSimulation 的接觸收集與處理順序一致
+        const Vector3 position = m_positions[i];
+
+        for (const Cylinder* candidate : candidates) {
+            const Cylinder& cylinder = *candidate;
+            Vector3 localPos = position - cylinder.center;
+
+            if (localPos.y() < -cylinder.height * 0.5f || localPos.y() > cylinder.height * 0.5f) continue;
+
+            float radialDistance = std::sqrt(localPos.x() * localPos.x() + localPos.z() * localPos.z());
+            if (radialDistance >= cylinder.radius) continue;
+
+            Vector3 contactNormal = radialDistance < 1e-6f
+                ? Vector3(1, 0, 0)
+                : Vector3(localPos.x() / radialDistance, 0, localPos.z() / radialDistance);
+
+            if (m_useOGC) {
+                if (m_pinned[i]) continue;
+
+                Vector3 contactPoint = cylinder.center + Vector3(contactNormal.x() * cylinder.radius, localPos.y(),
+                                                                 contactNormal.z() * cylinder.radius);
+                Vector3 force, correction;
+                m_ogcModel->computeResponse(velocities[i - begin], contactNormal,
+                                            (contactPoint - position).length(), force, correction);
+                m_forces[i] += force;
+                m_positions[i] += correction;
+
+                // 摩擦（與 OGCContactModel::processContacts 相同）
+                float normalDisplacement = static_cast<float>(correction.length()) +
+                    std::max(0.0f, static_cast<float>(Vector3::dotProduct(force, contactNormal))) * m_invMass[i] * deltaTime * deltaTime;
+                Vector3 predicted = velocities[i - begin] + m_forces[i] * m_invMass[i] * deltaTime;
+                velocities[i - begin] += OGCContactModel::computeFriction(predicted, contactNormal, normalDisplacement,
+                                                                          cylinder.material, deltaTime);
+            } else {
+                // 基本碰撞處理（與 ClothSimulation 相同）
+                float penetration = cylinder.radius - radialDistance;
+                float correction = penetration * 0.8f;
+                m_positions[i] += contactNormal * correction;
+
+                float normalVelocity = Vector3::dotProduct(velocities[i - begin], contactNormal);
+                float normalDisplacement = correction;
+                if (normalVelocity < 0) {
+                    velocities[i - begin] -= contactNormal * (normalVelocity * 1.2f);
+                    normalDisplacement -= normalVelocity * 1.2f * deltaTime;
+                }
+                Vector3 predicted = velocities[i - begin] + m_forces[i] * m_invMass[i] * deltaTime;
+                velocities[i - begin] += OGCContactModel::computeFriction(predicted, contactNormal, normalDisplacement,
+                                                                          cylinder.material, deltaTime);
+            }
+        }
+    }
+}
+
+void ClothBatch::calculateInstanceNormals(const Instance& instance) {
+    const int base = instance.firstParticle;
+    const int width = instance.width;
+    const int end = base + instance.particleCount;
+
+    for (int i = base; i < end; ++i) {
+        m_normals[i] = Vector3(0, 0, 0);
+    }
+
+    for (int y = 0; y < instance.height - 1; ++y) {
+        for (int x = 0; x < width - 1; ++x) {
+            int i1 = base + y * width + x;
+            int i2 = i1 + 1;
+            int i3 = i1 + width;
+            int i4 = i3 + 1;
+
+            Vector3 normal1 = Vector3::crossProduct(m_positions[i2] - m_positions[i1],
+                                                    m_positions[i3] - m_positions[i1]).normalized();
+            m_normals[i1] += normal1;
+            m_normals[i2] += normal1;
+            m_normals[i3] += normal1;
+
+            Vector3 normal2 = Vector3::crossProduct(m_positions[i4] - m_positions[i2],
+                                                    m_positions[i3] - m_positions[i2]).normalized();
+            m_normals[i2] += normal2;
+            m_normals[i3] += normal2;
+            m_normals[i4] += normal2;
+        }
+    }
+
+    for (int i = base; i < end; ++i) {
+        if (m_normals[i].length() > 0) {
+            m_normals[i].normalize();
+        } else {
+            m_normals[i] = Vector3(0, 1, 0);
+        }
+    }
+}
+
+void ClothBatch::updateInstanceBounds(Instance& instance) {
+    const int begin = instance.firstParticle;
+    const int end = begin + instance.particleCount;
+    if (begin == end) return;
+
+    Vector3 boundsMin = m_positions[begin];
+    Vector3 boundsMax = m_positions[begin];
+    for (int i = begin + 1; i < end; ++i) {
+        const Vector3& p = m_positions[i];
+        boundsMin = Vector3(std::min(boundsMin.x(), p.x()), std::min(boundsMin.y(), p.y()), std::min(boundsMin.z(), p.z()));
+        boundsMax = Vector3(std::max(boundsMax.x(), p.x()), std::max(boundsMax.y(), p.y()), std::max(boundsMax.z(), p.z()));
+    }
+    instance.boundsMin = boundsMin;
+    instance.boundsMax = boundsMax;
+}
+
+} // namespace Physics
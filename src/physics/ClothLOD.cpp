@@ -0,0 +1,117 @@
+#include "physics/ClothLOD.h"
+#include "physics/Log.h"
+#include <algorithm>
+
+namespace Physics {
+
+namespace {
+// 切換層級後至少累積這麼多步的時間才再次依預算切換（移動平均需要時間收斂）
+constexpr int kBudgetSettleSteps = 10;
+constexpr float kAverageWeight = 0.2f;
+}
+
+// ============================================================================
+// ClothLOD Implementation
+// ============================================================================
+
+ClothLOD::ClothLOD(std::shared_ptr<ClothSimulation> simulation, int levelCount)
+    : m_simulation(std::move(simulation))
+    , m_baseSpacing(m_simulation->getSpacing())
+    , m_level(0)
+    , m_switchCount(0)
+    , m_switchDistance(15.0f)
+    , m_hysteresis(0.1f)
+    , m_frameBudget(0.0f)
+    , m_averageStep(0.0f)
+    , m_budgetSamples(0)
+{
+    const int width = m_simulation->getWidth();
+    const int height = m_simulation->getHeight();
+    m_levels.push_back({width, height});
+
+    // 每層格數減半；太粗的層級無法保留布料的形狀
+    if (!m_simulation->isMeshCloth()) {
+        for (int level = 1; level < levelCount; ++level) {
+            const int levelWidth = ((width - 1) >> level) + 1;
+            const int levelHeight = ((height - 1) >> level) + 1;
+            if (levelWidth < 3 || levelHeight < 3) break;
+            m_levels.push_back({levelWidth, levelHeight});
+        }
+    }
+}
+
+bool ClothLOD::setLevel(int level) {
+    level = std::clamp(level, 0, getLevelCount() - 1);
+    if (level == m_level) return false;
+
+    // 較粗的層級不一定能表示第 0 層的每個固定點，離開時記錄，回來時原樣還原
+    if (m_level == 0) {
+        m_basePins = m_simulation->getPinnedParticles();
+    }
+    const Level& resolution = m_levels[level];
+    const bool resampled = level == 0
+        ? m_simulation->resample(resolution.width, resolution.height, m_basePins)
+        : m_simulation->resample(resolution.width, resolution.height);
+    if (!resampled) return false;
+
+    m_level = level;
+    ++m_switchCount;
+    m_budgetSamples = 0;
+    return true;
+}
+
+void ClothLOD::reset() {
+    const Level& resolution = m_levels[0];
+    m_simulation->initialize(resolution.width, resolution.height, m_baseSpacing);
+    m_level = 0;
+    m_budgetSamples = 0;
+}
+
+int ClothLOD::selectByDistance(float cameraDistance) {
+    // 第 l 層的門檻為 switchDistance * 2^(l-1)
+    auto threshold = [this](int level) {
+        return m_switchDistance * static_cast<float>(1 << (level - 1));
+    };
+
+    int target = m_level;
+    while (target + 1 < getLevelCount() && cameraDistance > threshold(target + 1) * (1.0f + m_hysteresis)) {
+        ++target;
+    }
+    while (target > 0 && cameraDistance < threshold(target) * (1.0f - m_hysteresis)) {
+        --target;
+    }
+
+    setLevel(target);
+    return m_level;
+}
+
+int ClothLOD::selectByBudget(float stepMilliseconds) {
+    if (m_frameBudget <= 0.0f) return m_level;
+
+    m_averageStep = m_budgetSamples == 0
+        ? stepMilliseconds : m_averageStep + (stepMilliseconds - m_averageStep) * kAverageWeight;
+    if (++m_budgetSamples < kBudgetSettleSteps) return m_level;
+
+    // 以目前層級的每粒子時間估計其他層級的成本
+    const Level& current = m_levels[m_level];
+    const float perParticle = m_averageStep / (current.width * current.height);
+
+    int target = getLevelCount() - 1;
+    for (int level = 0; level < getLevelCount(); ++level) {
+        const float estimate = perParticle * (m_levels[level].width * m_levels[level].height);
+        const float limit = level < m_level ? m_frameBudget * (1.0f - m_hysteresis) : m_frameBudget;
+        if (estimate <= limit) {
+            target = level;
+            break;
+        }
+    }
+
+    if (target != m_level) {
+        logInfo("布料模擬每步 ", m_averageStep, " ms（預算 ", m_frameBudget, " ms），LOD 層級 ",
+                m_level, " -> ", target);
+        setLevel(target);
+    }
+    return m_level;
+}
+
+} // namespace Physics
@@ -0,0 +1,847 @@
+#include "physics/ClothMesh.h"
+#include "physics/Log.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <initializer_list>
+#include <limits>
+#include <numeric>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define OGC_HAS_MMAP 1
+#endif
+
+namespace Physics {
+
+namespace {
+
+/**
+ * @brief 唯讀的檔案內容：POSIX 上映射到記憶體，其他平台一次讀入緩衝區
+ */
+class MappedFile {
+public:
+    MappedFile() = default;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    ~MappedFile() {
+#ifdef OGC_HAS_MMAP
+        if (m_mapped) {
+            munmap(m_mapped, m_size);
+        }
+#endif
+    }
+
+    bool open(const std::string& path) {
+#ifdef OGC_HAS_MMAP
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+        struct stat info;
+        if (fstat(fd, &info) != 0) {
+            ::close(fd);
+            return false;
+        }
+        m_size = static_cast<std::size_t>(info.st_size);
+        if (m_size > 0) {
+            void* mapped = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapped != MAP_FAILED) {
+                m_mapped = mapped;
+                m_data = static_cast<const char*>(mapped);
+                // 解析器由前往後掃描
+                madvise(mapped, m_size, MADV_SEQUENTIAL);
+            }
+        }
+        ::close(fd);
+        if (m_data || m_size == 0) return true;
+#endif
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        if (!file.is_open()) return false;
+        m_buffer.resize(static_cast<std::size_t>(file.tellg()));
+        file.seekg(0);
+        if (!file.read(m_buffer.data(), static_cast<std::streamsize>(m_buffer.size()))) return false;
+        m_data = m_buffer.data();
+        m_size = m_buffer.size();
+        return true;
+    }
+
+    const char* data() const { return m_data; }
+    std::size_t size() const { return m_size; }
+
+private:
+    const char* m_data = nullptr;
+    std::size_t m_size = 0;
+    void* m_mapped = nullptr;
+    std::vector<char> m_buffer;
+};
+
+/**
+ * @brief 在 [p, end) 上前進的文字掃描器（不要求 '\0' 結尾）
+ */
+struct Scanner {
+    const char* p;
+    const char* end;
+    int line = 1;
+
+    bool atEnd() const { return p >= end; }
+    bool atLineEnd() const { return p >= end || *p == '\n' || *p == '\r' || *p == '#'; }
+
+    void skipSpaces() {
+        while (p < end && (*p == ' ' || *p == '\t')) ++p;
+    }
+
+    void skipWhitespace() {
+        while (p < end && std::isspace(static_cast<unsigned char>(*p))) {
+            if (*p == '\n') ++line;
+            ++p;
+        }
+    }
+
+    void skipLine() {
+        while (p < end && *p != '\n') ++p;
+        if (p < end) {
+            ++p;
+            ++line;
+        }
+    }
+
+    // 讀取到空白為止的一個詞
+    const char* token(std::size_t& length) {
+        const char* begin = p;
+        while (p < end && !std::isspace(static_cast<unsigned char>(*p))) ++p;
+        length = static_cast<std::size_t>(p - begin);
+        return begin;
+    }
+
+    // 絕對值超過 INT_MAX 時失敗，避免長數字串溢位
+    bool parseInt(long long& value) {
+        bool negative = false;
+        if (p < end && (*p == '-' || *p == '+')) {
+            negative = *p == '-';
+            ++p;
+        }
+        if (p >= end || !std::isdigit(static_cast<unsigned char>(*p))) return false;
+        long long result = 0;
+        while (p < end && std::isdigit(static_cast<unsigned char>(*p))) {
+            result = result * 10 + (*p - '0');
+            if (result > std::numeric_limits<int>::max()) return false;
+            ++p;
+        }
+        value = negative ? -result : result;
+        return true;
+    }
+
+    // 十進位浮點數（可含小數點與指數，不接受 nan 與 inf）
+    bool parseReal(double& value) {
+        bool negative = false;
+        if (p < end && (*p == '-' || *p == '+')) {
+            negative = *p == '-';
+            ++p;
+        }
+        std::uint64_t mantissa = 0;
+        int exponent = 0;
+        int digits = 0;
+        while (p < end && std::isdigit(static_cast<unsigned char>(*p))) {
+            if (mantissa < 100000000000000000ull) {
+                mantissa = mantissa * 10 + static_cast<std::uint64_t>(*p - '0');
+            } else {
+                ++exponent;
+            }
+            ++p;
+            ++digits;
+        }
+        if (p < end && *p == '.') {
+            ++p;
+            while (p < end && std::isdigit(static_cast<unsigned char>(*p))) {
+                if (mantissa < 100000000000000000ull) {
+                    mantissa = mantissa * 10 + static_cast<std::uint64_t>(*p - '0');
+                    --exponent;
+                }
+                ++p;
+                ++digits;
+            }
+        }
+        if (digits == 0) return false;
+        if (p < end && (*p == 'e' || *p == 'E')) {
+            ++p;
+            long long power = 0;
+            if (!parseInt(power)) return false;
+            exponent += static_cast<int>(std::max(-400ll, std::min(400ll, power)));
+        }
+
+        double result = static_cast<double>(mantissa);
+        double scale = 1.0;
+        double base = 10.0;
+        for (int e = exponent < 0 ? -exponent : exponent; e > 0; e >>= 1) {
+            if (e & 1) scale *= base;
+            base *= base;
+        }
+        result = exponent < 0 ? result / scale : result * scale;
+        value = negative ? -result : result;
+        return true;
+    }
+};
+
+bool matches(const char* token, std::size_t length, const char* keyword) {
+    return std::strlen(keyword) == length && std::memcmp(token, keyword, length) == 0;
+}
+
+bool hasExtension(const std::string& path, const char* extension) {
+    const std::size_t length = std::strlen(extension);
+    if (path.size() < length) return false;
+    for (std::size_t i = 0; i < length; ++i) {
+        char c = static_cast<char>(std::tolower(static_cast<unsigned char>(path[path.size() - length + i])));
+        if (c != extension[i]) return false;
+    }
+    return true;
+}
+
+// OBJ 索引從 1 開始，負值表示相對於目前已讀取的數量
+bool resolveIndex(long long index, int count, int& resolved) {
+    if (index > 0 && index <= count) {
+        resolved = static_cast<int>(index - 1);
+        return true;
+    }
+    if (index < 0 && -index <= count) {
+        resolved = static_cast<int>(count + index);
+        return true;
+    }
+    return false;
+}
+
+// ============================================================================
+// PLY
+// ============================================================================
+
+enum class PlyType { Int8, UInt8, Int16, UInt16, Int32, UInt32, Float32, Float64, Invalid };
+
+PlyType parsePlyType(const char* token, std::size_t length) {
+    if (matches(token, length, "char") || matches(token, length, "int8")) return PlyType::Int8;
+    if (matches(token, length, "uchar") || matches(token, length, "uint8")) return PlyType::UInt8;
+    if (matches(token, length, "short") || matches(token, length, "int16")) return PlyType::Int16;
+    if (matches(token, length, "ushort") || matches(token, length, "uint16")) return PlyType::UInt16;
+    if (matches(token, length, "int") || matches(token, length, "int32")) return PlyType::Int32;
+    if (matches(token, length, "uint") || matches(token, length, "uint32")) return PlyType::UInt32;
+    if (matches(token, length, "float") || matches(token, length, "float32")) return PlyType::Float32;
+    if (matches(token, length, "double") || matches(token, length, "float64")) return PlyType::Float64;
+    return PlyType::Invalid;
+}
+
+std::size_t plyTypeSize(PlyType type) {
+    switch (type) {
+        case PlyType::Int8: case PlyType::UInt8: return 1;
+        case PlyType::Int16: case PlyType::UInt16: return 2;
+        case PlyType::Int32: case PlyType::UInt32: case PlyType::Float32: return 4;
+        case PlyType::Float64: return 8;
+        default: return 0;
+    }
+}
+
+struct PlyProperty {
+    std::string name;
+    PlyType type = PlyType::Invalid;
+    PlyType countType = PlyType::Invalid;   // 串列屬性的長度型別
+    bool list = false;
+};
+
+struct PlyElement {
+    std::string name;
+    long long count = 0;
+    std::vector<PlyProperty> properties;
+};
+
+enum class PlyFormat { Ascii, BinaryLittleEndian, BinaryBigEndian };
+
+/**
+ * @brief 依標頭描述讀取 PLY 主體的數值
+ */
+class PlyReader {
+public:
+    PlyReader(Scanner& scanner, PlyFormat format) : m_scanner(scanner), m_format(format) {}
+
+    bool read(PlyType type, double& value) {
+        if (m_format == PlyFormat::Ascii) {
+            m_scanner.skipWhitespace();
+            return m_scanner.parseReal(value);
+        }
+
+        const std::size_t size = plyTypeSize(type);
+        if (static_cast<std::size_t>(m_scanner.end - m_scanner.p) < size) return false;
+        unsigned char bytes[8];
+        std::memcpy(bytes, m_scanner.p, size);
+        m_scanner.p += size;
+        if (m_format != nativeFormat()) {
+            std::reverse(bytes, bytes + size);
+        }
+
+        switch (type) {
+            case PlyType::Int8: value = static_cast<std::int8_t>(bytes[0]); break;
+            case PlyType::UInt8: value = bytes[0]; break;
+            case PlyType::Int16: value = load<std::int16_t>(bytes); break;
+            case PlyType::UInt16: value = load<std::uint16_t>(bytes); break;
+            case PlyType::Int32: value = load<std::int32_t>(bytes); break;
+            case PlyType::UInt32: value = load<std::uint32_t>(bytes); break;
+            case PlyType::Float32: value = load<float>(bytes); break;
+            case PlyType::Float64: value = load<double>(bytes); break;
+            default: return false;
+        }
+        return true;
+    }
+
+private:
+    Scanner& m_scanner;
+    PlyFormat m_format;
+
+    static PlyFormat nativeFormat() {
+        const std::uint16_t probe = 1;
+        unsigned char first;
+        std::memcpy(&first, &probe, 1);
+        return first ? PlyFormat::BinaryLittleEndian : PlyFormat::BinaryBigEndian;
+    }
+
+    template <typename T>
+    static double load(const unsigned char* bytes) {
+        T value;
+        std::memcpy(&value, bytes, sizeof(T));
+        return static_cast<double>(value);
+    }
+};
+
+// 每個項目至少佔用的位元組數：ASCII 每個值（含串列長度）至少一個字元，二進位為純量與串列長度的大小
+std::size_t minimumItemSize(const PlyElement& element, PlyFormat format) {
+    std::size_t size = 0;
+    for (const PlyProperty& property : element.properties) {
+        if (format == PlyFormat::Ascii) {
+            size += 1;
+        } else {
+            size += plyTypeSize(property.list ? property.countType : property.type);
+        }
+    }
+    return size;
+}
+
+int findProperty(const PlyElement& element, std::initializer_list<const char*> names) {
+    for (const char* name : names) {
+        for (size_t i = 0; i < element.properties.size(); ++i) {
+            if (element.properties[i].name == name) return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+bool plyError(int line, const char* message) {
+    logInfo("PLY 解析錯誤（第 ", line, " 行）：", message);
+    return false;
+}
+
+} // namespace
+
+// ============================================================================
+// ClothMesh Implementation
+// ============================================================================
+
+ClothMesh::ClothMesh(std::vector<Vector3> vertices, std::vector<std::array<int, 3>> triangles)
+    : m_vertices(std::move(vertices))
+    , m_triangles(std::move(triangles))
+{
+}
+
+bool ClothMesh::load(const std::string& path, ClothMesh& mesh) {
+    if (hasExtension(path, ".obj")) return loadOBJ(path, mesh);
+    if (hasExtension(path, ".ply")) return loadPLY(path, mesh);
+    logInfo("不支援的網格格式: ", path);
+    return false;
+}
+
+bool ClothMesh::loadOBJ(const std::string& path, ClothMesh& mesh) {
+    MappedFile file;
+    if (!file.open(path)) {
+        logInfo("無法開啟網格檔案: ", path);
+        return false;
+    }
+    if (!parseOBJ(file.data(), file.size(), mesh)) return false;
+    logInfo("載入 OBJ 網格 ", path, "：", mesh.getVertexCount(), " 個頂點，", mesh.getTriangleCount(), " 個三角形");
+    return true;
+}
+
+bool ClothMesh::loadPLY(const std::string& path, ClothMesh& mesh) {
+    MappedFile file;
+    if (!file.open(path)) {
+        logInfo("無法開啟網格檔案: ", path);
+        return false;
+    }
+    if (!parsePLY(file.data(), file.size(), mesh)) return false;
+    logInfo("載入 PLY 網格 ", path, "：", mesh.getVertexCount(), " 個頂點，", mesh.getTriangleCount(), " 個三角形");
+    return true;
+}
+
+bool ClothMesh::parseOBJ(const char* data, std::size_t size, ClothMesh& mesh) {
+    Scanner scanner{data, data + size};
+    std::vector<Vector3> vertices;
+    std::vector<Vector2> fileTexCoords;
+    std::vector<int> vertexTexCoord;                 // 每個頂點第一次被引用時的 vt 索引
+    std::vector<std::array<int, 3>> triangles;
+    std::vector<int> corners;
+    bool usesTexCoords = false;
+
+    auto fail = [&](const char* message) {
+        logInfo("OBJ 解析錯誤（第 ", scanner.line, " 行）：", message);
+        return false;
+    };
+
+    while (!scanner.atEnd()) {
+        scanner.skipSpaces();
+        if (scanner.atLineEnd()) {
+            scanner.skipLine();
+            continue;
+        }
+
+        std::size_t length = 0;
+        const char* keyword = scanner.token(length);
+
+        if (matches(keyword, length, "v")) {
+            double xyz[3];
+            for (double& value : xyz) {
+                scanner.skipSpaces();
+                if (!scanner.parseReal(value)) return fail("頂點座標格式錯誤");
+            }
+            vertices.emplace_back(static_cast<Real>(xyz[0]), static_cast<Real>(xyz[1]), static_cast<Real>(xyz[2]));
+            vertexTexCoord.push_back(-1);
+        } else if (matches(keyword, length, "vt")) {
+            double uv[2] = {0.0, 0.0};
+            scanner.skipSpaces();
+            if (!scanner.parseReal(uv[0])) return fail("紋理座標格式錯誤");
+            scanner.skipSpaces();
+            if (!scanner.atLineEnd()) scanner.parseReal(uv[1]);
+            fileTexCoords.emplace_back(static_cast<float>(uv[0]), static_cast<float>(uv[1]));
+        } else if (matches(keyword, length, "f")) {
+            corners.clear();
+            const int vertexCount = static_cast<int>(vertices.size());
+            const int texCoordCount = static_cast<int>(fileTexCoords.size());
+            for (scanner.skipSpaces(); !scanner.atLineEnd(); scanner.skipSpaces()) {
+                long long index = 0;
+                int vertex = 0;
+                if (!scanner.parseInt(index) || !resolveIndex(index, vertexCount, vertex)) {
+                    return fail("面的頂點索引超出範圍");
+                }
+                // v/vt/vn、v//vn 或 v/vt
+                if (scanner.p < scanner.end && *scanner.p == '/') {
+                    ++scanner.p;
+                    long long texIndex = 0;
+                    int texCoord = 0;
+                    if (scanner.parseInt(texIndex)) {
+                        if (!resolveIndex(texIndex, texCoordCount, texCoord)) return fail("紋理座標索引超出範圍");
+                        if (vertexTexCoord[vertex] < 0) vertexTexCoord[vertex] = texCoord;
+                        usesTexCoords = true;
+                    }
+                    if (scanner.p < scanner.end && *scanner.p == '/') {
+                        ++scanner.p;
+                        long long normalIndex = 0;
+                        scanner.parseInt(normalIndex);
+                    }
+                }
+                corners.push_back(vertex);
+            }
+            if (corners.size() < 3) return fail("面的頂點少於三個");
+
+            // 多邊形以第一個頂點為中心扇形分割
+            for (size_t k = 2; k < corners.size(); ++k) {
+                triangles.push_back({corners[0], corners[k - 1], corners[k]});
+            }
+        }
+        scanner.skipLine();
+    }
+
+    if (triangles.empty()) {
+        logInfo("OBJ 解析錯誤：檔案中沒有任何面");
+        return false;
+    }
+
+    mesh.m_vertices = std::move(vertices);
+    mesh.m_triangles = std::move(triangles);
+    mesh.m_texCoords.clear();
+    if (usesTexCoords) {
+        mesh.m_texCoords.resize(mesh.m_vertices.size());
+        for (size_t i = 0; i < mesh.m_vertices.size(); ++i) {
+            if (vertexTexCoord[i] >= 0) {
+                mesh.m_texCoords[i] = fileTexCoords[vertexTexCoord[i]];
+            }
+        }
+    }
+    return true;
+}
+
+bool ClothMesh::parsePLY(const char* data, std::size_t size, ClothMesh& mesh) {
+    Scanner scanner{data, data + size};
+
+    // 標頭
+    std::size_t length = 0;
+    const char* magic = scanner.token(length);
+    if (!matches(magic, length, "ply")) return plyError(scanner.line, "缺少 ply 標記");
+    scanner.skipLine();
+
+    PlyFormat format = PlyFormat::Ascii;
+    std::vector<PlyElement> elements;
+    bool headerEnded = false;
+    while (!scanner.atEnd() && !headerEnded) {
+        scanner.skipSpaces();
+        const char* keyword = scanner.token(length);
+
+        if (matches(keyword, length, "format")) {
+            scanner.skipSpaces();
+            const char* name = scanner.token(length);
+            if (matches(name, length, "ascii")) {
+                format = PlyFormat::Ascii;
+            } else if (matches(name, length, "binary_little_endian")) {
+                format = PlyFormat::BinaryLittleEndian;
+            } else if (matches(name, length, "binary_big_endian")) {
+                format = PlyFormat::BinaryBigEndian;
+            } else {
+                return plyError(scanner.line, "未知的格式");
+            }
+        } else if (matches(keyword, length, "element")) {
+            PlyElement element;
+            scanner.skipSpaces();
+            const char* name = scanner.token(length);
+            element.name.assign(name, length);
+            scanner.skipSpaces();
+            if (!scanner.parseInt(element.count) || element.count < 0) return plyError(scanner.line, "元素數量格式錯誤");
+            elements.push_back(std::move(element));
+        } else if (matches(keyword, length, "property")) {
+            if (elements.empty()) return plyError(scanner.line, "屬性不屬於任何元素");
+            PlyProperty property;
+            scanner.skipSpaces();
+            const char* type = scanner.token(length);
+            if (matches(type, length, "list")) {
+                property.list = true;
+                scanner.skipSpaces();
+                type = scanner.token(length);
+                property.countType = parsePlyType(type, length);
+                scanner.skipSpaces();
+                type = scanner.token(length);
+            }
+            property.type = parsePlyType(type, length);
+            if (property.type == PlyType::Invalid || (property.list && property.countType == PlyType::Invalid)) {
+                return plyError(scanner.line, "未知的屬性型別");
+            }
+            scanner.skipSpaces();
+            const char* name = scanner.token(length);
+            property.name.assign(name, length);
+            elements.back().properties.push_back(std::move(property));
+        } else if (matches(keyword, length, "end_header")) {
+            headerEnded = true;
+        }
+        // comment、obj_info 與其他未知的標頭行直接略過
+        scanner.skipLine();
+    }
+    if (!headerEnded) return plyError(scanner.line, "缺少 end_header");
+
+    // 主體：依元素順序讀取，只保留頂點座標、紋理座標與面的索引
+    PlyReader reader(scanner, format);
+    std::vector<Vector3> vertices;
+    std::vector<Vector2> texCoords;
+    std::vector<std::array<int, 3>> triangles;
+    std::vector<int> corners;
+    bool hasVertices = false;
+
+    for (const PlyElement& element : elements) {
+        // 預先配置前先確認標頭的數量不超過剩下的資料，避免錯誤的標頭要求過大的記憶體
+        const std::size_t itemSize = minimumItemSize(element, format);
+        const std::size_t remaining = static_cast<std::size_t>(scanner.end - scanner.p);
+        if (itemSize > 0 && static_cast<std::size_t>(element.count) > remaining / itemSize) {
+            return plyError(scanner.line, "元素數量超過檔案大小");
+        }
+
+        const bool isVertex = element.name == "vertex";
+        const bool isFace = element.name == "face";
+        int px = -1, py = -1, pz = -1, pu = -1, pv = -1, pIndices = -1;
+        if (isVertex) {
+            px = findProperty(element, {"x"});
+            py = findProperty(element, {"y"});
+            pz = findProperty(element, {"z"});
+            pu = findProperty(element, {"s", "u", "texture_u", "texture_s"});
+            pv = findProperty(element, {"t", "v", "texture_v", "texture_t"});
+            if (px < 0 || py < 0 || pz < 0) return plyError(scanner.line, "頂點缺少 x、y、z 屬性");
+            if (pu < 0 || pv < 0) pu = pv = -1;
+            hasVertices = true;
+            vertices.reserve(static_cast<size_t>(element.count));
+            if (pu >= 0) texCoords.reserve(static_cast<size_t>(element.count));
+        } else if (isFace) {
+            pIndices = findProperty(element, {"vertex_indices", "vertex_index"});
+            if (pIndices < 0 || !element.properties[pIndices].list) return plyError(scanner.line, "面缺少頂點索引串列");
+            triangles.reserve(static_cast<size_t>(element.count) * 2);
+        }
+
+        // 沒有屬性的元素不佔任何資料
+        const int propertyCount = static_cast<int>(element.properties.size());
+        if (propertyCount == 0) continue;
+        for (long long item = 0; item < element.count; ++item) {
+            double values[5] = {0.0, 0.0, 0.0, 0.0, 0.0};
+            corners.clear();
+            for (int k = 0; k < propertyCount; ++k) {
+                const PlyProperty& property = element.properties[k];
+                double value = 0.0;
+                if (!property.list) {
+                    if (!reader.read(property.type, value)) return plyError(scanner.line, "資料不完整");
+                    if (k == px) values[0] = value;
+                    else if (k == py) values[1] = value;
+                    else if (k == pz) values[2] = value;
+                    else if (k == pu) values[3] = value;
+                    else if (k == pv) values[4] = value;
+                    continue;
+                }
+
+                double count = 0.0;
+                if (!reader.read(property.countType, count) || count < 0) return plyError(scanner.line, "串列長度錯誤");
+                for (int c = 0; c < static_cast<int>(count); ++c) {
+                    if (!reader.read(property.type, value)) return plyError(scanner.line, "資料不完整");
+                    if (k == pIndices) corners.push_back(static_cast<int>(value));
+                }
+            }
+
+            if (isVertex) {
+                vertices.emplace_back(static_cast<Real>(values[0]), static_cast<Real>(values[1]), static_cast<Real>(values[2]));
+                if (pu >= 0) texCoords.emplace_back(static_cast<float>(values[3]), static_cast<float>(values[4]));
+            } else if (isFace) {
+                if (corners.size() < 3) return plyError(scanner.line, "面的頂點少於三個");
+                for (size_t k = 2; k < corners.size(); ++k) {
+                    triangles.push_back({corners[0], corners[k - 1], corners[k]});
+                }
+            }
+        }
+    }
+
+    if (!hasVertices || triangles.empty()) return plyError(scanner.line, "檔案中沒有頂點或面");
+    const int vertexCount = static_cast<int>(vertices.size());
+    for (const auto& triangle : triangles) {
+        for (int vertex : triangle) {
+            if (vertex < 0 || vertex >= vertexCount) return plyError(scanner.line, "面的頂點索引超出範圍");
+        }
+    }
+
+    mesh.m_vertices = std::move(vertices);
+    mesh.m_texCoords = std::move(texCoords);
+    mesh.m_triangles = std::move(triangles);
+    return true;
+}
+
+std::vector<std::array<int, 2>> ClothMesh::buildEdges() const {
+    std::vector<std::array<int, 2>> edges;
+    edges.reserve(m_triangles.size() * 3);
+    for (const auto& triangle : m_triangles) {
+        for (int k = 0; k < 3; ++k) {
+            int a = triangle[k];
+            int b = triangle[(k + 1) % 3];
+            edges.push_back({std::min(a, b), std::max(a, b)});
+        }
+    }
+    std::sort(edges.begin(), edges.end());
+    edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+    return edges;
+}
+
+int ClothMesh::computeBandwidth() const {
+    int bandwidth = 0;
+    for (const auto& triangle : m_triangles) {
+        auto range = std::minmax({triangle[0], triangle[1], triangle[2]});
+        bandwidth = std::max(bandwidth, range.second - range.first);
+    }
+    return bandwidth;
+}
+
+int ClothMesh::removeDegenerateTriangles() {
+    const size_t before = m_triangles.size();
+    m_triangles.erase(std::remove_if(m_triangles.begin(), m_triangles.end(), [](const std::array<int, 3>& t) {
+        return t[0] == t[1] || t[1] == t[2] || t[0] == t[2];
+    }), m_triangles.end());
+
+    // 丟棄沒有三角形引用的頂點，其餘頂點保持原來的相對順序
+    const int vertexCount = getVertexCount();
+    std::vector<int> newIndex(vertexCount, -1);
+    for (const auto& triangle : m_triangles) {
+        for (int vertex : triangle) newIndex[vertex] = 0;
+    }
+    int used = 0;
+    for (int& index : newIndex) {
+        if (index == 0) index = used++;
+    }
+    if (used < vertexCount) {
+        int next = used;
+        for (int& index : newIndex) {
+            if (index < 0) index = next++;
+        }
+        applyPermutation(newIndex);
+        m_vertices.resize(used);
+        if (!m_texCoords.empty()) m_texCoords.resize(used);
+    }
+    return static_cast<int>(before - m_triangles.size());
+}
+
+std::vector<int> ClothMesh::reorder(VertexOrder order) {
+    const int vertexCount = getVertexCount();
+    std::vector<int> sequence(vertexCount);     // 新順序中第 k 個位置的原始頂點
+    std::iota(sequence.begin(), sequence.end(), 0);
+
+    if (order == VertexOrder::Morton && vertexCount > 0) {
+        Vector3 lower = m_vertices[0], upper = m_vertices[0];
+        for (const Vector3& vertex : m_vertices) {
+            for (int axis = 0; axis < 3; ++axis) {
+                lower[axis] = std::min(lower[axis], vertex[axis]);
+                upper[axis] = std::max(upper[axis], vertex[axis]);
+            }
+        }
+
+        // 每軸量化到 21 位元後交錯成 63 位元的 Morton 碼
+        auto spread = [](std::uint64_t x) {
+            x &= 0x1fffff;
+            x = (x | x << 32) & 0x1f00000000ffffull;
+            x = (x | x << 16) & 0x1f0000ff0000ffull;
+            x = (x | x << 8) & 0x100f00f00f00f00full;
+            x = (x | x << 4) & 0x10c30c30c30c30c3ull;
+            x = (x | x << 2) & 0x1249249249249249ull;
+            return x;
+        };
+        std::vector<std::uint64_t> codes(vertexCount);
+        for (int i = 0; i < vertexCount; ++i) {
+            std::uint64_t code = 0;
+            for (int axis = 0; axis < 3; ++axis) {
+                const double extent = static_cast<double>(upper[axis] - lower[axis]);
+                const double t = extent > 0.0 ? static_cast<double>(m_vertices[i][axis] - lower[axis]) / extent : 0.0;
+                code |= spread(static_cast<std::uint64_t>(t * 2097151.0)) << axis;
+            }
+            codes[i] = code;
+        }
+        std::stable_sort(sequence.begin(), sequence.end(), [&](int a, int b) { return codes[a] < codes[b]; });
+    } else if (order == VertexOrder::ReverseCuthillMcKee && vertexCount > 0) {
+        // 鄰接表（CSR）
+        const auto edges = buildEdges();
+        std::vector<int> offsets(vertexCount + 1, 0);
+        for (const auto& edge : edges) {
+            ++offsets[edge[0] + 1];
+            ++offsets[edge[1] + 1];
+        }
+        for (int i = 0; i < vertexCount; ++i) {
+            offsets[i + 1] += offsets[i];
+        }
+        std::vector<int> neighbours(offsets[vertexCount]);
+        std::vector<int> cursor(offsets.begin(), offsets.end() - 1);
+        for (const auto& edge : edges) {
+            neighbours[cursor[edge[0]]++] = edge[1];
+            neighbours[cursor[edge[1]]++] = edge[0];
+        }
+        auto degree = [&](int v) { return offsets[v + 1] - offsets[v]; };
+
+        // 每個連通分量內鄰居依度數由小到大走訪
+        for (int v = 0; v < vertexCount; ++v) {
+            std::sort(neighbours.begin() + offsets[v], neighbours.begin() + offsets[v + 1], [&](int a, int b) {
+                return degree(a) != degree(b) ? degree(a) < degree(b) : a < b;
+            });
+        }
+
+        std::vector<int> level(vertexCount, -1);
+        std::vector<int> queue;
+        queue.reserve(vertexCount);
+
+        // 廣度優先走訪一個連通分量，回傳最後一層中度數最小的頂點
+        auto breadthFirst = [&](int start, std::vector<int>& visited) {
+            visited.clear();
+            visited.push_back(start);
+            level[start] = 0;
+            for (size_t head = 0; head < visited.size(); ++head) {
+                int v = visited[head];
+                for (int k = offsets[v]; k < offsets[v + 1]; ++k) {
+                    int n = neighbours[k];
+                    if (level[n] < 0) {
+                        level[n] = level[v] + 1;
+                        visited.push_back(n);
+                    }
+                }
+            }
+            const int depth = level[visited.back()];
+            int farthest = visited.back();
+            for (int v : visited) {
+                if (level[v] == depth && degree(v) < degree(farthest)) farthest = v;
+            }
+            return farthest;
+        };
+
+        std::vector<int> byDegree(vertexCount);
+        std::iota(byDegree.begin(), byDegree.end(), 0);
+        std::stable_sort(byDegree.begin(), byDegree.end(), [&](int a, int b) { return degree(a) < degree(b); });
+
+        std::vector<unsigned char> placed(vertexCount, 0);
+        std::vector<int> component;
+        sequence.clear();
+        for (int seed : byDegree) {
+            if (placed[seed]) continue;
+
+            // 以兩次走訪找到近似的周邊頂點作為起點
+            int start = breadthFirst(seed, component);
+            for (int v : component) level[v] = -1;
+            breadthFirst(start, component);
+            for (int v : component) level[v] = -1;
+
+            // Cuthill-McKee：依走訪順序排列（鄰居已依度數排序）
+            queue.clear();
+            queue.push_back(start);
+            placed[start] = 1;
+            for (size_t head = 0; head < queue.size(); ++head) {
+                int v = queue[head];
+                for (int k = offsets[v]; k < offsets[v + 1]; ++k) {
+                    int n = neighbours[k];
+                    if (!placed[n]) {
+                        placed[n] = 1;
+                        queue.push_back(n);
+                    }
+                }
+            }
+            sequence.insert(sequence.end(), queue.begin(), queue.end());
+        }
+        std::reverse(sequence.begin(), sequence.end());
+    }
+
+    std::vector<int> newIndex(vertexCount);
+    for (int k = 0; k < vertexCount; ++k) {
+        newIndex[sequence[k]] = k;
+    }
+    applyPermutation(newIndex);
+    return newIndex;
+}
+
+void ClothMesh::applyPermutation(const std::vector<int>& newIndex) {
+    std::vector<Vector3> vertices(m_vertices.size());
+    for (size_t i = 0; i < m_vertices.size(); ++i) {
+        vertices[newIndex[i]] = m_vertices[i];
+    }
+    m_vertices = std::move(vertices);
+
+    if (!m_texCoords.empty()) {
+        std::vector<Vector2> texCoords(m_texCoords.size());
+        for (size_t i = 0; i < m_texCoords.size(); ++i) {
+            texCoords[newIndex[i]] = m_texCoords[i];
+        }
+        m_texCoords = std::move(texCoords);
+    }
+
+    for (auto& triangle : m_triangles) {
+        for (int& vertex : triangle) {
+            vertex = newIndex[vertex];
+        }
+    }
+
+    // 三角形依排序後的頂點索引排列（保留環繞方向），法線計算依序存取粒子
+    auto key = [](const std::array<int, 3>& t) {
+        std::array<int, 3> sorted = t;
+        std::sort(sorted.begin(), sorted.end());
+        return sorted;
+    };
+    std::stable_sort(m_triangles.begin(), m_triangles.end(),
+                     [&](const std::array<int, 3>& a, const std::array<int, 3>& b) { return key(a) < key(b); });
+}
+
+} // namespace Physics
@@ -1,24 +1,97 @@
 #include "physics/ClothSimulation.h"
 #include "physics/OGCContactModel.h"
+#include "physics/ImplicitSolver.h"
+#include "physics/ProjectiveSolver.h"
+#include "physics/Log.h"
 #include <cmath>
+#include <cstring>
 #include <algorithm>
-#include <QDebug>
-#include <QOpenGLFunctions>
-#include <QOpenGLContext>
-
-#ifdef __APPLE__
-#include <OpenGL/gl3.h>
-#else
-#include <GL/gl.h>
-#endif
+#include <unordered_map>
+#include <limits>
+#include <array>
+#include <utility>
+#include <chrono>
 
 namespace Physics {
 
+namespace {
+// 著色批次的上限；這個顏色的批次內約束可能共用粒子，必須序列求解
+constexpr int kSerialBatchColor = 63;
+
+// 休眠區塊的邊長（粒子數）
+constexpr int kSleepTileSize = 8;
+
+// 區塊動能超過休眠門檻的這個倍數時才喚醒相鄰區塊，避免邊界上反覆休眠與喚醒
+constexpr float kWakeNeighbourFactor = 10.0f;
+
+// 加速求解時，殘差比上一次迭代高出這個倍數即視為發散
+constexpr float kDivergenceFactor = 1.05f;
+
+// 粗層約束的剛度（與 ClothConstraint 預設值相同）
+constexpr float kHierarchyStiffness = 0.8f;
+
+// 連續碰撞：距離小於此值即視為接觸，停下的粒子離表面這麼遠
+constexpr float kContinuousTolerance = 1e-4f;
+constexpr float kContinuousSkin = 5e-4f;
+
+// 保守推進的最大迭代次數，用完仍未分出結果時保守地視為碰撞
+constexpr int kMaxAdvancementSteps = 32;
+
+// OGC 保守位移界限：頂點這一步最多移動相鄰特徵到碰撞體最小距離的這個比例
+constexpr float kBoundRelaxation = 0.45f;
+
+// 頂點到達位移界限後，從截斷的位置重新查詢距離並繼續前進的最多次數
+constexpr int kMaxBoundPasses = 4;
+
+// 頂點距離查詢的上限是所需範圍的這個倍數，多出的部分讓之後的步驟可以略過查詢
+constexpr float kQuerySlack = 2.0f;
+
+// 相鄰特徵比頂點更靠近碰撞體超過接觸半徑的這個比例時，界限不以頂點重新查詢放寬
+// （碰撞體的細部或尖角在頂點之間，頂點本身的距離不代表布料的距離）
+constexpr float kFeatureLimitTolerance = 0.1f;
+
+// 邊與面的接觸只在最近點位於內部時建立（重心座標都大於此值），否則屬於相鄰的頂點或邊
+constexpr float kFeatureInteriorMargin = 0.05f;
+
+// 邊與面需要補上的穿透小於接觸半徑的這個比例時忽略
+constexpr float kFeatureDepthFraction = 1e-3f;
+
+// 邊與面上最近點的投影修正次數（查詢碰撞體最近點後投影回特徵上）
+constexpr int kFeatureProjectionIterations = 3;
+
+// 時間預算：每步耗時移動平均的權重、換等級後至少量測的步數，
+// 以及回升一級所需的連續步數與耗時比例
+constexpr float kStepTimeWeight = 0.25f;
+constexpr int kQualitySettleSteps = 3;
+constexpr int kQualityRaiseSteps = 30;
+constexpr float kQualityRaiseFraction = 0.6f;
+
+// 基本碰撞模式的響應：推出穿透、反彈法向速度並套用庫倫摩擦（都相對於碰撞體表面的速度）
+void applyBasicResponse(ClothParticle* particle, const Vector3& contactNormal, float penetration,
+                        const Vector3& colliderVelocity, const ColliderMaterial& material, float deltaTime) {
+    // 位置修正
+    float correction = penetration * 0.8f;
+    particle->position += contactNormal * correction;
+    
+    // 速度修正（反彈）
+    float normalVelocity = Vector3::dotProduct(particle->velocity - colliderVelocity, contactNormal);
+    float normalDisplacement = correction;
+    if (normalVelocity < 0) {
+        particle->velocity -= contactNormal * (normalVelocity * 1.2f); // 反彈係數
+        normalDisplacement -= normalVelocity * 1.2f * deltaTime;
+    }
+    
+    // 摩擦力：以這一步法向推動的距離決定摩擦錐
+    Vector3 predicted = particle->velocity + particle->force * particle->invMass * deltaTime - colliderVelocity;
+    particle->velocity += OGCContactModel::computeFriction(predicted, contactNormal, normalDisplacement, material, deltaTime);
+}
+}
+
 // ============================================================================
 // ClothParticle Implementation
 // ============================================================================
 
-ClothParticle::ClothParticle(const QVector3D& pos, float m)
+ClothParticle::ClothParticle(const Vector3& pos, float m)
     : position(pos)
     , velocity(0, 0, 0)
     , acceleration(0, 0, 0)
@@ -26,13 +99,14 @@ ClothParticle::ClothParticle(const QVector3D& pos, float m)
     , mass(m)
     , invMass(m > 0 ? 1.0f / m : 0.0f)
     , pinned(false)
+    , sleeping(false)
     , normal(0, 1, 0)
     , texCoord(0, 0)
 {
 }
 
 void ClothParticle::update(float deltaTime) {
-    if (pinned) return;
+    if (pinned || sleeping) return;
     
     // Verlet integration
     acceleration = force * invMass;
@@ -42,12 +116,12 @@ void ClothParticle::update(float deltaTime) {
     clearForces();
 }
 
-void ClothParticle::addForce(const QVector3D& f) {
+void ClothParticle::addForce(const Vector3& f) {
     force += f;
 }
 
 void ClothParticle::clearForces() {
-    force = QVector3D(0, 0, 0);
+    force = Vector3(0, 0, 0);
 }
 
 // ============================================================================
@@ -67,49 +141,95 @@ ClothConstraint::ClothConstraint(ClothParticle* p1, ClothParticle* p2, float res
     }
 }
 
-void ClothConstraint::satisfy() {
-    QVector3D delta = particle2->position - particle1->position;
+float ClothConstraint::satisfy(float relaxation) {
+    // 兩端都在休眠中的約束不需要求解；只有一端休眠時該端視為固定
+    if (particle1->sleeping && particle2->sleeping) return 0.0f;
+    const bool movable1 = !particle1->pinned && !particle1->sleeping;
+    const bool movable2 = !particle2->pinned && !particle2->sleeping;
+    
+    Vector3 delta = particle2->position - particle1->position;
     float currentLength = delta.length();
     
-    if (currentLength < 1e-6f) return;
+    if (currentLength < 1e-6f) return 0.0f;
     
     float difference = (currentLength - restLength) / currentLength;
-    QVector3D correction = delta * difference * 0.5f * stiffness;
+    Vector3 correction = delta * difference * 0.5f * stiffness * relaxation;
     
-    if (!particle1->pinned) {
+    if (movable1) {
         particle1->position += correction;
     }
-    if (!particle2->pinned) {
+    if (movable2) {
         particle2->position -= correction;
     }
     
     // 阻尼
-    QVector3D relativeVelocity = particle2->velocity - particle1->velocity;
-    QVector3D dampingForce = relativeVelocity * damping;
+    Vector3 relativeVelocity = particle2->velocity - particle1->velocity;
+    Vector3 dampingForce = relativeVelocity * damping;
     
-    if (!particle1->pinned) {
+    if (movable1) {
         particle1->velocity += dampingForce * particle1->invMass;
     }
-    if (!particle2->pinned) {
+    if (movable2) {
         particle2->velocity -= dampingForce * particle2->invMass;
     }
+    
+    return restLength > 0.0f ? std::abs(currentLength - restLength) / restLength : 0.0f;
+}
+
+template <bool Movable1, bool Movable2, bool Damped, bool CheckSleep>
+float ClothConstraint::project(float relaxation) {
+    // 與 satisfy() 相同的運算順序；固定狀態由樣板參數決定，分支在編譯期消除
+    bool movable1 = Movable1;
+    bool movable2 = Movable2;
+    if (CheckSleep) {
+        if (particle1->sleeping && particle2->sleeping) return 0.0f;
+        movable1 = Movable1 && !particle1->sleeping;
+        movable2 = Movable2 && !particle2->sleeping;
+    }
+    
+    Vector3 delta = particle2->position - particle1->position;
+    float currentLength = delta.length();
+    
+    if (currentLength < 1e-6f) return 0.0f;
+    
+    float difference = (currentLength - restLength) / currentLength;
+    Vector3 correction = delta * difference * 0.5f * stiffness * relaxation;
+    
+    if (movable1) {
+        particle1->position += correction;
+    }
+    if (movable2) {
+        particle2->position -= correction;
+    }
+    
+    if (Damped) {
+        Vector3 relativeVelocity = particle2->velocity - particle1->velocity;
+        Vector3 dampingForce = relativeVelocity * damping;
+        
+        if (movable1) {
+            particle1->velocity += dampingForce * particle1->invMass;
+        }
+        if (movable2) {
+            particle2->velocity -= dampingForce * particle2->invMass;
+        }
+    }
+    
+    return restLength > 0.0f ? std::abs(currentLength - restLength) / restLength : 0.0f;
 }
 
 // ============================================================================
 // CylinderCollider Implementation
 // ============================================================================
 
-CylinderCollider::CylinderCollider(const QVector3D& center, float r, float h)
+CylinderCollider::CylinderCollider(const Vector3& center, float r, float h)
     : center(center)
     , radius(r)
     , height(h)
 {
-    transform.setToIdentity();
-    transform.translate(center);
 }
 
-bool CylinderCollider::checkCollision(ClothParticle* particle, QVector3D& contactPoint, QVector3D& contactNormal) {
-    QVector3D localPos = particle->position - center;
+bool CylinderCollider::checkCollision(ClothParticle* particle, Vector3& contactPoint, Vector3& contactNormal) {
+    Vector3 localPos = particle->position - center;
     
     // 檢查高度範圍
     if (localPos.y() < -height * 0.5f || localPos.y() > height * 0.5f) {
@@ -123,18 +243,44 @@ bool CylinderCollider::checkCollision(ClothParticle* particle, QVector3D& contac
         // 發生碰撞
         if (radialDistance < 1e-6f) {
             // 粒子在圓柱軸上，使用預設法線
-            contactNormal = QVector3D(1, 0, 0);
+            contactNormal = Vector3(1, 0, 0);
         } else {
-            contactNormal = QVector3D(localPos.x() / radialDistance, 0, localPos.z() / radialDistance);
+            contactNormal = Vector3(localPos.x() / radialDistance, 0, localPos.z() / radialDistance);
         }
         
-        contactPoint = center + QVector3D(contactNormal.x() * radius, localPos.y(), contactNormal.z() * radius);
+        contactPoint = center + Vector3(contactNormal.x() * radius, localPos.y(), contactNormal.z() * radius);
         return true;
     }
     
     return false;
 }
 
+float CylinderCollider::signedDistance(const Vector3& position, Vector3& normal) const {
+    Vector3 localPos = position - center;
+    float radialDistance = sqrt(localPos.x() * localPos.x() + localPos.z() * localPos.z());
+    Vector3 radialDirection = radialDistance > 1e-6f
+        ? Vector3(localPos.x() / radialDistance, 0, localPos.z() / radialDistance)
+        : Vector3(1, 0, 0);
+    Vector3 capDirection(0, localPos.y() < 0 ? -1.0f : 1.0f, 0);
+    
+    float radialGap = radialDistance - radius;
+    float capGap = std::abs(static_cast<float>(localPos.y())) - height * 0.5f;
+    
+    if (radialGap > 0 && capGap > 0) {
+        // 最近點在蓋子的邊緣
+        float distance = sqrt(radialGap * radialGap + capGap * capGap);
+        normal = (radialDirection * radialGap + capDirection * capGap) / distance;
+        return distance;
+    }
+    
+    if (radialGap > capGap) {
+        normal = radialDirection;
+        return radialGap;
+    }
+    normal = capDirection;
+    return capGap;
+}
+
 // ============================================================================
 // ClothSimulation Implementation
 // ============================================================================
@@ -143,66 +289,214 @@ ClothSimulation::ClothSimulation(int width, int height, float spacing)
     : m_width(width)
     , m_height(height)
     , m_spacing(spacing)
+    , m_meshCloth(false)
     , m_useOGC(true)
     , m_gravity(0, -9.81f, 0)
     , m_wind(0, 0, 0)
     , m_damping(0.99f)
     , m_timeStep(1.0f / 60.0f)
     , m_constraintIterations(3)
+    , m_adaptiveIterations(false)
+    , m_solverTolerance(0.25f)
+    , m_minConstraintIterations(1)
+    , m_maxConstraintIterations(20)
+    , m_solverAcceleration(SolverAcceleration::None)
+    , m_relaxationFactor(1.5f)
+    , m_spectralRadius(0.95f)
+    , m_hierarchicalSolver(false)
+    , m_hierarchyLevels(8)
+    , m_coarseIterations(8)
+    , m_integrator(Integrator::SemiImplicitEuler)
     , m_paused(false)
     , m_simulationTime(0.0f)
-    , m_renderDataDirty(true)
+    , m_deterministic(false)
+    , m_stepGraphUsesOGC(false)
+    , m_stepGraphIntegrator(Integrator::SemiImplicitEuler)
+    , m_stepDeltaTime(0.0f)
+    , m_substeps(1)
+    , m_frameBudget(0.0f)
+    , m_qualityLevel(0)
+    , m_averageStepTime(0.0f)
+    , m_qualitySamples(0)
+    , m_underBudgetSteps(0)
+    , m_normalStepCounter(0)
+    , m_stepIterations(3)
+    , m_updateNormals(true)
+    , m_specializedKernels(true)
+    , m_sleepingEnabled(false)
+    , m_sleepThreshold(5e-4f)
+    , m_sleepFrames(30)
+    , m_tilesX(0)
+    , m_tilesY(0)
+    , m_awakeTileCount(0)
+    , m_continuousCollision(false)
+    , m_continuousHitCount(0)
+    , m_cylinderMotionBound(0.0f)
+    , m_offsetContacts(true)
+    , m_maxFeatureEdge(0.0f)
+    , m_boundClampCount(0)
+    , m_querySkipping(true)
+    , m_queryCacheValid(false)
+    , m_colliderTravel(0.0f)
 {
     m_ogcModel = std::make_unique<OGCContactModel>(0.05f);
+    m_implicitSolver = std::make_unique<ImplicitSolver>();
+    m_projectiveSolver = std::make_unique<ProjectiveSolver>();
 }
 
-ClothSimulation::~ClothSimulation() {
-    // OpenGL 資源清理
-    // 注意：在實際應用中，應該在適當的 OpenGL 上下文中清理資源
-    // 這裡暫時註解掉以避免編譯錯誤
-    /*
-    if (QOpenGLContext::currentContext()) {
-        auto* gl = QOpenGLContext::currentContext()->functions();
-        if (m_VAO) gl->glDeleteVertexArrays(1, &m_VAO);
-        if (m_VBO) gl->glDeleteBuffers(1, &m_VBO);
-        if (m_EBO) gl->glDeleteBuffers(1, &m_EBO);
+ClothSimulation::~ClothSimulation() = default;
+
+void ClothSimulation::initialize() {
+    logInfo("初始化布料模擬...");
+    
+    m_cylinders.clear();
+    createCloth();
+    
+    // 添加預設圓柱體
+    addCylinder(Vector3(0, -2, 0), 1.5f, 0.5f);
+    
+    // 固定布料頂部（匯入的網格由使用者指定固定點）
+    if (!m_meshCloth) {
+        for (int x = 0; x < m_width; ++x) {
+            if (x % 4 == 0) {  // 每隔4個點固定一個
+                getParticle(x, 0)->pinned = true;
+            }
+        }
     }
-    */
     
-    // 重置 OpenGL 資源 ID
-    m_VAO = 0;
-    m_VBO = 0;
-    m_EBO = 0;
+    buildSolverData();
+    
+    m_simulationTime = 0.0f;
+    
+    logInfo("布料模擬初始化完成：", m_particles.size(), " 個粒子，", m_constraints.size(), " 個約束");
 }
 
-void ClothSimulation::initialize() {
-    qDebug() << "初始化布料模擬...";
-    
-    // 清理現有數據
-    m_particles.clear();
+void ClothSimulation::createCloth() {
+    // 清理現有數據（約束指向粒子，先清除）
     m_constraints.clear();
-    m_cylinders.clear();
+    m_particles.clear();
+    m_particleStorage.clear();
     
     // 創建布料網格
-    createClothMesh();
-    createConstraints();
+    if (m_meshCloth) {
+        createMeshParticles();
+        createMeshConstraints();
+    } else {
+        createClothMesh();
+        createConstraints();
+    }
+    buildContactFeatures();
+    buildConstraintBatches();
+}
+
+void ClothSimulation::buildSolverData() {
+    buildConstraintKernels();
+    buildSleepTiles();
+    buildHierarchy();
+    m_implicitSolver->build(m_particles, m_constraints);
+    m_projectiveSolver->build(m_particles, m_constraints);
+}
+
+bool ClothSimulation::resample(int width, int height) {
+    return resampleGrid(width, height, nullptr);
+}
+
+bool ClothSimulation::resample(int width, int height, const std::vector<PinnedParticle>& pins) {
+    return resampleGrid(width, height, &pins);
+}
+
+std::vector<PinnedParticle> ClothSimulation::getPinnedParticles() const {
+    std::vector<PinnedParticle> pins;
+    for (size_t i = 0; i < m_particles.size(); ++i) {
+        if (m_particles[i]->pinned) {
+            pins.push_back({static_cast<int>(i), m_particles[i]->position});
+        }
+    }
+    return pins;
+}
+
+bool ClothSimulation::resampleGrid(int width, int height, const std::vector<PinnedParticle>* pins) {
+    if (m_meshCloth || m_particles.empty()) {
+        logInfo("只有規則網格布料可以改變解析度");
+        return false;
+    }
+    width = std::max(2, width);
+    height = std::max(2, height);
+    if (width == m_width && height == m_height) {
+        return true;
+    }
     
-    // 添加預設圓柱體
-    addCylinder(QVector3D(0, -2, 0), 1.5f, 0.5f);
+    // 保存舊網格的狀態（依網格索引）
+    const int oldWidth = m_width;
+    const int oldHeight = m_height;
+    std::vector<Vector3> positions(m_particles.size());
+    std::vector<Vector3> velocities(m_particles.size());
+    std::vector<int> pinned;
+    for (size_t i = 0; i < m_particles.size(); ++i) {
+        positions[i] = m_particles[i]->position;
+        velocities[i] = m_particles[i]->velocity;
+        if (m_particles[i]->pinned) {
+            pinned.push_back(static_cast<int>(i));
+        }
+    }
+    
+    // 布料的實際寬度不變，靜止長度由新的間距決定
+    m_spacing *= static_cast<float>(oldWidth - 1) / (width - 1);
+    m_width = width;
+    m_height = height;
+    createCloth();
     
-    // 固定布料頂部
-    for (int x = 0; x < m_width; ++x) {
-        if (x % 4 == 0) {  // 每隔4個點固定一個
-            getParticle(x, 0)->pinned = true;
+    // 在相同的參數座標對舊網格做雙線性內插
+    const float scaleX = static_cast<float>(oldWidth - 1) / (width - 1);
+    const float scaleY = static_cast<float>(oldHeight - 1) / (height - 1);
+    for (int y = 0; y < height; ++y) {
+        const float v = y * scaleY;
+        const int y0 = std::min(static_cast<int>(v), oldHeight - 2);
+        const float ty = v - y0;
+        for (int x = 0; x < width; ++x) {
+            const float u = x * scaleX;
+            const int x0 = std::min(static_cast<int>(u), oldWidth - 2);
+            const float tx = u - x0;
+            
+            const int i00 = y0 * oldWidth + x0;
+            const int i10 = i00 + 1;
+            const int i01 = i00 + oldWidth;
+            const int i11 = i01 + 1;
+            const float w00 = (1.0f - tx) * (1.0f - ty);
+            const float w10 = tx * (1.0f - ty);
+            const float w01 = (1.0f - tx) * ty;
+            const float w11 = tx * ty;
+            
+            ClothParticle* particle = getParticle(x, y);
+            particle->position = positions[i00] * w00 + positions[i10] * w10 + positions[i01] * w01 + positions[i11] * w11;
+            particle->velocity = velocities[i00] * w00 + velocities[i10] * w10 + velocities[i01] * w01 + velocities[i11] * w11;
         }
     }
     
-    m_simulationTime = 0.0f;
-    m_renderDataDirty = true;
+    if (pins) {
+        for (const PinnedParticle& pin : *pins) {
+            if (pin.index < 0 || pin.index >= static_cast<int>(m_particles.size())) continue;
+            ClothParticle* particle = m_particles[pin.index];
+            particle->pinned = true;
+            particle->position = pin.position;
+            particle->velocity = Vector3(0, 0, 0);
+        }
+    } else {
+        // 每個舊固定點固定新網格中最近的粒子；位置沿用內插結果，不整除時強制移到舊位置會拉伸相鄰約束
+        for (int index : pinned) {
+            const int x = static_cast<int>(std::lround((index % oldWidth) / scaleX));
+            const int y = static_cast<int>(std::lround((index / oldWidth) / scaleY));
+            ClothParticle* particle = getParticle(std::min(x, width - 1), std::min(y, height - 1));
+            particle->pinned = true;
+            particle->velocity = Vector3(0, 0, 0);
+        }
+    }
     
-    qDebug() << QString("布料模擬初始化完成：%1 個粒子，%2 個約束")
-                .arg(m_particles.size())
-                .arg(m_constraints.size());
+    buildSolverData();
+    m_queryCacheValid = false;
+    
+    logInfo("布料解析度改為 ", width, "x", height, "（", m_particles.size(), " 個粒子，", m_constraints.size(), " 個約束）");
+    return true;
 }
 
 void ClothSimulation::initialize(int width, int height, float spacing) {
@@ -210,48 +504,375 @@ void ClothSimulation::initialize(int width, int height, float spacing) {
     m_width = width;
     m_height = height;
     m_spacing = spacing;
+    m_meshCloth = false;
+    m_mesh = ClothMesh();
     
     // 調用標準初始化
     initialize();
 }
 
+void ClothSimulation::initialize(const ClothMesh& mesh) {
+    if (mesh.empty()) {
+        logInfo("布料網格沒有三角形，保留目前的布料");
+        return;
+    }
+    
+    m_mesh = mesh;
+    m_meshCloth = true;
+    m_width = mesh.getVertexCount();
+    m_height = 1;
+    
+    // 平均邊長作為特徵尺寸
+    const auto edges = mesh.buildEdges();
+    double totalLength = 0.0;
+    for (const auto& edge : edges) {
+        totalLength += (mesh.getVertices()[edge[0]] - mesh.getVertices()[edge[1]]).length();
+    }
+    m_spacing = edges.empty() ? 0.0f : static_cast<float>(totalLength / edges.size());
+    
+    initialize();
+}
+
 void ClothSimulation::update(float deltaTime) {
     if (m_paused) return;
     
-    float dt = std::min(deltaTime, m_timeStep);
+    const auto start = std::chrono::steady_clock::now();
+    
+    // 時間預算模式依上一步的耗時選擇品質等級，否則使用完整品質
+    const std::vector<QualitySetting> ladder = buildQualityLadder();
+    if (m_frameBudget > 0.0f) {
+        m_qualityLevel = std::min(m_qualityLevel, static_cast<int>(ladder.size()) - 1);
+    }
+    const QualitySetting& quality = ladder[m_frameBudget > 0.0f ? m_qualityLevel : 0];
+    m_stepIterations = quality.iterations;
+    m_updateNormals = m_normalStepCounter % quality.normalInterval == 0;
+    m_normalStepCounter = m_updateNormals ? 1 : m_normalStepCounter + 1;
+    
+    const float dt = std::min(deltaTime, m_timeStep);
+    const float substepTime = dt / quality.substeps;
     
-    // 應用外力
-    applyForces();
+    for (int substep = 0; substep < quality.substeps; ++substep) {
+        m_stepDeltaTime = substepTime;
+        
+        // 動畫碰撞體每個子步求值一次（該子步結束時的姿態）
+        updateColliderMotion(m_simulationTime + substepTime, substepTime);
+        
+        if (m_sleepingEnabled && m_awakeTileCount == 0) {
+            // 所有區塊都在休眠：直到喚醒事件之前不需要任何計算
+            m_simulationTime += substepTime;
+            continue;
+        }
+        
+        if (m_scheduler) {
+            // 多執行緒：以任務圖執行各階段，讓互不相依的階段重疊；
+            // 法線階段讀取上一步結束時的位置，只在第一個子步計算
+            const bool updateNormals = m_updateNormals;
+            m_updateNormals = updateNormals && substep == 0;
+            if (m_stepGraph.empty() || m_stepGraphUsesOGC != m_useOGC || m_stepGraphIntegrator != m_integrator) {
+                buildStepGraph();
+            }
+            m_stepGraph.run(*m_scheduler);
+            m_updateNormals = updateNormals;
+        } else {
+            // 應用外力
+            applyForces();
+            
+            // 處理碰撞
+            handleCollisions();
+            
+            // 更新粒子並滿足約束
+            integrate(substepTime);
+            
+            // 計算法線（只在最後一個子步）
+            if (m_updateNormals && substep == quality.substeps - 1) {
+                calculateNormals();
+            }
+        }
+        
+        m_simulationTime += substepTime;
+    }
+    
+    if (m_sleepingEnabled) {
+        updateSleepState(dt);
+    }
     
-    // 處理碰撞
-    handleCollisions();
+    const float milliseconds = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+    m_stepQuality.level = m_frameBudget > 0.0f ? m_qualityLevel : 0;
+    m_stepQuality.substeps = quality.substeps;
+    m_stepQuality.constraintIterations = quality.iterations;
+    m_stepQuality.normalsUpdated = m_updateNormals;
+    m_stepQuality.stepMilliseconds = milliseconds;
     
-    // 更新粒子
-    updateParticles(dt);
+    if (m_frameBudget > 0.0f) {
+        adjustQuality(milliseconds, static_cast<int>(ladder.size()));
+    }
+}
+
+void ClothSimulation::setFrameBudget(float milliseconds) {
+    m_frameBudget = std::max(0.0f, milliseconds);
+    m_qualityLevel = 0;
+    m_qualitySamples = 0;
+    m_underBudgetSteps = 0;
+}
+
+std::vector<ClothSimulation::QualitySetting> ClothSimulation::buildQualityLadder() const {
+    // 完整品質：使用者設定的子步與迭代次數（自適應模式為迭代上限），每步重算法線
+    const int iterations = m_adaptiveIterations ? std::max(1, m_maxConstraintIterations) : m_constraintIterations;
+    std::vector<QualitySetting> ladder;
+    ladder.push_back({m_substeps, iterations, 1});
+    if (m_frameBudget <= 0.0f) return ladder;
     
-    // 滿足約束（多次迭代）
-    for (int i = 0; i < m_constraintIterations; ++i) {
-        satisfyConstraints();
+    // 先降低不影響模擬結果的法線，再減少子步，最後減少迭代次數
+    ladder.push_back({m_substeps, iterations, 2});
+    for (int substeps = m_substeps / 2; substeps >= 1; substeps /= 2) {
+        ladder.push_back({substeps, iterations, 2});
     }
+    for (int quarters = 3; quarters >= 1; --quarters) {
+        ladder.push_back({1, std::max(std::min(iterations, 1), iterations * quarters / 4), 2});
+    }
+    ladder.back().normalInterval = 4;
     
-    // 計算法線
-    calculateNormals();
+    // 設定本身已很低時部分等級相同，去除重複
+    ladder.erase(std::unique(ladder.begin(), ladder.end()), ladder.end());
+    return ladder;
+}
+
+void ClothSimulation::adjustQuality(float milliseconds, int levelCount) {
+    // 換等級後重新累積移動平均，至少量測幾步才再次降級
+    ++m_qualitySamples;
+    m_averageStepTime = m_qualitySamples == 1
+        ? milliseconds : m_averageStepTime + (milliseconds - m_averageStepTime) * kStepTimeWeight;
     
-    m_simulationTime += dt;
-    m_renderDataDirty = true;
+    if (m_averageStepTime > m_frameBudget) {
+        m_underBudgetSteps = 0;
+        if (m_qualitySamples >= kQualitySettleSteps && m_qualityLevel + 1 < levelCount) {
+            ++m_qualityLevel;
+            m_qualitySamples = 0;
+        }
+    } else if (m_averageStepTime < m_frameBudget * kQualityRaiseFraction) {
+        if (++m_underBudgetSteps >= kQualityRaiseSteps && m_qualityLevel > 0) {
+            --m_qualityLevel;
+            m_qualitySamples = 0;
+            m_underBudgetSteps = 0;
+        }
+    } else {
+        m_underBudgetSteps = 0;
+    }
 }
 
 void ClothSimulation::reset() {
     initialize();
 }
 
-void ClothSimulation::addCylinder(const QVector3D& center, float radius, float height) {
+void ClothSimulation::addCylinder(const Vector3& center, float radius, float height) {
     auto cylinder = std::make_unique<CylinderCollider>(center, radius, height);
     m_cylinders.push_back(std::move(cylinder));
+    collidersChanged();
+    
+    logInfo("添加圓柱體：中心(", center.x(), ", ", center.y(), ", ", center.z(),
+            ")，半徑 ", radius, "，高度 ", height);
+}
+
+SDFCollider* ClothSimulation::addSDFCollider(const std::vector<Vector3>& vertices, const std::vector<int>& indices,
+                                             float voxelSize, int bandVoxels) {
+    auto collider = std::make_unique<SDFCollider>(vertices, indices, voxelSize, bandVoxels, m_scheduler.get());
+    SDFCollider* result = m_colliders.addSDF(std::move(collider));
+    collidersChanged();
+    
+    logInfo("添加距離場碰撞體：", result->getSizeX(), "x", result->getSizeY(), "x", result->getSizeZ(),
+            " 個節點，", indices.size() / 3, " 個三角形");
+    return result;
+}
+
+void ClothSimulation::clearSDFColliders() {
+    if (m_colliders.getSDFs().empty()) return;
+    m_colliders.clearSDFs();
+    collidersChanged();
+}
+
+ColliderHandle ClothSimulation::addSphere(const RigidTransform& transform, float radius) {
+    ColliderHandle handle = m_colliders.addSphere(transform, radius);
+    collidersChanged();
+    return handle;
+}
+
+ColliderHandle ClothSimulation::addCapsule(const RigidTransform& transform, float halfHeight, float radius) {
+    ColliderHandle handle = m_colliders.addCapsule(transform, halfHeight, radius);
+    collidersChanged();
+    return handle;
+}
+
+ColliderHandle ClothSimulation::addBox(const RigidTransform& transform, const Vector3& halfExtents) {
+    ColliderHandle handle = m_colliders.addBox(transform, halfExtents);
+    collidersChanged();
+    return handle;
+}
+
+ColliderHandle ClothSimulation::addPlane(const RigidTransform& transform) {
+    ColliderHandle handle = m_colliders.addPlane(transform);
+    collidersChanged();
+    return handle;
+}
+
+void ClothSimulation::setColliderMotion(const ColliderHandle& handle, const ColliderMotion& motion) {
+    m_colliders.setMotion(handle, motion);
+    collidersChanged();
+}
+
+void ClothSimulation::setCylinderMotion(int index, const ColliderMotion& motion) {
+    if (index < 0 || index >= static_cast<int>(m_cylinders.size())) return;
+    m_cylinders[index]->motion = motion;
+    if (!motion.isAnimated()) {
+        m_cylinders[index]->velocity = ColliderVelocity();
+    }
+    collidersChanged();
+}
+
+void ClothSimulation::setColliderMaterial(const ColliderHandle& handle, const ColliderMaterial& material) {
+    m_colliders.setMaterial(handle, material);
+    wakeUp();
+}
+
+void ClothSimulation::setCylinderMaterial(int index, const ColliderMaterial& material) {
+    if (index < 0 || index >= static_cast<int>(m_cylinders.size())) return;
+    m_cylinders[index]->material = material;
+    wakeUp();
+}
+
+void ClothSimulation::updateColliderMotion(float time, float deltaTime) {
+    m_cylinderMotionBound = 0.0f;
+    bool moving = false;
+    
+    for (auto& cylinder : m_cylinders) {
+        if (!cylinder->motion.isAnimated()) continue;
+        
+        Vector3 center = cylinder->motion.evaluate(time).getTranslation();
+        m_cylinderMotionBound = std::max(m_cylinderMotionBound, static_cast<float>((center - cylinder->center).length()));
+        cylinder->center = center;
+        cylinder->velocity = cylinder->motion.velocity(time);
+        moving = moving || cylinder->velocity.linear.lengthSquared() > 0 || cylinder->velocity.angular.lengthSquared() > 0;
+    }
+    
+    if (m_colliders.isAnimated()) {
+        m_colliders.updateMotion(time, deltaTime);
+        moving = moving || m_colliders.isMoving();
+    }
+    
+    // 略過查詢時以碰撞體表面的累計移動量縮小記下的距離
+    m_colliderTravel += std::max(m_cylinderMotionBound, m_colliders.isAnimated() ? m_colliders.getMotionBound() : 0.0f);
+    
+    // 移動中的碰撞體可能碰到休眠的布料
+    if (moving || m_cylinderMotionBound > 0.0f) {
+        wakeUp();
+    }
+}
+
+void ClothSimulation::clearPrimitiveColliders() {
+    m_colliders.clearPrimitives();
+    collidersChanged();
+}
+
+MeshCollider* ClothSimulation::addMeshCollider(const std::vector<Vector3>& vertices, const std::vector<int>& indices,
+                                               float thickness) {
+    MeshCollider* result = m_colliders.addMesh(std::make_unique<MeshCollider>(vertices, indices, thickness));
+    collidersChanged();
+    
+    logInfo("添加網格碰撞體：", result->getTriangleCount(), " 個三角形，", result->getNodeCount(), " 個 BVH 節點");
+    return result;
+}
+
+void ClothSimulation::updateMeshCollider(MeshCollider* collider, const std::vector<Vector3>& vertices) {
+    if (!collider) return;
+    collider->refit(vertices);
+    collidersChanged();
+}
+
+void ClothSimulation::clearMeshColliders() {
+    if (m_colliders.getMeshes().empty()) return;
+    m_colliders.clearMeshes();
+    collidersChanged();
+}
+
+void ClothSimulation::setThreadCount(int threadCount) {
+    threadCount = std::max(1, threadCount);
+    if (threadCount == getThreadCount()) return;
+    
+    if (threadCount > 1) {
+        m_scheduler = std::make_shared<TaskScheduler>(threadCount);
+    } else {
+        m_scheduler.reset();
+    }
+    
+    logInfo("布料模擬執行緒數：", threadCount);
+}
+
+void ClothSimulation::buildStepGraph() {
+    m_stepGraph.clear();
+    m_stepGraphUsesOGC = m_useOGC;
+    m_stepGraphIntegrator = m_integrator;
+    
+    // 法線使用上一步結束時的位置，只讀位置、只寫法線，可與外力及接觸偵測同時進行；
+    // 之後第一個修改位置的階段（碰撞響應）必須等法線完成
+    TaskGraph::NodeId normals = m_stepGraph.addTask([this]() {
+        if (m_updateNormals) calculateNormals();
+    });
+    TaskGraph::NodeId forces = m_stepGraph.addTask([this]() { applyForces(); });
+    TaskGraph::NodeId collisions;
+    
+    if (m_useOGC) {
+        // OGC 的接觸偵測只讀取位置，可與外力同時進行；接觸響應需等外力完成
+        TaskGraph::NodeId detect = m_stepGraph.addTask([this]() { detectContacts(); });
+        collisions = m_stepGraph.addTask([this]() { resolveContacts(); });
+        m_stepGraph.addDependency(detect, collisions);
+        m_stepGraph.addDependency(forces, collisions);
+    } else {
+        // 基本碰撞同時讀寫速度，必須在外力之後
+        collisions = m_stepGraph.addTask([this]() { resolveBasicCollisions(); });
+        m_stepGraph.addDependency(forces, collisions);
+    }
+    m_stepGraph.addDependency(normals, collisions);
+    
+    // 積分與約束求解（或隱式求解）依序進行，內部各自平行化
+    TaskGraph::NodeId integration = m_stepGraph.addTask([this]() { integrate(m_stepDeltaTime); });
+    m_stepGraph.addDependency(collisions, integration);
+}
+
+std::uint64_t ClothSimulation::computeStateHash() const {
+    // FNV-1a，逐位元組處理位置與速度的原始位元
+    std::uint64_t hash = 14695981039346656037ull;
+    auto mix = [&hash](float value) {
+        std::uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        for (int i = 0; i < 4; ++i) {
+            hash ^= (bits >> (i * 8)) & 0xffu;
+            hash *= 1099511628211ull;
+        }
+    };
     
-    qDebug() << QString("添加圓柱體：中心(%1, %2, %3)，半徑 %4，高度 %5")
-                .arg(center.x()).arg(center.y()).arg(center.z())
-                .arg(radius).arg(height);
+    for (const auto& particle : m_particles) {
+        mix(particle->position.x());
+        mix(particle->position.y());
+        mix(particle->position.z());
+        mix(particle->velocity.x());
+        mix(particle->velocity.y());
+        mix(particle->velocity.z());
+    }
+    return hash;
+}
+
+float ClothSimulation::computeMaxStrain() const {
+    float maxStrain = 0.0f;
+    for (const auto& constraint : m_constraints) {
+        float restLength = constraint->getRestLength();
+        float length = (constraint->particle1->position - constraint->particle2->position).length();
+        if (!std::isfinite(length)) {
+            return std::numeric_limits<float>::infinity();
+        }
+        if (restLength > 0.0f) {
+            maxStrain = std::max(maxStrain, std::abs(length - restLength) / restLength);
+        }
+    }
+    return maxStrain;
 }
 
 void ClothSimulation::setOGCContactRadius(float radius) {
@@ -265,18 +886,22 @@ float ClothSimulation::getOGCContactRadius() const {
 }
 
 void ClothSimulation::createClothMesh() {
-    // 創建粒子網格
+    // 創建粒子網格（依列優先順序連續存放，預先配置使指標保持有效）
+    const int count = m_width * m_height;
+    m_particleStorage.reserve(count);
+    m_particles.reserve(count);
     for (int y = 0; y < m_height; ++y) {
         for (int x = 0; x < m_width; ++x) {
-            QVector3D pos(
+            Vector3 pos(
                 (x - m_width * 0.5f) * m_spacing,
                 2.0f,  // 起始高度
                 (y - m_height * 0.5f) * m_spacing
             );
             
-            auto particle = std::make_unique<ClothParticle>(pos);
-            particle->texCoord = QVector2D(float(x) / (m_width - 1), float(y) / (m_height - 1));
-            m_particles.push_back(std::move(particle));
+            m_particleStorage.emplace_back(pos);
+            ClothParticle& particle = m_particleStorage.back();
+            particle.texCoord = Vector2(float(x) / (m_width - 1), float(y) / (m_height - 1));
+            m_particles.push_back(&particle);
         }
     }
 }
@@ -332,320 +957,1593 @@ void ClothSimulation::createConstraints() {
     }
 }
 
-void ClothSimulation::applyForces() {
-    for (auto& particle : m_particles) {
-        // 重力
-        particle->addForce(m_gravity * particle->mass);
-        
-        // 風力
-        if (m_wind.length() > 0) {
-            particle->addForce(m_wind * particle->mass * 0.1f);
+void ClothSimulation::createMeshParticles() {
+    const auto& vertices = m_mesh.getVertices();
+    const auto& texCoords = m_mesh.getTexCoords();
+    
+    // 沒有紋理座標時以 XZ 包圍盒投影
+    Vector3 lower = vertices[0], upper = vertices[0];
+    for (const Vector3& vertex : vertices) {
+        for (int axis = 0; axis < 3; ++axis) {
+            lower[axis] = std::min(lower[axis], vertex[axis]);
+            upper[axis] = std::max(upper[axis], vertex[axis]);
         }
-        
-        // 阻尼
-        particle->velocity *= m_damping;
     }
-}
-
-void ClothSimulation::satisfyConstraints() {
-    for (auto& constraint : m_constraints) {
-        constraint->satisfy();
+    const float extentX = std::max(static_cast<float>(upper.x() - lower.x()), 1e-6f);
+    const float extentZ = std::max(static_cast<float>(upper.z() - lower.z()), 1e-6f);
+    
+    // 依頂點順序連續存放（匯入時以 ClothMesh::reorder() 決定空間局部性）
+    m_particleStorage.reserve(vertices.size());
+    m_particles.reserve(vertices.size());
+    for (size_t i = 0; i < vertices.size(); ++i) {
+        m_particleStorage.emplace_back(vertices[i]);
+        ClothParticle& particle = m_particleStorage.back();
+        if (m_mesh.hasTexCoords()) {
+            particle.texCoord = texCoords[i];
+        } else {
+            particle.texCoord = Vector2(static_cast<float>(vertices[i].x() - lower.x()) / extentX,
+                                        static_cast<float>(vertices[i].z() - lower.z()) / extentZ);
+        }
+        m_particles.push_back(&particle);
     }
 }
 
-void ClothSimulation::handleCollisions() {
-    if (m_cylinders.empty()) return;
+void ClothSimulation::createMeshConstraints() {
+    // 結構約束：每條三角形邊一個（依頂點索引排序，求解時依序存取粒子）
+    const auto edges = m_mesh.buildEdges();
+    for (const auto& edge : edges) {
+        m_constraints.push_back(std::make_unique<ClothConstraint>(m_particles[edge[0]], m_particles[edge[1]]));
+    }
     
-    if (m_useOGC) {
-        // OGC 模式
-        std::vector<OGCContactModel::ContactInfo> contacts;
-        
-        for (auto& particle : m_particles) {
-            for (auto& cylinder : m_cylinders) {
-                QVector3D contactPoint, contactNormal;
-                
-                if (cylinder->checkCollision(particle.get(), contactPoint, contactNormal)) {
-                    OGCContactModel::ContactInfo contact;
-                    contact.particle = particle.get();
-                    contact.contactPoint = contactPoint;
-                    contact.contactNormal = contactNormal;
-                    contact.penetrationDepth = (contactPoint - particle->position).length();
-                    contact.contactRadius = m_ogcModel->getContactRadius();
-                    
-                    contacts.push_back(contact);
-                }
-            }
-        }
-        
-        // 使用 OGC 模型處理接觸
-        if (!contacts.empty()) {
-            m_ogcModel->processContacts(contacts, m_timeStep);
-        }
-    } else {
-        // 基本碰撞處理模式
-        for (auto& particle : m_particles) {
-            if (particle->pinned) continue;
-            
-            for (auto& cylinder : m_cylinders) {
-                QVector3D contactPoint, contactNormal;
-                
-                if (cylinder->checkCollision(particle.get(), contactPoint, contactNormal)) {
-                    // 計算穿透深度
-                    QVector3D toParticle = particle->position - cylinder->center;
-                    float radialDist = sqrt(toParticle.x() * toParticle.x() + toParticle.z() * toParticle.z());
-                    float penetration = cylinder->radius - radialDist;
-                    
-                    // 位置修正
-                    particle->position += contactNormal * (penetration * 0.8f);
-                    
-                    // 速度修正（反彈）
-                    float normalVelocity = QVector3D::dotProduct(particle->velocity, contactNormal);
-                    if (normalVelocity < 0) {
-                        particle->velocity -= contactNormal * (normalVelocity * 1.2f); // 反彈係數
-                    }
-                    
-                    // 摩擦力
-                    QVector3D tangentVelocity = particle->velocity - contactNormal * normalVelocity;
-                    particle->velocity -= tangentVelocity * 0.1f; // 摩擦係數
-                }
-            }
+    // 彎曲約束：內部邊兩側三角形的對角頂點
+    // 每個三角形的三條邊記為 (較小索引, 較大索引, 對角頂點)，排序後相鄰的相同邊即為共用邊
+    std::vector<std::array<int, 3>> halfEdges;
+    halfEdges.reserve(m_mesh.getTriangleCount() * 3);
+    for (const auto& triangle : m_mesh.getTriangles()) {
+        for (int k = 0; k < 3; ++k) {
+            int a = triangle[k];
+            int b = triangle[(k + 1) % 3];
+            halfEdges.push_back({std::min(a, b), std::max(a, b), triangle[(k + 2) % 3]});
         }
     }
-}
-
-void ClothSimulation::updateParticles(float deltaTime) {
-    for (auto& particle : m_particles) {
-        particle->update(deltaTime);
+    std::sort(halfEdges.begin(), halfEdges.end());
+    
+    std::vector<std::array<int, 2>> bending;
+    for (size_t i = 0; i + 1 < halfEdges.size(); ++i) {
+        // 非流形邊（三個以上的三角形）依排序後的順序兩兩相連
+        const auto& first = halfEdges[i];
+        const auto& second = halfEdges[i + 1];
+        if (first[0] != second[0] || first[1] != second[1] || first[2] == second[2]) continue;
+        bending.push_back({std::min(first[2], second[2]), std::max(first[2], second[2])});
     }
-}
-
-ClothParticle* ClothSimulation::getParticle(int x, int y) {
-    if (x < 0 || x >= m_width || y < 0 || y >= m_height) {
-        return nullptr;
+    std::sort(bending.begin(), bending.end());
+    bending.erase(std::unique(bending.begin(), bending.end()), bending.end());
+    
+    for (const auto& pair : bending) {
+        // 已經是結構邊的頂點對（例如兩個三角形構成的四面體）不重複加入
+        if (std::binary_search(edges.begin(), edges.end(), pair)) continue;
+        m_constraints.push_back(std::make_unique<ClothConstraint>(m_particles[pair[0]], m_particles[pair[1]]));
     }
-    return m_particles[getParticleIndex(x, y)].get();
 }
 
-int ClothSimulation::getParticleIndex(int x, int y) const {
-    return y * m_width + x;
+void ClothSimulation::buildContactFeatures() {
+    // 三角形與法線計算相同（規則網格每個方塊兩個三角形）
+    m_triangles.clear();
+    if (m_meshCloth) {
+        m_triangles = m_mesh.getTriangles();
+    }
+    for (int y = 0; !m_meshCloth && y < m_height - 1; ++y) {
+        for (int x = 0; x < m_width - 1; ++x) {
+            int i1 = getParticleIndex(x, y);
+            int i2 = i1 + 1;
+            int i3 = i1 + m_width;
+            int i4 = i3 + 1;
+            m_triangles.push_back({i1, i2, i3});
+            m_triangles.push_back({i2, i4, i3});
+        }
+    }
+    
+    // 三角形的邊，每條只保留一次
+    m_featureEdges.clear();
+    for (const auto& face : m_triangles) {
+        for (int k = 0; k < 3; ++k) {
+            int a = face[k];
+            int b = face[(k + 1) % 3];
+            m_featureEdges.push_back({std::min(a, b), std::max(a, b)});
+        }
+    }
+    std::sort(m_featureEdges.begin(), m_featureEdges.end());
+    m_featureEdges.erase(std::unique(m_featureEdges.begin(), m_featureEdges.end()), m_featureEdges.end());
+    
+    m_maxFeatureEdge = 0.0f;
+    for (const auto& edge : m_featureEdges) {
+        float length = (m_particles[edge[0]]->position - m_particles[edge[1]]->position).length();
+        m_maxFeatureEdge = std::max(m_maxFeatureEdge, length);
+    }
+    
+    // 每個頂點相鄰的邊與面（CSR）
+    const int vertexCount = static_cast<int>(m_particles.size());
+    const int edgeCount = static_cast<int>(m_featureEdges.size());
+    m_vertexFeatureOffsets.assign(vertexCount + 1, 0);
+    for (const auto& edge : m_featureEdges) {
+        ++m_vertexFeatureOffsets[edge[0] + 1];
+        ++m_vertexFeatureOffsets[edge[1] + 1];
+    }
+    for (const auto& face : m_triangles) {
+        for (int vertex : face) {
+            ++m_vertexFeatureOffsets[vertex + 1];
+        }
+    }
+    for (int i = 0; i < vertexCount; ++i) {
+        m_vertexFeatureOffsets[i + 1] += m_vertexFeatureOffsets[i];
+    }
+    
+    m_vertexFeatures.resize(m_vertexFeatureOffsets[vertexCount]);
+    std::vector<int> cursor(m_vertexFeatureOffsets.begin(), m_vertexFeatureOffsets.end() - 1);
+    for (int e = 0; e < edgeCount; ++e) {
+        m_vertexFeatures[cursor[m_featureEdges[e][0]]++] = e;
+        m_vertexFeatures[cursor[m_featureEdges[e][1]]++] = e;
+    }
+    for (int f = 0; f < static_cast<int>(m_triangles.size()); ++f) {
+        for (int vertex : m_triangles[f]) {
+            m_vertexFeatures[cursor[vertex]++] = edgeCount + f;
+        }
+    }
+    
+    m_lastDisplacements.assign(vertexCount, 0.0f);
 }
 
-void ClothSimulation::calculateNormals() {
-    // 重置法線
-    for (auto& particle : m_particles) {
-        particle->normal = QVector3D(0, 0, 0);
+void ClothSimulation::applyForces() {
+    const bool hasWind = m_wind.length() > 0;
+    
+    // 每個粒子互不相依，依記憶體順序走訪
+    runParallel(static_cast<int>(m_particleStorage.size()), 256, [&](int begin, int end, int) {
+        for (int i = begin; i < end; ++i) {
+            ClothParticle* particle = &m_particleStorage[i];
+            if (particle->sleeping) continue;
+            
+            // 重力
+            particle->addForce(m_gravity * particle->mass);
+            
+            // 風力
+            if (hasWind) {
+                particle->addForce(m_wind * particle->mass * 0.1f);
+            }
+            
+            // 阻尼
+            particle->velocity *= m_damping;
+        }
+    });
+}
+
+void ClothSimulation::solveConstraints() {
+    // 先在粗層消除低頻誤差，細網格迭代只需處理高頻部分
+    if (m_hierarchicalSolver) {
+        solveHierarchy();
     }
     
-    // 計算面法線並累加到頂點
-    for (int y = 0; y < m_height - 1; ++y) {
-        for (int x = 0; x < m_width - 1; ++x) {
-            ClothParticle* p1 = getParticle(x, y);
-            ClothParticle* p2 = getParticle(x + 1, y);
-            ClothParticle* p3 = getParticle(x, y + 1);
-            ClothParticle* p4 = getParticle(x + 1, y + 1);
+    const bool accelerated = m_solverAcceleration != SolverAcceleration::None;
+    m_solverStats.accelerationResets = 0;
+    
+    if (!m_adaptiveIterations && !accelerated) {
+        for (int i = 0; i < m_stepIterations; ++i) {
+            satisfyConstraints(false, 1.0f);
+        }
+        m_solverStats.iterations = m_stepIterations;
+        return;
+    }
+    
+    // 殘差在迭代中順便量測（投影前的應變），不需要額外掃描；
+    // 提早結束與發散判斷只依最大值，與加總順序無關，因此不影響確定性
+    int maxIterations = m_stepIterations;
+    int minIterations = m_stepIterations;
+    if (m_adaptiveIterations) {
+        maxIterations = std::max(1, m_stepIterations);
+        minIterations = std::min(std::max(1, m_minConstraintIterations), maxIterations);
+    }
+    
+    const bool chebyshev = m_solverAcceleration == SolverAcceleration::Chebyshev;
+    float relaxation = m_solverAcceleration == SolverAcceleration::SOR ? m_relaxationFactor : 1.0f;
+    int chebyshevStep = 0;
+    float chebyshevOmega = 1.0f;
+    float previousResidual = std::numeric_limits<float>::max();
+    
+    int iterations = 0;
+    while (iterations < maxIterations) {
+        if (chebyshev) {
+            storeIterate(m_iterateCurrent);
+        }
+        
+        satisfyConstraints(true, relaxation);
+        ++iterations;
+        
+        const float residual = m_solverStats.maxResidual;
+        const bool diverging = accelerated && m_solverStats.rmsResidual > previousResidual * kDivergenceFactor;
+        previousResidual = m_solverStats.rmsResidual;
+        
+        if (diverging) {
+            // SOR 在這一步剩餘的迭代退回一般投影，Chebyshev 重新開始序列
+            ++m_solverStats.accelerationResets;
+            relaxation = 1.0f;
+            chebyshevStep = 0;
+        }
+        
+        if (chebyshev) {
+            // ω_1 = 1, ω_2 = 2 / (2 - ρ²), ω_k = 4 / (4 - ρ² ω_{k-1})
+            ++chebyshevStep;
+            const float rhoSq = m_spectralRadius * m_spectralRadius;
+            if (chebyshevStep == 1) {
+                chebyshevOmega = 1.0f;
+            } else if (chebyshevStep == 2) {
+                chebyshevOmega = 2.0f / (2.0f - rhoSq);
+            } else {
+                chebyshevOmega = 4.0f / (4.0f - rhoSq * chebyshevOmega);
+            }
             
-            if (p1 && p2 && p3 && p4) {
-                // 第一個三角形
-                QVector3D v1 = p2->position - p1->position;
-                QVector3D v2 = p3->position - p1->position;
-                QVector3D normal1 = QVector3D::crossProduct(v1, v2).normalized();
-                
-                p1->normal += normal1;
-                p2->normal += normal1;
-                p3->normal += normal1;
-                
-                // 第二個三角形
-                QVector3D v3 = p4->position - p2->position;
-                QVector3D v4 = p3->position - p2->position;
-                QVector3D normal2 = QVector3D::crossProduct(v3, v4).normalized();
-                
-                p2->normal += normal2;
-                p3->normal += normal2;
-                p4->normal += normal2;
+            if (chebyshevStep >= 2) {
+                extrapolateIterate(chebyshevOmega);
             }
+            std::swap(m_iteratePrevious, m_iterateCurrent);
+        }
+        
+        if (m_adaptiveIterations && iterations >= minIterations && residual < m_solverTolerance) {
+            break;
         }
     }
+    m_solverStats.iterations = iterations;
+}
+
+void ClothSimulation::setHierarchicalSolver(bool enable) {
+    m_hierarchicalSolver = enable;
+    buildHierarchy();
+}
+
+void ClothSimulation::setHierarchyLevels(int levels) {
+    m_hierarchyLevels = std::max(1, levels);
+    buildHierarchy();
+}
+
+void ClothSimulation::buildHierarchy() {
+    m_hierarchy.clear();
+    // 粗層以規則網格的列與行取樣，匯入的網格沒有對應的結構
+    if (!m_hierarchicalSolver || m_particles.empty() || m_meshCloth) return;
     
-    // 正規化法線
-    for (auto& particle : m_particles) {
-        if (particle->normal.length() > 0) {
-            particle->normal.normalize();
+    // 以步距取樣一個維度，並確保包含最後一列／行
+    auto sample = [](int size, int stride) {
+        std::vector<int> samples;
+        for (int i = 0; i < size; i += stride) {
+            samples.push_back(i);
+        }
+        if (samples.back() != size - 1) {
+            samples.push_back(size - 1);
+        }
+        return samples;
+    };
+    
+    // 細網格座標到取樣區間的對應與線性權重
+    auto mapCells = [](const std::vector<int>& samples, int size, std::vector<int>& cells, std::vector<float>& weights) {
+        cells.resize(size);
+        weights.resize(size);
+        int cell = 0;
+        for (int i = 0; i < size; ++i) {
+            while (cell + 2 < static_cast<int>(samples.size()) && i >= samples[cell + 1]) {
+                ++cell;
+            }
+            cells[i] = cell;
+            weights[i] = float(i - samples[cell]) / float(samples[cell + 1] - samples[cell]);
+        }
+    };
+    
+    for (int levelIndex = 1; levelIndex <= m_hierarchyLevels; ++levelIndex) {
+        const int stride = 1 << levelIndex;
+        HierarchyLevel level;
+        level.columns = sample(m_width, stride);
+        level.rows = sample(m_height, stride);
+        
+        // 粗層至少需要 3x3 個節點才有彎曲約束
+        const int columns = static_cast<int>(level.columns.size());
+        const int rows = static_cast<int>(level.rows.size());
+        if (columns < 3 || rows < 3) break;
+        
+        level.fineIndex.resize(columns * rows);
+        for (int r = 0; r < rows; ++r) {
+            for (int c = 0; c < columns; ++c) {
+                level.fineIndex[r * columns + c] = getParticleIndex(level.columns[c], level.rows[r]);
+            }
+        }
+        level.positions.resize(level.fineIndex.size());
+        level.displacements.resize(level.fineIndex.size());
+        level.fixed.resize(level.fineIndex.size());
+        
+        // 與細網格相同的約束拓撲；靜止長度由規則網格的座標差決定
+        auto addConstraint = [&](int c1, int r1, int c2, int r2) {
+            float dx = float(level.columns[c2] - level.columns[c1]);
+            float dy = float(level.rows[r2] - level.rows[r1]);
+            level.constraints.push_back({r1 * columns + c1, r2 * columns + c2,
+                                         m_spacing * std::sqrt(dx * dx + dy * dy)});
+        };
+        
+        for (int r = 0; r < rows; ++r) {
+            for (int c = 0; c < columns; ++c) {
+                if (c + 1 < columns) addConstraint(c, r, c + 1, r);
+                if (r + 1 < rows) addConstraint(c, r, c, r + 1);
+                if (c + 1 < columns && r + 1 < rows) {
+                    addConstraint(c, r, c + 1, r + 1);
+                    addConstraint(c + 1, r, c, r + 1);
+                }
+                if (c + 2 < columns) addConstraint(c, r, c + 2, r);
+                if (r + 2 < rows) addConstraint(c, r, c, r + 2);
+            }
+        }
+        
+        mapCells(level.columns, m_width, level.cellX, level.weightX);
+        mapCells(level.rows, m_height, level.cellY, level.weightY);
+        
+        m_hierarchy.push_back(std::move(level));
+    }
+}
+
+void ClothSimulation::solveHierarchy() {
+    // 由最粗層往細層：每層從目前的細網格位置取樣，求解後把位移延拓回細網格
+    for (auto level = m_hierarchy.rbegin(); level != m_hierarchy.rend(); ++level) {
+        solveHierarchyLevel(*level);
+    }
+}
+
+void ClothSimulation::solveHierarchyLevel(HierarchyLevel& level) {
+    const int nodeCount = static_cast<int>(level.fineIndex.size());
+    for (int node = 0; node < nodeCount; ++node) {
+        const ClothParticle* particle = m_particles[level.fineIndex[node]];
+        level.positions[node] = particle->position;
+        level.displacements[node] = particle->position;
+        level.fixed[node] = particle->pinned || particle->sleeping;
+    }
+    
+    // 粗層規模只有細網格的 1/4^l，序列 Gauss-Seidel 即可
+    for (int iteration = 0; iteration < m_coarseIterations; ++iteration) {
+        for (const auto& constraint : level.constraints) {
+            const bool movable1 = !level.fixed[constraint.node1];
+            const bool movable2 = !level.fixed[constraint.node2];
+            if (!movable1 && !movable2) continue;
+            
+            Vector3& p1 = level.positions[constraint.node1];
+            Vector3& p2 = level.positions[constraint.node2];
+            Vector3 delta = p2 - p1;
+            float currentLength = delta.length();
+            if (currentLength < 1e-6f) continue;
+            
+            Vector3 correction = delta * ((currentLength - constraint.restLength) / currentLength * 0.5f * kHierarchyStiffness);
+            if (movable1) p1 += correction;
+            if (movable2) p2 -= correction;
+        }
+    }
+    
+    for (int node = 0; node < nodeCount; ++node) {
+        level.displacements[node] = level.positions[node] - level.displacements[node];
+    }
+    
+    // 雙線性延拓位移
+    const int columns = static_cast<int>(level.columns.size());
+    runParallel(static_cast<int>(m_particles.size()), 1024, [&](int begin, int end, int) {
+        for (int i = begin; i < end; ++i) {
+            ClothParticle* particle = m_particles[i];
+            if (particle->pinned || particle->sleeping) continue;
+            
+            const int x = i % m_width;
+            const int y = i / m_width;
+            const int node = level.cellY[y] * columns + level.cellX[x];
+            const float wx = level.weightX[x];
+            const float wy = level.weightY[y];
+            
+            Vector3 top = level.displacements[node] * (1.0f - wx) + level.displacements[node + 1] * wx;
+            Vector3 bottom = level.displacements[node + columns] * (1.0f - wx) + level.displacements[node + columns + 1] * wx;
+            particle->position += top * (1.0f - wy) + bottom * wy;
+        }
+    });
+}
+
+void ClothSimulation::storeIterate(std::vector<Vector3>& iterate) {
+    iterate.resize(m_particles.size());
+    runParallel(static_cast<int>(m_particles.size()), 1024, [&](int begin, int end, int) {
+        for (int i = begin; i < end; ++i) {
+            iterate[i] = m_particles[i]->position;
+        }
+    });
+}
+
+void ClothSimulation::extrapolateIterate(float omega) {
+    // x_{k+1} = ω (x̂_{k+1} - x_{k-1}) + x_{k-1}；固定與休眠粒子的三個位置相同，不受影響
+    runParallel(static_cast<int>(m_particles.size()), 1024, [&](int begin, int end, int) {
+        for (int i = begin; i < end; ++i) {
+            ClothParticle* particle = m_particles[i];
+            if (particle->pinned || particle->sleeping) continue;
+            particle->position = m_iteratePrevious[i] + (particle->position - m_iteratePrevious[i]) * omega;
+        }
+    });
+}
+
+namespace {
+// 以特化核心求解一段約束，Measure 時累積殘差；迴圈內沒有依固定狀態或阻尼的分支
+template <bool Movable1, bool Movable2, bool Damped, bool CheckSleep, bool Measure, typename Pointer>
+void projectRange(const Pointer* constraints, int begin, int end, float relaxation,
+                  float& maxStrain, double& sumSquares) {
+    for (int i = begin; i < end; ++i) {
+        float strain = constraints[i]->template project<Movable1, Movable2, Damped, CheckSleep>(relaxation);
+        if (Measure) {
+            maxStrain = std::max(maxStrain, strain);
+            sumSquares += double(strain) * strain;
+        }
+    }
+}
+
+template <typename Pointer>
+using ProjectRangeFunction = void (*)(const Pointer*, int, int, float, float&, double&);
+
+template <typename Pointer, bool CheckSleep, bool Measure, int... Kernels>
+constexpr std::array<ProjectRangeFunction<Pointer>, sizeof...(Kernels)>
+makeKernelTable(std::integer_sequence<int, Kernels...>) {
+    return {{&projectRange<(Kernels & 1) != 0, (Kernels & 2) != 0, (Kernels & 4) != 0, CheckSleep, Measure, Pointer>...}};
+}
+
+// 核心編號：位元 0、1 為兩端可移動，位元 2 為有阻尼；不量測殘差時省去每個約束的應變累積
+template <typename Pointer>
+ProjectRangeFunction<Pointer> selectKernel(int kernel, bool checkSleep, bool measure) {
+    static constexpr auto awake = makeKernelTable<Pointer, false, false>(std::make_integer_sequence<int, 8>());
+    static constexpr auto sleeping = makeKernelTable<Pointer, true, false>(std::make_integer_sequence<int, 8>());
+    static constexpr auto awakeMeasured = makeKernelTable<Pointer, false, true>(std::make_integer_sequence<int, 8>());
+    static constexpr auto sleepingMeasured = makeKernelTable<Pointer, true, true>(std::make_integer_sequence<int, 8>());
+    if (measure) {
+        return checkSleep ? sleepingMeasured[kernel] : awakeMeasured[kernel];
+    }
+    return checkSleep ? sleeping[kernel] : awake[kernel];
+}
+
+int constraintKernel(const ClothConstraint& constraint) {
+    return (constraint.particle1->pinned ? 0 : 1)
+         | (constraint.particle2->pinned ? 0 : 2)
+         | (constraint.getDamping() != 0.0f ? 4 : 0);
+}
+}
+
+void ClothSimulation::satisfyConstraints(bool measureResidual, float relaxation) {
+    const int slotCount = m_scheduler ? m_scheduler->getThreadCount() : 1;
+    if (measureResidual) {
+        m_slotResiduals.assign(slotCount, SlotResidual{0.0f, 0.0});
+    }
+    
+    if (!m_scheduler) {
+        float maxStrain = 0.0f;
+        double sumSquares = 0.0;
+        if (m_specializedKernels) {
+            // 區段保留原始順序，Gauss-Seidel 的結果與通用路徑相同
+            for (const ConstraintRun& run : m_serialRuns) {
+                selectKernel<std::unique_ptr<ClothConstraint>>(run.kernel, m_sleepingEnabled, measureResidual)(
+                    m_constraints.data(), run.begin, run.end, relaxation, maxStrain, sumSquares);
+            }
         } else {
-            particle->normal = QVector3D(0, 1, 0);
+            for (auto& constraint : m_constraints) {
+                float strain = constraint->satisfy(relaxation);
+                maxStrain = std::max(maxStrain, strain);
+                sumSquares += double(strain) * strain;
+            }
+        }
+        if (measureResidual) {
+            m_slotResiduals[0] = SlotResidual{maxStrain, sumSquares};
         }
+    } else {
+        // 依著色批次求解：同一批次內的約束不共用粒子，可平行處理且結果與執行順序無關
+        for (size_t batch = 0; batch + 1 < m_batchOffsets.size(); ++batch) {
+            ClothConstraint* const* constraints = m_batchedConstraints.data() + m_batchOffsets[batch];
+            int count = m_batchOffsets[batch + 1] - m_batchOffsets[batch];
+            
+            const ConstraintRun* runs = m_batchRuns.data() + m_batchRunOffsets[batch];
+            const ConstraintRun* runsEnd = m_batchRuns.data() + m_batchRunOffsets[batch + 1];
+            
+            auto solveRange = [this, constraints, runs, runsEnd, measureResidual, relaxation](int begin, int end, int slot) {
+                float maxStrain = 0.0f;
+                double sumSquares = 0.0;
+                if (m_specializedKernels) {
+                    // 分塊可能跨越數個核心區段，逐段以對應的核心求解
+                    for (const ConstraintRun* run = runs; run != runsEnd && run->begin < end; ++run) {
+                        int runBegin = std::max(begin, run->begin);
+                        int runEnd = std::min(end, run->end);
+                        if (runBegin < runEnd) {
+                            selectKernel<ClothConstraint*>(run->kernel, m_sleepingEnabled, measureResidual)(
+                                constraints, runBegin, runEnd, relaxation, maxStrain, sumSquares);
+                        }
+                    }
+                } else {
+                    for (int i = begin; i < end; ++i) {
+                        float strain = constraints[i]->satisfy(relaxation);
+                        maxStrain = std::max(maxStrain, strain);
+                        sumSquares += double(strain) * strain;
+                    }
+                }
+                if (measureResidual) {
+                    SlotResidual& residual = m_slotResiduals[slot];
+                    residual.maxStrain = std::max(residual.maxStrain, maxStrain);
+                    residual.sumSquares += sumSquares;
+                }
+            };
+            
+            if (static_cast<int>(batch) == kSerialBatchColor) {
+                solveRange(0, count, 0);
+                continue;
+            }
+            
+            runParallel(count, 128, solveRange);
+        }
+    }
+    
+    if (measureResidual) {
+        // 依槽位順序合併
+        float maxStrain = 0.0f;
+        double sumSquares = 0.0;
+        for (const SlotResidual& residual : m_slotResiduals) {
+            maxStrain = std::max(maxStrain, residual.maxStrain);
+            sumSquares += residual.sumSquares;
+        }
+        m_solverStats.maxResidual = maxStrain;
+        m_solverStats.rmsResidual = m_constraints.empty()
+            ? 0.0f : static_cast<float>(std::sqrt(sumSquares / m_constraints.size()));
     }
 }
 
-void ClothSimulation::render() {
-    if (m_particles.empty()) return;
+void ClothSimulation::buildConstraintBatches() {
+    m_batchedConstraints.clear();
+    m_batchOffsets.clear();
     
-    if (m_renderDataDirty) {
-        setupRenderData();
-        m_renderDataDirty = false;
+    std::unordered_map<const ClothParticle*, int> particleIndex;
+    particleIndex.reserve(m_particles.size());
+    for (size_t i = 0; i < m_particles.size(); ++i) {
+        particleIndex[m_particles[i]] = static_cast<int>(i);
     }
     
-    // 更新法線
-    calculateNormals();
+    // 貪婪著色：每個粒子記錄已被哪些顏色使用，約束取兩端粒子都未使用的最小顏色
+    // 規則網格每個粒子最多 12 個約束，顏色數遠低於上限；
+    // 超出上限的約束放進最後一個批次，該批次改為序列求解
+    std::vector<std::uint64_t> usedColors(m_particles.size(), 0);
+    std::vector<int> colors(m_constraints.size(), 0);
+    int colorCount = 0;
     
-    // 使用基本 OpenGL 立即模式渲染布料
-    glPushMatrix();
+    for (size_t c = 0; c < m_constraints.size(); ++c) {
+        int i1 = particleIndex[m_constraints[c]->particle1];
+        int i2 = particleIndex[m_constraints[c]->particle2];
+        std::uint64_t used = usedColors[i1] | usedColors[i2];
+        
+        int color = 0;
+        while (color < kSerialBatchColor && (used & (1ull << color))) {
+            ++color;
+        }
+        
+        colors[c] = color;
+        if (color < kSerialBatchColor) {
+            usedColors[i1] |= 1ull << color;
+            usedColors[i2] |= 1ull << color;
+        }
+        colorCount = std::max(colorCount, color + 1);
+    }
     
-    // 停用光照以簡化渲染
-    glDisable(GL_LIGHTING);
+    // 依顏色做穩定的計數排序，保留每個批次內的原始順序
+    m_batchOffsets.assign(colorCount + 1, 0);
+    for (int color : colors) {
+        ++m_batchOffsets[color + 1];
+    }
+    for (int color = 0; color < colorCount; ++color) {
+        m_batchOffsets[color + 1] += m_batchOffsets[color];
+    }
     
-    // 1. 渲染布料粒子
-    glColor3f(1.0f, 0.2f, 0.2f);  // 紅色粒子
-    glPointSize(4.0f);
-    glBegin(GL_POINTS);
-    for (const auto& particle : m_particles) {
-        if (particle) {
-            glVertex3f(particle->position.x(), particle->position.y(), particle->position.z());
+    m_batchedConstraints.resize(m_constraints.size());
+    std::vector<int> cursor(m_batchOffsets.begin(), m_batchOffsets.end() - 1);
+    for (size_t c = 0; c < m_constraints.size(); ++c) {
+        m_batchedConstraints[cursor[colors[c]]++] = m_constraints[c].get();
+    }
+}
+
+void ClothSimulation::buildConstraintKernels() {
+    // 序列路徑：原始順序中相同核心的連續區段
+    m_serialRuns.clear();
+    for (int c = 0; c < static_cast<int>(m_constraints.size()); ++c) {
+        int kernel = constraintKernel(*m_constraints[c]);
+        if (m_serialRuns.empty() || m_serialRuns.back().kernel != kernel) {
+            m_serialRuns.push_back({kernel, c, c});
         }
+        m_serialRuns.back().end = c + 1;
     }
-    glEnd();
     
-    // 2. 渲染約束線（布料結構）
-    glColor3f(0.4f, 0.4f, 0.8f);  // 藍色連接線
-    glLineWidth(1.0f);
-    glBegin(GL_LINES);
-    for (const auto& constraint : m_constraints) {
-        if (constraint && constraint->particle1 && constraint->particle2) {
-            glVertex3f(constraint->particle1->position.x(), constraint->particle1->position.y(), constraint->particle1->position.z());
-            glVertex3f(constraint->particle2->position.x(), constraint->particle2->position.y(), constraint->particle2->position.z());
+    // 平行路徑：同一批次的約束互不共用粒子，批次內依核心重新排序不影響結果
+    m_batchRuns.clear();
+    m_batchRunOffsets.assign(1, 0);
+    for (size_t batch = 0; batch + 1 < m_batchOffsets.size(); ++batch) {
+        auto first = m_batchedConstraints.begin() + m_batchOffsets[batch];
+        auto last = m_batchedConstraints.begin() + m_batchOffsets[batch + 1];
+        
+        // 序列批次內的約束可能共用粒子，保留原始順序
+        if (static_cast<int>(batch) != kSerialBatchColor) {
+            std::stable_sort(first, last, [](const ClothConstraint* a, const ClothConstraint* b) {
+                return constraintKernel(*a) < constraintKernel(*b);
+            });
         }
+        
+        const int batchBegin = m_batchOffsets[batch];
+        for (auto it = first; it != last; ++it) {
+            int index = static_cast<int>(it - m_batchedConstraints.begin()) - batchBegin;
+            int kernel = constraintKernel(**it);
+            if (static_cast<int>(m_batchRuns.size()) == m_batchRunOffsets.back() || m_batchRuns.back().kernel != kernel) {
+                m_batchRuns.push_back({kernel, index, index});
+            }
+            m_batchRuns.back().end = index + 1;
+        }
+        m_batchRunOffsets.push_back(static_cast<int>(m_batchRuns.size()));
     }
-    glEnd();
+}
+
+void ClothSimulation::runParallel(int count, int grainSize, const TaskScheduler::RangeFunction& fn) {
+    Physics::runParallel(m_scheduler.get(), m_deterministic, count, grainSize, fn);
+}
+
+template <typename Callback>
+void ClothSimulation::forEachColliderContact(int begin, int end, Callback&& callback) const {
+    if (m_colliders.empty()) return;
     
-    // 3. 渲染布料表面（半透明）
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-    glColor4f(0.2f, 0.8f, 0.6f, 0.6f);  // 半透明綠色布料
+    // 以固定大小的區塊收集位置，碰撞體集合對整個區塊做批次查詢
+    constexpr int kBlock = 64;
+    Vector3 positions[kBlock];
+    thread_local std::vector<ColliderContact> contacts;
     
-    glBegin(GL_TRIANGLES);
-    for (int y = 0; y < m_height - 1; ++y) {
-        for (int x = 0; x < m_width - 1; ++x) {
-            ClothParticle* p1 = getParticle(x, y);
-            ClothParticle* p2 = getParticle(x + 1, y);
-            ClothParticle* p3 = getParticle(x, y + 1);
-            ClothParticle* p4 = getParticle(x + 1, y + 1);
+    for (int blockBegin = begin; blockBegin < end; blockBegin += kBlock) {
+        const int count = std::min(kBlock, end - blockBegin);
+        for (int i = 0; i < count; ++i) {
+            positions[i] = m_particles[blockBegin + i]->position;
+        }
+        
+        contacts.clear();
+        m_colliders.collide(positions, count, contacts);
+        for (const ColliderContact& contact : contacts) {
+            ClothParticle* particle = m_particles[blockBegin + contact.index];
+            if (!particle->sleeping) {
+                callback(particle, contact);
+            }
+        }
+    }
+}
+
+void ClothSimulation::handleCollisions() {
+    if (m_useOGC) {
+        detectContacts();
+        resolveContacts();
+    } else {
+        resolveBasicCollisions();
+    }
+}
+
+void ClothSimulation::detectContacts() {
+    m_contacts.clear();
+    m_queryStats = CollisionQueryStats();
+    if (m_cylinders.empty() && m_colliders.empty()) return;
+    
+    // 每個槽位收集自己的接觸，最後依槽位順序合併
+    const int slotCount = getThreadCount();
+    m_slotContacts.resize(slotCount);
+    for (auto& slot : m_slotContacts) {
+        slot.clear();
+    }
+    
+    if (m_offsetContacts) {
+        detectOffsetContacts();
+        return;
+    }
+    
+    const float contactRadius = m_ogcModel->getContactRadius();
+    
+    runParallel(static_cast<int>(m_particles.size()), 128, [&](int begin, int end, int slot) {
+        auto& contacts = m_slotContacts[slot];
+        
+        for (int i = begin; i < end; ++i) {
+            ClothParticle* particle = m_particles[i];
+            if (particle->sleeping) continue;
             
-            if (p1 && p2 && p3 && p4) {
-                // 第一個三角形 (p1, p2, p3)
-                glVertex3f(p1->position.x(), p1->position.y(), p1->position.z());
-                glVertex3f(p2->position.x(), p2->position.y(), p2->position.z());
-                glVertex3f(p3->position.x(), p3->position.y(), p3->position.z());
+            for (auto& cylinder : m_cylinders) {
+                Vector3 contactPoint, contactNormal;
                 
-                // 第二個三角形 (p2, p4, p3)
-                glVertex3f(p2->position.x(), p2->position.y(), p2->position.z());
-                glVertex3f(p4->position.x(), p4->position.y(), p4->position.z());
-                glVertex3f(p3->position.x(), p3->position.y(), p3->position.z());
+                if (cylinder->checkCollision(particle, contactPoint, contactNormal)) {
+                    OGCContactModel::ContactInfo contact;
+                    contact.particle = particle;
+                    contact.contactPoint = contactPoint;
+                    contact.contactNormal = contactNormal;
+                    contact.penetrationDepth = (contactPoint - particle->position).length();
+                    contact.contactRadius = contactRadius;
+                    contact.colliderVelocity = cylinder->velocity.at(contactPoint);
+                    contact.material = cylinder->material;
+                    
+                    contacts.push_back(contact);
+                }
             }
         }
+        
+        // 解析形狀、距離場與網格碰撞體以區塊批次查詢
+        forEachColliderContact(begin, end, [&](ClothParticle* particle, const ColliderContact& hit) {
+            OGCContactModel::ContactInfo contact;
+            contact.particle = particle;
+            contact.contactPoint = hit.point;
+            contact.contactNormal = hit.normal;
+            contact.penetrationDepth = hit.depth;
+            contact.contactRadius = contactRadius;
+            contact.colliderVelocity = hit.velocity;
+            contact.material = hit.material;
+            
+            contacts.push_back(contact);
+        });
+    });
+    
+    for (auto& slot : m_slotContacts) {
+        m_contacts.insert(m_contacts.end(), slot.begin(), slot.end());
+    }
+}
+
+void ClothSimulation::detectOffsetContacts() {
+    const int vertexCount = static_cast<int>(m_particles.size());
+    const int edgeCount = static_cast<int>(m_featureEdges.size());
+    const int faceCount = static_cast<int>(m_triangles.size());
+    const float contactRadius = m_ogcModel->getContactRadius();
+    const float minimumDepth = contactRadius * kFeatureDepthFraction;
+    
+    m_vertexDistances.resize(vertexCount);
+    m_vertexNormals.resize(vertexCount);
+    m_featureDistances.resize(edgeCount + faceCount);
+    m_displacementBounds.resize(vertexCount);
+    m_featureLimited.resize(vertexCount);
+    if (static_cast<int>(m_lastDisplacements.size()) != vertexCount) {
+        m_lastDisplacements.assign(vertexCount, 0.0f);
+    }
+    
+    // 每個階段結束時依槽位順序合併：頂點接觸在前，其次是邊，最後是面
+    auto mergeSlots = [this]() {
+        for (auto& slot : m_slotContacts) {
+            m_contacts.insert(m_contacts.end(), slot.begin(), slot.end());
+            slot.clear();
+        }
+    };
+    
+    const bool skipping = m_querySkipping && m_queryCacheValid && static_cast<int>(m_queryAnchors.size()) == vertexCount;
+    if (!skipping) {
+        m_queryAnchors.resize(vertexCount);
+        m_queryDistances.resize(vertexCount);
+        m_queryTravel.resize(vertexCount);
     }
-    glEnd();
+    m_slotQueryCounts.assign(getThreadCount(), 0);
+    m_slotSkipCounts.assign(getThreadCount(), 0);
     
-    glDisable(GL_BLEND);
-    glPopMatrix();
+    // 頂點：到碰撞體的距離小於 r 即接觸
+    runParallel(vertexCount, 128, [&](int begin, int end, int slot) {
+        auto& contacts = m_slotContacts[slot];
+        
+        for (int i = begin; i < end; ++i) {
+            ClothParticle* particle = m_particles[i];
+            
+            // 查詢範圍涵蓋上一步位移的兩倍（再除以 γ），一般的運動不會被界限截斷
+            const float reach = contactRadius + m_maxFeatureEdge + 2.0f * m_lastDisplacements[i] / kBoundRelaxation;
+            
+            // 上一次查詢的距離扣掉之後頂點與碰撞體的移動量仍不小於範圍：這次查詢的結果必定是範圍上限
+            if (skipping) {
+                const float moved = static_cast<float>((particle->position - m_queryAnchors[i]).length()) +
+                                    (m_colliderTravel - m_queryTravel[i]);
+                if (m_queryDistances[i] - moved >= reach) {
+                    m_vertexDistances[i] = reach;
+                    m_vertexNormals[i] = Vector3(0, 0, 0);
+                    ++m_slotSkipCounts[slot];
+                    continue;
+                }
+            }
+            
+            // 查詢上限放寬為範圍的兩倍，之後的步驟才有餘裕略過查詢；超過範圍的結果仍以範圍上限記錄
+            Vector3 normal(0, 0, 0), velocity;
+            ColliderMaterial material;
+            const float queried = colliderDistance(particle->position, kQuerySlack * reach, normal, velocity, &material);
+            m_queryAnchors[i] = particle->position;
+            m_queryDistances[i] = queried;
+            m_queryTravel[i] = m_colliderTravel;
+            ++m_slotQueryCounts[slot];
+            
+            const float distance = std::min(queried, reach);
+            m_vertexDistances[i] = distance;
+            m_vertexNormals[i] = distance < reach ? normal : Vector3(0, 0, 0);
+            if (distance >= contactRadius || particle->sleeping) continue;
+            
+            OGCContactModel::ContactInfo contact;
+            contact.particle = particle;
+            contact.contactPoint = particle->position - normal * distance;
+            contact.contactNormal = normal;
+            contact.penetrationDepth = contactRadius - distance;
+            contact.contactRadius = contactRadius;
+            contact.colliderVelocity = velocity;
+            contact.material = material;
+            contact.particles[0] = particle;
+            
+            contacts.push_back(contact);
+        }
+    });
+    mergeSlots();
+    m_queryCacheValid = m_querySkipping;
+    for (int slot = 0; slot < getThreadCount(); ++slot) {
+        m_queryStats.queries += m_slotQueryCounts[slot];
+        m_queryStats.skipped += m_slotSkipCounts[slot];
+    }
     
-    qDebug() << "ClothSimulation::render() - 渲染了" << m_particles.size() << "個粒子";
+    // 邊：碰撞體的細部卡在兩個頂點之間時，邊的內部比兩端更靠近碰撞體
+    runParallel(edgeCount, 256, [&](int begin, int end, int slot) {
+        auto& contacts = m_slotContacts[slot];
+        
+        for (int e = begin; e < end; ++e) {
+            ClothParticle* pa = m_particles[m_featureEdges[e][0]];
+            ClothParticle* pb = m_particles[m_featureEdges[e][1]];
+            const float da = m_vertexDistances[m_featureEdges[e][0]];
+            const float db = m_vertexDistances[m_featureEdges[e][1]];
+            const Vector3 edge = pb->position - pa->position;
+            const float length = static_cast<float>(edge.length());
+            
+            // 距離函數是 1-Lipschitz，邊上任一點的距離不小於 (da + db - L) / 2
+            const float lowerBound = 0.5f * (da + db - length);
+            if (lowerBound >= contactRadius) {
+                m_featureDistances[e] = lowerBound;
+                continue;
+            }
+            
+            // 以兩端法線沿邊的分量（距離的方向導數）內插出導數為零的位置，
+            // 再把碰撞體上的最近點投影回邊上修正幾次
+            float t = 0.5f;
+            const float slopeA = static_cast<float>(Vector3::dotProduct(m_vertexNormals[m_featureEdges[e][0]], edge));
+            const float slopeB = static_cast<float>(Vector3::dotProduct(m_vertexNormals[m_featureEdges[e][1]], edge));
+            if (slopeA < 0.0f && slopeB > 0.0f) {
+                t = slopeA / (slopeA - slopeB);
+            }
+            
+            const float queryLimit = std::max(da, db) + length;
+            const float lengthSquared = length * length;
+            const float nearestEnd = std::min(da, db);
+            Vector3 point, normal, velocity;
+            ColliderMaterial material;
+            float distance = queryLimit;
+            float estimate = nearestEnd;
+            float next = t;
+            for (int iteration = 0; iteration < kFeatureProjectionIterations; ++iteration) {
+                t = next;
+                point = pa->position + edge * t;
+                distance = colliderDistance(point, queryLimit, normal, velocity, &material);
+                estimate = std::min(estimate, distance);
+                if (distance >= queryLimit || lengthSquared <= 0.0f) break;
+                
+                const Vector3 surface = point - normal * distance;
+                const float projected = static_cast<float>(Vector3::dotProduct(surface - pa->position, edge)) / lengthSquared;
+                next = std::min(std::max(projected, 0.0f), 1.0f);
+                if (std::abs(next - t) * length < minimumDepth) break;
+            }
+            m_featureDistances[e] = estimate;
+            
+            if (t <= kFeatureInteriorMargin || t >= 1.0f - kFeatureInteriorMargin) continue;
+            if (distance >= contactRadius || distance >= nearestEnd || (pa->sleeping && pb->sleeping)) continue;
+            
+            // 頂點接觸已把這一點推出 (1-t)(r-da)⁺ + t(r-db)⁺，邊只補上剩下的部分
+            const float covered = (1.0f - t) * std::max(contactRadius - da, 0.0f) + t * std::max(contactRadius - db, 0.0f);
+            const float depth = contactRadius - distance - covered;
+            if (depth <= minimumDepth) continue;
+            
+            OGCContactModel::ContactInfo contact;
+            contact.particle = t < 0.5f ? pa : pb;
+            contact.contactPoint = point - normal * distance;
+            contact.contactNormal = normal;
+            contact.penetrationDepth = depth;
+            contact.contactRadius = contactRadius;
+            contact.colliderVelocity = velocity;
+            contact.material = material;
+            contact.feature = ContactFeature::Edge;
+            contact.particles[0] = pa;
+            contact.particles[1] = pb;
+            contact.weights[0] = 1.0f - t;
+            contact.weights[1] = t;
+            
+            contacts.push_back(contact);
+        }
+    });
+    mergeSlots();
+    
+    // 面：碰撞體的尖角落在三角形內部
+    runParallel(faceCount, 256, [&](int begin, int end, int slot) {
+        auto& contacts = m_slotContacts[slot];
+        
+        for (int f = begin; f < end; ++f) {
+            const auto& face = m_triangles[f];
+            ClothParticle* p[3] = {m_particles[face[0]], m_particles[face[1]], m_particles[face[2]]};
+            const float d[3] = {m_vertexDistances[face[0]], m_vertexDistances[face[1]], m_vertexDistances[face[2]]};
+            float& estimate = m_featureDistances[edgeCount + f];
+            
+            // 三角形上任一點離頂點 k 不超過頂點 k 的最長鄰邊
+            float lowerBound = -std::numeric_limits<float>::infinity();
+            float farthest = 0.0f;
+            for (int k = 0; k < 3; ++k) {
+                const float reachK = static_cast<float>(std::max((p[k]->position - p[(k + 1) % 3]->position).length(),
+                                                                 (p[k]->position - p[(k + 2) % 3]->position).length()));
+                lowerBound = std::max(lowerBound, d[k] - reachK);
+                farthest = std::max(farthest, reachK);
+            }
+            if (lowerBound >= contactRadius) {
+                estimate = lowerBound;
+                continue;
+            }
+            
+            // 從重心開始：查詢碰撞體上的最近點，投影回三角形（重心座標截到三角形內）後再查詢，修正幾次
+            const Vector3 e0 = p[1]->position - p[0]->position;
+            const Vector3 e1 = p[2]->position - p[0]->position;
+            const float d00 = static_cast<float>(Vector3::dotProduct(e0, e0));
+            const float d01 = static_cast<float>(Vector3::dotProduct(e0, e1));
+            const float d11 = static_cast<float>(Vector3::dotProduct(e1, e1));
+            const float denominator = d00 * d11 - d01 * d01;
+            const float nearestVertex = std::min(d[0], std::min(d[1], d[2]));
+            estimate = nearestVertex;
+            if (denominator <= 1e-12f) continue;
+            
+            const float queryLimit = std::max(d[0], std::max(d[1], d[2])) + farthest;
+            Vector3 point, normal, velocity;
+            ColliderMaterial material;
+            float distance = queryLimit;
+            float w[3] = {1.0f / 3.0f, 1.0f / 3.0f, 1.0f / 3.0f};
+            float next[3] = {w[0], w[1], w[2]};
+            for (int iteration = 0; iteration < kFeatureProjectionIterations; ++iteration) {
+                std::copy(next, next + 3, w);
+                point = p[0]->position * w[0] + p[1]->position * w[1] + p[2]->position * w[2];
+                distance = colliderDistance(point, queryLimit, normal, velocity, &material);
+                estimate = std::min(estimate, distance);
+                if (distance >= queryLimit) break;
+                
+                const Vector3 v = point - normal * distance - p[0]->position;
+                const float d20 = static_cast<float>(Vector3::dotProduct(v, e0));
+                const float d21 = static_cast<float>(Vector3::dotProduct(v, e1));
+                next[1] = std::max((d11 * d20 - d01 * d21) / denominator, 0.0f);
+                next[2] = std::max((d00 * d21 - d01 * d20) / denominator, 0.0f);
+                next[0] = std::max(1.0f - next[1] - next[2], 0.0f);
+                const float sum = next[0] + next[1] + next[2];
+                float change = 0.0f;
+                for (int k = 0; k < 3; ++k) {
+                    next[k] /= sum;
+                    change = std::max(change, std::abs(next[k] - w[k]));
+                }
+                if (change * farthest < minimumDepth) break;
+            }
+            
+            if (w[0] <= kFeatureInteriorMargin || w[1] <= kFeatureInteriorMargin || w[2] <= kFeatureInteriorMargin) continue;
+            if (distance >= contactRadius || distance >= nearestVertex ||
+                (p[0]->sleeping && p[1]->sleeping && p[2]->sleeping)) continue;
+            
+            float covered = 0.0f;
+            for (int k = 0; k < 3; ++k) {
+                covered += w[k] * std::max(contactRadius - d[k], 0.0f);
+            }
+            const float depth = contactRadius - distance - covered;
+            if (depth <= minimumDepth) continue;
+            
+            OGCContactModel::ContactInfo contact;
+            const int heaviest = w[0] >= w[1] ? (w[0] >= w[2] ? 0 : 2) : (w[1] >= w[2] ? 1 : 2);
+            contact.particle = p[heaviest];
+            contact.contactPoint = point - normal * distance;
+            contact.contactNormal = normal;
+            contact.penetrationDepth = depth;
+            contact.contactRadius = contactRadius;
+            contact.colliderVelocity = velocity;
+            contact.material = material;
+            contact.feature = ContactFeature::Face;
+            for (int k = 0; k < 3; ++k) {
+                contact.particles[k] = p[k];
+                contact.weights[k] = w[k];
+            }
+            
+            contacts.push_back(contact);
+        }
+    });
+    mergeSlots();
+    
+    // 保守位移界限：頂點與所有相鄰特徵的最小距離乘上 γ。頂點本身已經穿透時無法提供界限，交給接觸響應推出；
+    // 只有相鄰的邊或面穿透時改以頂點本身的距離為界限（由邊與面接觸推出），且不放寬
+    runParallel(vertexCount, 256, [&](int begin, int end, int) {
+        for (int i = begin; i < end; ++i) {
+            const float vertexDistance = m_vertexDistances[i];
+            float nearest = vertexDistance;
+            for (int k = m_vertexFeatureOffsets[i]; k < m_vertexFeatureOffsets[i + 1]; ++k) {
+                nearest = std::min(nearest, m_featureDistances[m_vertexFeatures[k]]);
+            }
+            if (vertexDistance <= 0.0f) {
+                m_displacementBounds[i] = std::numeric_limits<float>::infinity();
+                m_featureLimited[i] = 0;
+                continue;
+            }
+            
+            m_displacementBounds[i] = kBoundRelaxation * (nearest > 0.0f ? nearest : vertexDistance);
+            m_featureLimited[i] = nearest < vertexDistance - kFeatureLimitTolerance * contactRadius ? 1 : 0;
+        }
+    });
+}
+
+bool ClothSimulation::usesDisplacementBounds() const {
+    return m_useOGC && m_offsetContacts && !(m_cylinders.empty() && m_colliders.empty());
 }
 
-void ClothSimulation::renderWireframe() {
-    // 暫時註解掉線框渲染
-    /*
-    glColor3f(0.2f, 0.2f, 0.8f);  // 線框顏色
-    glBegin(GL_LINES);
+void ClothSimulation::enforceDisplacementBounds(float deltaTime) {
+    m_slotClampCounts.assign(getThreadCount(), 0);
+    const float invDeltaTime = deltaTime > 0.0f ? 1.0f / deltaTime : 0.0f;
+    
+    runParallel(static_cast<int>(m_particles.size()), 256, [&](int begin, int end, int slot) {
+        for (int i = begin; i < end; ++i) {
+            ClothParticle* particle = m_particles[i];
+            if (particle->pinned || particle->sleeping) {
+                m_lastDisplacements[i] = 0.0f;
+                continue;
+            }
+            
+            const Vector3 displacement = particle->position - m_stepStartPositions[i];
+            const float length = static_cast<float>(displacement.length());
+            float allowed = m_displacementBounds[i];
+            if (length <= allowed) {
+                m_lastDisplacements[i] = length;
+                continue;
+            }
+            
+            // 到達界限的頂點從截斷的位置重新查詢距離再前進（只考慮頂點本身，沿表面滑動時不會被卡住）；
+            // 界限來自更近的邊或面時，頂點本身的距離不代表那個特徵，直接截斷
+            const Vector3 direction = displacement / length;
+            const int passes = m_featureLimited[i] ? 0 : kMaxBoundPasses;
+            for (int pass = 0; pass < passes && allowed < length; ++pass) {
+                Vector3 normal, velocity;
+                const float distance = colliderDistance(m_stepStartPositions[i] + direction * allowed,
+                                                        (length - allowed) / kBoundRelaxation, normal, velocity);
+                if (distance <= 0.0f) break;
+                allowed = std::min(length, allowed + kBoundRelaxation * distance);
+            }
+            if (allowed >= length) {
+                m_lastDisplacements[i] = length;
+                continue;
+            }
+            
+            // 截斷到界限內；速度沿位移方向的分量最多扣掉被截掉的位移（位移也包含約束投影，不能反向加速）
+            const float excess = length - allowed;
+            const float forward = static_cast<float>(Vector3::dotProduct(particle->velocity, direction));
+            particle->position -= direction * excess;
+            particle->velocity -= direction * std::min(std::max(forward, 0.0f), excess * invDeltaTime);
+            m_lastDisplacements[i] = allowed;
+            ++m_slotClampCounts[slot];
+        }
+    });
     
-    for (auto& constraint : m_constraints) {
-        // 這裡需要訪問約束的粒子，可能需要修改 ClothConstraint 類別
-        // 暫時省略線框渲染
+    m_boundClampCount = 0;
+    for (int count : m_slotClampCounts) {
+        m_boundClampCount += count;
+    }
+}
+
+void ClothSimulation::resolveContacts() {
+    // 使用 OGC 模型處理接觸
+    if (!m_contacts.empty()) {
+        m_ogcModel->processContacts(m_contacts, m_stepDeltaTime);
     }
+}
+
+void ClothSimulation::resolveBasicCollisions() {
+    m_queryStats = CollisionQueryStats();
+    if (m_cylinders.empty() && m_colliders.empty()) return;
     
-    glEnd();
-    */
+    // 基本碰撞處理模式：每個粒子只修改自身狀態，可直接平行處理
+    const float dt = m_stepDeltaTime;
+    runParallel(static_cast<int>(m_particles.size()), 128, [&](int begin, int end, int) {
+        for (int i = begin; i < end; ++i) {
+            ClothParticle* particle = m_particles[i];
+            if (particle->pinned || particle->sleeping) continue;
+            
+            for (auto& cylinder : m_cylinders) {
+                Vector3 contactPoint, contactNormal;
+                
+                if (cylinder->checkCollision(particle, contactPoint, contactNormal)) {
+                    // 計算穿透深度
+                    Vector3 toParticle = particle->position - cylinder->center;
+                    float radialDist = sqrt(toParticle.x() * toParticle.x() + toParticle.z() * toParticle.z());
+                    float penetration = cylinder->radius - radialDist;
+                    
+                    applyBasicResponse(particle, contactNormal, penetration, cylinder->velocity.at(contactPoint),
+                                       cylinder->material, dt);
+                }
+            }
+        }
+        
+        forEachColliderContact(begin, end, [dt](ClothParticle* particle, const ColliderContact& hit) {
+            if (!particle->pinned) {
+                applyBasicResponse(particle, hit.normal, hit.depth, hit.velocity, hit.material, dt);
+            }
+        });
+    });
+}
+
+void ClothSimulation::setSleepingEnabled(bool enable) {
+    m_sleepingEnabled = enable;
+    buildSleepTiles();
+}
+
+void ClothSimulation::collidersChanged() {
+    // 碰撞體改變後所有頂點重新查詢距離
+    m_queryCacheValid = false;
+    wakeUp();
+}
+
+void ClothSimulation::setQuerySkipping(bool enable) {
+    m_querySkipping = enable;
+    m_queryCacheValid = false;
 }
 
-void ClothSimulation::renderParticles() {
-    // 暫時註解掉粒子渲染
-    /*
-    glColor3f(1.0f, 0.0f, 0.0f);  // 粒子顏色
-    glPointSize(3.0f);
-    glBegin(GL_POINTS);
+void ClothSimulation::wakeUp() {
+    for (int tile = 0; tile < getTileCount(); ++tile) {
+        m_tileQuietFrames[tile] = 0;
+        if (!m_tileAwake[tile]) {
+            setTileAwake(tile, true);
+        }
+    }
+}
+
+void ClothSimulation::buildSleepTiles() {
+    m_tilesX = (m_width + kSleepTileSize - 1) / kSleepTileSize;
+    m_tilesY = (m_height + kSleepTileSize - 1) / kSleepTileSize;
     
-    for (auto& particle : m_particles) {
-        glVertex3f(particle->position.x(), particle->position.y(), particle->position.z());
+    const int tileCount = m_particles.empty() ? 0 : m_tilesX * m_tilesY;
+    m_tileAwake.assign(tileCount, 1);
+    m_tileQuietFrames.assign(tileCount, 0);
+    m_tileEnergy.assign(tileCount, 0.0f);
+    m_awakeTileCount = tileCount;
+    
+    m_previousPositions.resize(m_particles.size());
+    for (size_t i = 0; i < m_particles.size(); ++i) {
+        m_particles[i]->sleeping = false;
+        m_previousPositions[i] = m_particles[i]->position;
     }
+}
+
+void ClothSimulation::setTileAwake(int tile, bool awake) {
+    if (m_tileAwake[tile] == static_cast<unsigned char>(awake)) return;
     
-    glEnd();
-    */
+    m_tileAwake[tile] = awake;
+    m_awakeTileCount += awake ? 1 : -1;
+    
+    const int x0 = (tile % m_tilesX) * kSleepTileSize;
+    const int y0 = (tile / m_tilesX) * kSleepTileSize;
+    const int x1 = std::min(x0 + kSleepTileSize, m_width);
+    const int y1 = std::min(y0 + kSleepTileSize, m_height);
+    
+    for (int y = y0; y < y1; ++y) {
+        for (int x = x0; x < x1; ++x) {
+            int index = getParticleIndex(x, y);
+            ClothParticle* particle = m_particles[index];
+            particle->sleeping = !awake;
+            
+            // 保留休眠前的速度：靜止狀態下重力累積的速度由約束修正抵消，
+            // 清零會改變鄰近區塊的平衡位置並在喚醒後重新擺動
+            if (awake) {
+                // 重新開始估計速度，避免把休眠期間視為位移
+                m_previousPositions[index] = particle->position;
+            } else {
+                particle->clearForces();
+            }
+        }
+    }
 }
 
-void ClothSimulation::renderColliders() {
-    if (m_cylinders.empty()) return;
+void ClothSimulation::updateSleepState(float deltaTime) {
+    const int tileCount = getTileCount();
+    if (tileCount == 0 || deltaTime <= 0.0f) return;
     
-    glPushMatrix();
-    glDisable(GL_LIGHTING);
+    // 以實際位移估計速度：約束投影只修改位置，粒子的 velocity 無法反映是否靜止
+    const float invDeltaTimeSq = 1.0f / (deltaTime * deltaTime);
     
-    for (const auto& cylinder : m_cylinders) {
-        if (!cylinder) continue;
-        
-        glPushMatrix();
-        
-        // 移動到圓柱體位置
-        glTranslatef(cylinder->center.x(), cylinder->center.y(), cylinder->center.z());
+    runParallel(tileCount, 1, [&](int begin, int end, int) {
+        for (int tile = begin; tile < end; ++tile) {
+            if (!m_tileAwake[tile]) continue;
+            
+            const int x0 = (tile % m_tilesX) * kSleepTileSize;
+            const int y0 = (tile / m_tilesX) * kSleepTileSize;
+            const int x1 = std::min(x0 + kSleepTileSize, m_width);
+            const int y1 = std::min(y0 + kSleepTileSize, m_height);
+            
+            float energy = 0.0f;
+            for (int y = y0; y < y1; ++y) {
+                for (int x = x0; x < x1; ++x) {
+                    int index = getParticleIndex(x, y);
+                    const ClothParticle* particle = m_particles[index];
+                    Vector3 displacement = particle->position - m_previousPositions[index];
+                    energy += 0.5f * particle->mass * displacement.lengthSquared() * invDeltaTimeSq;
+                    m_previousPositions[index] = particle->position;
+                }
+            }
+            m_tileEnergy[tile] = energy / float((x1 - x0) * (y1 - y0));
+        }
+    });
+    
+    // 劇烈運動的區塊喚醒相鄰區塊；靜止的區塊累計靜止步數
+    for (int tile = 0; tile < tileCount; ++tile) {
+        if (!m_tileAwake[tile]) continue;
         
-        // 設定圓柱體顏色
-        glColor3f(0.8f, 0.4f, 0.2f);  // 橙色圓柱體
+        if (m_tileEnergy[tile] < m_sleepThreshold) {
+            ++m_tileQuietFrames[tile];
+            continue;
+        }
         
-        // 簡單的圓柱體渲染（使用線框）
-        const int segments = 16;
-        const float radius = cylinder->radius;
-        const float height = cylinder->height;
+        m_tileQuietFrames[tile] = 0;
+        if (m_tileEnergy[tile] < m_sleepThreshold * kWakeNeighbourFactor) continue;
         
-        // 渲染圓柱體底面
-        glBegin(GL_LINE_LOOP);
-        for (int i = 0; i < segments; ++i) {
-            float angle = 2.0f * M_PI * i / segments;
-            float x = radius * cos(angle);
-            float z = radius * sin(angle);
-            glVertex3f(x, -height/2, z);
+        const int tx = tile % m_tilesX;
+        const int ty = tile / m_tilesX;
+        for (int ny = std::max(0, ty - 1); ny <= std::min(m_tilesY - 1, ty + 1); ++ny) {
+            for (int nx = std::max(0, tx - 1); nx <= std::min(m_tilesX - 1, tx + 1); ++nx) {
+                int neighbour = ny * m_tilesX + nx;
+                if (!m_tileAwake[neighbour]) {
+                    m_tileQuietFrames[neighbour] = 0;
+                    setTileAwake(neighbour, true);
+                }
+            }
         }
-        glEnd();
-        
-        // 渲染圓柱體頂面
-        glBegin(GL_LINE_LOOP);
-        for (int i = 0; i < segments; ++i) {
-            float angle = 2.0f * M_PI * i / segments;
-            float x = radius * cos(angle);
-            float z = radius * sin(angle);
-            glVertex3f(x, height/2, z);
+    }
+    
+    // 只有相鄰區塊也都低於喚醒門檻時才進入休眠，否則會立即被鄰居喚醒
+    for (int tile = 0; tile < tileCount; ++tile) {
+        if (!m_tileAwake[tile] || m_tileQuietFrames[tile] < m_sleepFrames) continue;
+
+        const int tx = tile % m_tilesX;
+        const int ty = tile / m_tilesX;
+        bool neighboursQuiet = true;
+        for (int ny = std::max(0, ty - 1); ny <= std::min(m_tilesY - 1, ty + 1) && neighboursQuiet; ++ny) {
+            for (int nx = std::max(0, tx - 1); nx <= std::min(m_tilesX - 1, tx + 1); ++nx) {
+                int neighbour = ny * m_tilesX + nx;
+                if (m_tileAwake[neighbour] && m_tileEnergy[neighbour] >= m_sleepThreshold * kWakeNeighbourFactor) {
+                    neighboursQuiet = false;
+                    break;
+                }
+            }
         }
-        glEnd();
-        
-        // 渲染圓柱體側面線條
-        glBegin(GL_LINES);
-        for (int i = 0; i < segments; i += 2) {  // 每隔一條線渲染
-            float angle = 2.0f * M_PI * i / segments;
-            float x = radius * cos(angle);
-            float z = radius * sin(angle);
-            glVertex3f(x, -height/2, z);
-            glVertex3f(x, height/2, z);
+
+        if (neighboursQuiet) {
+            setTileAwake(tile, false);
         }
-        glEnd();
-        
-        glPopMatrix();
+    }
+}
+
+void ClothSimulation::integrate(float deltaTime) {
+    const bool bounded = usesDisplacementBounds();
+    m_boundClampCount = 0;
+    if (!m_continuousCollision && !bounded) {
+        advance(deltaTime);
+        return;
+    }
+    
+    // 記下積分前的位置，作為保守位移界限的基準與 CCD 線段的起點
+    storeIterate(m_stepStartPositions);
+    advance(deltaTime);
+    if (bounded) {
+        enforceDisplacementBounds(deltaTime);
+    }
+    if (m_continuousCollision) {
+        resolveContinuousCollisions();
+    }
+}
+
+void ClothSimulation::advance(float deltaTime) {
+    if (m_integrator == Integrator::ImplicitEuler) {
+        // 接觸力已由接觸響應累積在粒子上，這裡另外隱式處理接觸彈簧的剛度
+        static const std::vector<OGCContactModel::ContactInfo> noContacts;
+        m_implicitSolver->step(m_particles, m_useOGC ? m_contacts : noContacts,
+                               m_ogcModel->getStiffness(), deltaTime,
+                               m_scheduler.get(), m_deterministic);
+        m_solverStats.iterations = 0;
+        m_solverStats.linearIterations = m_implicitSolver->getLastIterations();
+        m_solverStats.linearResidual = m_implicitSolver->getLastResidual();
+        return;
+    }
+    
+    if (m_integrator == Integrator::ProjectiveDynamics) {
+        // 分解在第一步或固定點、剛度、步長改變時才重建
+        m_projectiveSolver->step(m_particles, deltaTime, m_scheduler.get(), m_deterministic);
+        m_solverStats.iterations = m_projectiveSolver->settings().iterations;
+        m_solverStats.maxResidual = m_projectiveSolver->getLastMaxStrain();
+        m_solverStats.linearIterations = 0;
+        m_solverStats.linearResidual = 0.0f;
+        return;
+    }
+    
+    updateParticles(deltaTime);
+    solveConstraints();
+}
+
+float ClothSimulation::colliderDistance(const Vector3& position, float maxDistance, Vector3& normal, Vector3& velocity,
+                                        ColliderMaterial* material) const {
+    float best = m_colliders.distance(position, maxDistance, normal, velocity, material);
+    for (const auto& cylinder : m_cylinders) {
+        Vector3 cylinderNormal;
+        float distance = cylinder->signedDistance(position, cylinderNormal);
+        if (distance < best) {
+            best = distance;
+            normal = cylinderNormal;
+            velocity = cylinder->velocity.at(position);
+            if (material) {
+                *material = cylinder->material;
+            }
+        }
+    }
+    return best;
+}
+
+void ClothSimulation::resolveContinuousCollisions() {
+    m_continuousHitCount = 0;
+    if (m_cylinders.empty() && m_colliders.empty()) return;
+    
+    // 動畫碰撞體在這一步內最多移動 motionBound，推進步長要同時涵蓋兩者的相對運動
+    const float motionBound = std::max(m_colliders.getMotionBound(), m_cylinderMotionBound);
+    m_slotHitCounts.assign(getThreadCount(), 0);
+    
+    runParallel(static_cast<int>(m_particles.size()), 128, [&](int begin, int end, int slot) {
+        for (int i = begin; i < end; ++i) {
+            ClothParticle* particle = m_particles[i];
+            if (particle->pinned || particle->sleeping) continue;
+            
+            const Vector3 start = m_stepStartPositions[i];
+            const Vector3 motion = particle->position - start;
+            const float length = static_cast<float>(motion.length());
+            const float sweep = length + motionBound;
+            if (sweep < kContinuousTolerance) continue;
+            
+            // 保守推進：每次前進的距離不會越過最近的碰撞體表面
+            float t = 0.0f;
+            bool hit = false;
+            Vector3 normal, colliderVelocity;
+            int step = 0;
+            for (; step < kMaxAdvancementSteps; ++step) {
+                const float reach = (1.0f - t) * length + motionBound + kContinuousTolerance;
+                const float distance = colliderDistance(start + motion * t, reach, normal, colliderVelocity);
+                if (step == 0 && distance <= 0.0f) break;   // 起點已穿透，交給離散碰撞
+                if (distance < kContinuousTolerance) {
+                    hit = true;
+                    break;
+                }
+                if (distance >= reach) break;               // 剩餘線段整段在安全距離內
+                
+                t += distance / sweep;
+                if (t >= 1.0f) break;
+            }
+            if (step == kMaxAdvancementSteps) {
+                hit = true;
+            }
+            if (!hit) continue;
+            
+            // 停在碰撞點外側，移除朝向表面的相對法向速度
+            particle->position = start + motion * t + normal * kContinuousSkin;
+            float normalVelocity = Vector3::dotProduct(particle->velocity - colliderVelocity, normal);
+            if (normalVelocity < 0) {
+                particle->velocity -= normal * normalVelocity;
+            }
+            ++m_slotHitCounts[slot];
+        }
+    });
+    
+    for (int count : m_slotHitCounts) {
+        m_continuousHitCount += count;
+    }
+}
+
+void ClothSimulation::setImplicitStiffness(float stiffness) {
+    m_implicitSolver->settings().springStiffness = stiffness;
+}
+
+void ClothSimulation::setImplicitDamping(float damping) {
+    m_implicitSolver->settings().springDamping = damping;
+}
+
+void ClothSimulation::setImplicitSolverIterations(int iterations) {
+    m_implicitSolver->settings().maxIterations = std::max(1, iterations);
+}
+
+void ClothSimulation::setImplicitSolverTolerance(float tolerance) {
+    m_implicitSolver->settings().tolerance = tolerance;
+}
+
+void ClothSimulation::setProjectiveStiffness(float stiffness) {
+    m_projectiveSolver->settings().stiffness = stiffness;
+}
+
+void ClothSimulation::setProjectiveIterations(int iterations) {
+    m_projectiveSolver->settings().iterations = std::max(1, iterations);
+}
+
+int ClothSimulation::getFactorizationCount() const {
+    return m_projectiveSolver->getFactorizationCount();
+}
+
+void ClothSimulation::setParticlePinned(int x, int y, bool pinned) {
+    if (x < 0 || x >= m_width || y < 0 || y >= m_height) return;
+    setParticlePinned(getParticleIndex(x, y), pinned);
+}
+
+void ClothSimulation::setParticlePinned(int index, bool pinned) {
+    if (index < 0 || index >= static_cast<int>(m_particles.size())) return;
+    ClothParticle* particle = m_particles[index];
+    if (particle->pinned == pinned) return;
+    
+    particle->pinned = pinned;
+    buildConstraintKernels();
+    // 釋放的粒子可能位於休眠區塊中
+    wakeUp();
+}
+
+bool ClothSimulation::isParticlePinned(int x, int y) const {
+    if (x < 0 || x >= m_width || y < 0 || y >= m_height) {
+        return false;
+    }
+    return m_particles[getParticleIndex(x, y)]->pinned;
+}
+
+void ClothSimulation::updateParticles(float deltaTime) {
+    runParallel(static_cast<int>(m_particleStorage.size()), 256, [&](int begin, int end, int) {
+        for (int i = begin; i < end; ++i) {
+            m_particleStorage[i].update(deltaTime);
+        }
+    });
+}
+
+ClothParticle* ClothSimulation::getParticle(int x, int y) {
+    if (x < 0 || x >= m_width || y < 0 || y >= m_height) {
+        return nullptr;
+    }
+    return m_particles[getParticleIndex(x, y)];
+}
+
+int ClothSimulation::getParticleIndex(int x, int y) const {
+    return y * m_width + x;
+}
+
+void ClothSimulation::calculateNormals() {
+    if (m_meshCloth) {
+        calculateMeshNormals();
+        return;
+    }
+    if (m_scheduler) {
+        calculateNormalsParallel();
+        return;
     }
     
-    glPopMatrix();
+    // 重置法線
+    for (auto& particle : m_particleStorage) {
+        particle.normal = Vector3(0, 0, 0);
+    }
+    
+    // 計算面法線並累加到頂點
+    for (int y = 0; y < m_height - 1; ++y) {
+        for (int x = 0; x < m_width - 1; ++x) {
+            ClothParticle* p1 = getParticle(x, y);
+            ClothParticle* p2 = getParticle(x + 1, y);
+            ClothParticle* p3 = getParticle(x, y + 1);
+            ClothParticle* p4 = getParticle(x + 1, y + 1);
+            
+            if (p1 && p2 && p3 && p4) {
+                // 第一個三角形
+                Vector3 v1 = p2->position - p1->position;
+                Vector3 v2 = p3->position - p1->position;
+                Vector3 normal1 = Vector3::crossProduct(v1, v2).normalized();
+                
+                p1->normal += normal1;
+                p2->normal += normal1;
+                p3->normal += normal1;
+                
+                // 第二個三角形
+                Vector3 v3 = p4->position - p2->position;
+                Vector3 v4 = p3->position - p2->position;
+                Vector3 normal2 = Vector3::crossProduct(v3, v4).normalized();
+                
+                p2->normal += normal2;
+                p3->normal += normal2;
+                p4->normal += normal2;
+            }
+        }
+    }
+    
+    // 正規化法線
+    for (auto& particle : m_particleStorage) {
+        if (particle.normal.length() > 0) {
+            particle.normal.normalize();
+        } else {
+            particle.normal = Vector3(0, 1, 0);
+        }
+    }
+}
+
+void ClothSimulation::calculateNormalsParallel() {
+    if (m_width < 2 || m_height < 2) return;
+    
+    const int quadWidth = m_width - 1;
+    const int quadCount = quadWidth * (m_height - 1);
+    m_faceNormals.resize(quadCount * 2);
+    
+    // 第一階段：每個四邊形的兩個三角形法線，各自寫入獨立位置
+    runParallel(quadCount, 256, [&](int begin, int end, int) {
+        for (int q = begin; q < end; ++q) {
+            int x = q % quadWidth;
+            int y = q / quadWidth;
+            const Vector3& p1 = m_particles[getParticleIndex(x, y)]->position;
+            const Vector3& p2 = m_particles[getParticleIndex(x + 1, y)]->position;
+            const Vector3& p3 = m_particles[getParticleIndex(x, y + 1)]->position;
+            const Vector3& p4 = m_particles[getParticleIndex(x + 1, y + 1)]->position;
+            
+            m_faceNormals[q * 2] = Vector3::crossProduct(p2 - p1, p3 - p1).normalized();
+            m_faceNormals[q * 2 + 1] = Vector3::crossProduct(p4 - p2, p3 - p2).normalized();
+        }
+    });
+    
+    // 第二階段：每個頂點以固定順序收集相鄰三角形的法線，不需要原子操作且結果可重現
+    runParallel(static_cast<int>(m_particles.size()), 256, [&](int begin, int end, int) {
+        for (int i = begin; i < end; ++i) {
+            int x = i % m_width;
+            int y = i / m_width;
+            Vector3 normal(0, 0, 0);
+            
+            if (x < quadWidth && y < m_height - 1) {            // 四邊形 (x, y) 的左上角
+                normal += m_faceNormals[(y * quadWidth + x) * 2];
+            }
+            if (x > 0 && y < m_height - 1) {                    // 四邊形 (x-1, y) 的右上角
+                int q = y * quadWidth + x - 1;
+                normal += m_faceNormals[q * 2];
+                normal += m_faceNormals[q * 2 + 1];
+            }
+            if (x < quadWidth && y > 0) {                       // 四邊形 (x, y-1) 的左下角
+                int q = (y - 1) * quadWidth + x;
+                normal += m_faceNormals[q * 2];
+                normal += m_faceNormals[q * 2 + 1];
+            }
+            if (x > 0 && y > 0) {                               // 四邊形 (x-1, y-1) 的右下角
+                normal += m_faceNormals[((y - 1) * quadWidth + x - 1) * 2 + 1];
+            }
+            
+            ClothParticle* particle = m_particles[i];
+            if (normal.length() > 0) {
+                particle->normal = normal.normalized();
+            } else {
+                particle->normal = Vector3(0, 1, 0);
+            }
+        }
+    });
 }
 
-void ClothSimulation::setupRenderData() {
-    // 準備頂點數據（如果需要使用現代 OpenGL）
-    m_vertices.clear();
-    m_indices.clear();
+void ClothSimulation::calculateMeshNormals() {
+    const int triangleCount = static_cast<int>(m_triangles.size());
+    m_faceNormals.resize(triangleCount);
     
-    // 這裡可以準備 VBO/VAO 數據
-    // 目前使用立即模式渲染，所以暫時省略
+    // 與規則網格的平行版本相同：先各自計算三角形法線，再由每個頂點依固定順序收集
+    runParallel(triangleCount, 256, [&](int begin, int end, int) {
+        for (int f = begin; f < end; ++f) {
+            const auto& triangle = m_triangles[f];
+            const Vector3& p1 = m_particles[triangle[0]]->position;
+            const Vector3& p2 = m_particles[triangle[1]]->position;
+            const Vector3& p3 = m_particles[triangle[2]]->position;
+            m_faceNormals[f] = Vector3::crossProduct(p2 - p1, p3 - p1).normalized();
+        }
+    });
+    
+    // 頂點相鄰的三角形取自接觸特徵的鄰接表（索引 邊數 + f）
+    const int edgeCount = static_cast<int>(m_featureEdges.size());
+    runParallel(static_cast<int>(m_particles.size()), 256, [&](int begin, int end, int) {
+        for (int i = begin; i < end; ++i) {
+            Vector3 normal(0, 0, 0);
+            for (int k = m_vertexFeatureOffsets[i]; k < m_vertexFeatureOffsets[i + 1]; ++k) {
+                if (m_vertexFeatures[k] >= edgeCount) {
+                    normal += m_faceNormals[m_vertexFeatures[k] - edgeCount];
+                }
+            }
+            
+            ClothParticle* particle = m_particles[i];
+            if (normal.length() > 0) {
+                particle->normal = normal.normalized();
+            } else {
+                particle->normal = Vector3(0, 1, 0);
+            }
+        }
+    });
 }
 
 } // namespace Physics
@@ -0,0 +1,101 @@
+#include "physics/ColliderMotion.h"
+#include <cmath>
+#include <algorithm>
+
+namespace Physics {
+
+// ============================================================================
+// ColliderMotion Implementation
+// ============================================================================
+
+ColliderMotion ColliderMotion::keyframed(std::vector<Keyframe> keyframes, bool loop) {
+    ColliderMotion motion;
+    if (keyframes.empty()) return motion;
+
+    std::stable_sort(keyframes.begin(), keyframes.end(),
+                     [](const Keyframe& a, const Keyframe& b) { return a.time < b.time; });
+    motion.m_mode = Mode::Keyframed;
+    motion.m_keyframes = std::move(keyframes);
+    motion.m_loop = loop;
+    return motion;
+}
+
+ColliderMotion ColliderMotion::constantVelocity(const RigidTransform& start, const Vector3& linear, const Vector3& angular) {
+    ColliderMotion motion;
+    motion.m_mode = Mode::ConstantVelocity;
+    motion.m_start = start;
+    motion.m_linear = linear;
+    motion.m_angular = angular;
+    return motion;
+}
+
+float ColliderMotion::wrapTime(float time) const {
+    const float first = m_keyframes.front().time;
+    const float duration = m_keyframes.back().time - first;
+    if (!m_loop || duration <= 0.0f) return time;
+
+    float phase = std::fmod(time - first, duration);
+    if (phase < 0.0f) phase += duration;
+    return first + phase;
+}
+
+int ColliderMotion::findSegment(float time) const {
+    // 回傳 i 使 keyframes[i].time <= time < keyframes[i + 1].time；超出範圍時回傳 -1
+    if (m_keyframes.size() < 2 || time < m_keyframes.front().time || time >= m_keyframes.back().time) return -1;
+    auto next = std::upper_bound(m_keyframes.begin(), m_keyframes.end(), time,
+                                 [](float t, const Keyframe& keyframe) { return t < keyframe.time; });
+    return static_cast<int>(next - m_keyframes.begin()) - 1;
+}
+
+RigidTransform ColliderMotion::evaluate(float time) const {
+    switch (m_mode) {
+    case Mode::Static:
+        return RigidTransform();
+
+    case Mode::ConstantVelocity: {
+        Vector3 translation = m_start.getTranslation() + m_linear * time;
+        Real speed = m_angular.length();
+        if (speed <= 0) return RigidTransform(translation, m_start.getRotation());
+        return RigidTransform(translation, Quaternion::fromAxisAngle(m_angular, speed * time) * m_start.getRotation());
+    }
+
+    case Mode::Keyframed:
+        break;
+    }
+
+    time = wrapTime(time);
+    int segment = findSegment(time);
+    if (segment < 0) {
+        return time < m_keyframes.front().time ? m_keyframes.front().transform : m_keyframes.back().transform;
+    }
+
+    const Keyframe& a = m_keyframes[segment];
+    const Keyframe& b = m_keyframes[segment + 1];
+    Real s = (time - a.time) / (b.time - a.time);
+    Vector3 translation = a.transform.getTranslation() + (b.transform.getTranslation() - a.transform.getTranslation()) * s;
+    return RigidTransform(translation, Quaternion::slerp(a.transform.getRotation(), b.transform.getRotation(), s));
+}
+
+ColliderVelocity ColliderMotion::velocity(float time) const {
+    ColliderVelocity result;
+    result.pivot = evaluate(time).getTranslation();
+
+    if (m_mode == Mode::ConstantVelocity) {
+        result.linear = m_linear;
+        result.angular = m_angular;
+    } else if (m_mode == Mode::Keyframed) {
+        int segment = findSegment(wrapTime(time));
+        if (segment >= 0) {
+            // 每段內平移與旋轉都是等速的
+            const Keyframe& a = m_keyframes[segment];
+            const Keyframe& b = m_keyframes[segment + 1];
+            Real invDuration = Real(1) / (b.time - a.time);
+            result.linear = (b.transform.getTranslation() - a.transform.getTranslation()) * invDuration;
+            Quaternion delta = b.transform.getRotation() * a.transform.getRotation().conjugated();
+            result.angular = delta.toRotationVector() * invDuration;
+        }
+    }
+    return result;
+}
+
+} // namespace Physics
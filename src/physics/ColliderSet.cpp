@@ -0,0 +1,488 @@
+#include "physics/ColliderSet.h"
+#include <cmath>
+#include <algorithm>
+
+namespace Physics {
+
+namespace {
+// 每次處理的查詢點數，暫存陣列放在堆疊上
+constexpr int kBlock = 64;
+
+// 區塊內查詢點的結構陣列（SoA）
+struct PointBlock {
+    Real x[kBlock];
+    Real y[kBlock];
+    Real z[kBlock];
+    int count;
+};
+
+Vector3 pointAt(const PointBlock& block, int i) {
+    return Vector3(block.x[i], block.y[i], block.z[i]);
+}
+
+void collideSpheres(const std::vector<SphereCollider>& spheres, const PointBlock& block, int offset,
+                    std::vector<ColliderContact>& contacts) {
+    Real distance[kBlock];
+    for (const SphereCollider& sphere : spheres) {
+        const Real cx = sphere.center.x(), cy = sphere.center.y(), cz = sphere.center.z();
+        for (int i = 0; i < block.count; ++i) {
+            Real dx = block.x[i] - cx, dy = block.y[i] - cy, dz = block.z[i] - cz;
+            distance[i] = std::sqrt(dx * dx + dy * dy + dz * dz) - sphere.radius;
+        }
+        for (int i = 0; i < block.count; ++i) {
+            if (distance[i] >= 0) continue;
+            Vector3 offsetFromCenter = pointAt(block, i) - sphere.center;
+            Real length = distance[i] + sphere.radius;
+            Vector3 normal = length > Real(1e-6) ? offsetFromCenter / length : Vector3(0, 1, 0);
+            Vector3 point = sphere.center + normal * sphere.radius;
+            contacts.push_back({offset + i, point, normal, static_cast<float>(-distance[i]), sphere.velocity.at(point), sphere.material});
+        }
+    }
+}
+
+void collideCapsules(const std::vector<CapsuleCollider>& capsules, const PointBlock& block, int offset,
+                     std::vector<ColliderContact>& contacts) {
+    Real distance[kBlock];
+    Real parameter[kBlock];
+    for (const CapsuleCollider& capsule : capsules) {
+        const Vector3 axis = capsule.pointB - capsule.pointA;
+        const Real lengthSquared = axis.lengthSquared();
+        const Real invLengthSquared = lengthSquared > 0 ? Real(1) / lengthSquared : Real(0);
+        const Real ax = capsule.pointA.x(), ay = capsule.pointA.y(), az = capsule.pointA.z();
+        const Real ux = axis.x(), uy = axis.y(), uz = axis.z();
+        for (int i = 0; i < block.count; ++i) {
+            Real px = block.x[i] - ax, py = block.y[i] - ay, pz = block.z[i] - az;
+            Real t = std::min(std::max((px * ux + py * uy + pz * uz) * invLengthSquared, Real(0)), Real(1));
+            Real dx = px - ux * t, dy = py - uy * t, dz = pz - uz * t;
+            parameter[i] = t;
+            distance[i] = std::sqrt(dx * dx + dy * dy + dz * dz) - capsule.radius;
+        }
+        for (int i = 0; i < block.count; ++i) {
+            if (distance[i] >= 0) continue;
+            Vector3 closest = capsule.pointA + axis * parameter[i];
+            Vector3 offsetFromAxis = pointAt(block, i) - closest;
+            Real length = distance[i] + capsule.radius;
+            Vector3 normal = length > Real(1e-6) ? offsetFromAxis / length : Vector3(0, 1, 0);
+            Vector3 point = closest + normal * capsule.radius;
+            contacts.push_back({offset + i, point, normal, static_cast<float>(-distance[i]), capsule.velocity.at(point), capsule.material});
+        }
+    }
+}
+
+void collideBoxes(const std::vector<BoxCollider>& boxes, const PointBlock& block, int offset,
+                  std::vector<ColliderContact>& contacts) {
+    Real local[3][kBlock];
+    Real distance[kBlock];
+    for (const BoxCollider& box : boxes) {
+        const Vector3& center = box.transform.getTranslation();
+        const Vector3& u = box.transform.getAxis(0);
+        const Vector3& v = box.transform.getAxis(1);
+        const Vector3& w = box.transform.getAxis(2);
+        const Real hx = box.halfExtents.x(), hy = box.halfExtents.y(), hz = box.halfExtents.z();
+        for (int i = 0; i < block.count; ++i) {
+            Real px = block.x[i] - center.x(), py = block.y[i] - center.y(), pz = block.z[i] - center.z();
+            Real lx = px * u.x() + py * u.y() + pz * u.z();
+            Real ly = px * v.x() + py * v.y() + pz * v.z();
+            Real lz = px * w.x() + py * w.y() + pz * w.z();
+            local[0][i] = lx;
+            local[1][i] = ly;
+            local[2][i] = lz;
+            // 內部的有號距離為到最近面的距離（負值）；外部只需要正負號
+            distance[i] = std::max(std::max(std::abs(lx) - hx, std::abs(ly) - hy), std::abs(lz) - hz);
+        }
+        for (int i = 0; i < block.count; ++i) {
+            if (distance[i] >= 0) continue;
+            // 沿穿透最淺的面推出
+            Real gaps[3] = {std::abs(local[0][i]) - hx, std::abs(local[1][i]) - hy, std::abs(local[2][i]) - hz};
+            int axis = 0;
+            if (gaps[1] > gaps[axis]) axis = 1;
+            if (gaps[2] > gaps[axis]) axis = 2;
+            Vector3 normal = box.transform.getAxis(axis) * (local[axis][i] < 0 ? Real(-1) : Real(1));
+            Real depth = -gaps[axis];
+            Vector3 point = pointAt(block, i) + normal * depth;
+            contacts.push_back({offset + i, point, normal, static_cast<float>(depth), box.velocity.at(point), box.material});
+        }
+    }
+}
+
+void collidePlanes(const std::vector<PlaneCollider>& planes, const PointBlock& block, int offset,
+                   std::vector<ColliderContact>& contacts) {
+    Real distance[kBlock];
+    for (const PlaneCollider& plane : planes) {
+        const Real nx = plane.normal.x(), ny = plane.normal.y(), nz = plane.normal.z();
+        for (int i = 0; i < block.count; ++i) {
+            distance[i] = block.x[i] * nx + block.y[i] * ny + block.z[i] * nz - plane.offset;
+        }
+        for (int i = 0; i < block.count; ++i) {
+            if (distance[i] >= 0) continue;
+            Vector3 point = pointAt(block, i) - plane.normal * distance[i];
+            contacts.push_back({offset + i, point, plane.normal, static_cast<float>(-distance[i]), plane.velocity.at(point), plane.material});
+        }
+    }
+}
+}
+
+// ============================================================================
+// ColliderSet Implementation
+// ============================================================================
+
+ColliderHandle ColliderSet::addSphere(const RigidTransform& transform, float radius) {
+    m_spheres.push_back({transform.getTranslation(), radius, {}, ColliderMaterial()});
+    return {ColliderType::Sphere, static_cast<int>(m_spheres.size()) - 1};
+}
+
+ColliderHandle ColliderSet::addCapsule(const RigidTransform& transform, float halfHeight, float radius) {
+    m_capsules.push_back({transform.apply(Vector3(0, -halfHeight, 0)), transform.apply(Vector3(0, halfHeight, 0)),
+                          radius, {}, ColliderMaterial()});
+    return {ColliderType::Capsule, static_cast<int>(m_capsules.size()) - 1};
+}
+
+ColliderHandle ColliderSet::addBox(const RigidTransform& transform, const Vector3& halfExtents) {
+    m_boxes.push_back({transform, halfExtents, {}, ColliderMaterial()});
+    return {ColliderType::Box, static_cast<int>(m_boxes.size()) - 1};
+}
+
+ColliderHandle ColliderSet::addPlane(const RigidTransform& transform) {
+    Vector3 normal = transform.getAxis(1);
+    m_planes.push_back({normal, static_cast<float>(Vector3::dotProduct(normal, transform.getTranslation())), {}, ColliderMaterial()});
+    return {ColliderType::Plane, static_cast<int>(m_planes.size()) - 1};
+}
+
+SDFCollider* ColliderSet::addSDF(std::unique_ptr<SDFCollider> collider) {
+    m_sdfs.push_back(std::move(collider));
+    m_sdfVelocities.emplace_back();
+    m_sdfMaterials.emplace_back();
+    return m_sdfs.back().get();
+}
+
+MeshCollider* ColliderSet::addMesh(std::unique_ptr<MeshCollider> collider) {
+    m_meshes.push_back(std::move(collider));
+    m_meshVelocities.emplace_back();
+    m_meshMaterials.emplace_back();
+    return m_meshes.back().get();
+}
+
+ColliderHandle ColliderSet::getHandle(const SDFCollider* collider) const {
+    for (std::size_t i = 0; i < m_sdfs.size(); ++i) {
+        if (m_sdfs[i].get() == collider) return {ColliderType::SDF, static_cast<int>(i)};
+    }
+    return {ColliderType::SDF, -1};
+}
+
+ColliderHandle ColliderSet::getHandle(const MeshCollider* collider) const {
+    for (std::size_t i = 0; i < m_meshes.size(); ++i) {
+        if (m_meshes[i].get() == collider) return {ColliderType::Mesh, static_cast<int>(i)};
+    }
+    return {ColliderType::Mesh, -1};
+}
+
+void ColliderSet::clearPrimitives() {
+    m_spheres.clear();
+    m_capsules.clear();
+    m_boxes.clear();
+    m_planes.clear();
+    removeAnimations(ColliderType::Sphere);
+    removeAnimations(ColliderType::Capsule);
+    removeAnimations(ColliderType::Box);
+    removeAnimations(ColliderType::Plane);
+}
+
+void ColliderSet::clearSDFs() {
+    m_sdfs.clear();
+    m_sdfVelocities.clear();
+    m_sdfMaterials.clear();
+    removeAnimations(ColliderType::SDF);
+}
+
+void ColliderSet::clearMeshes() {
+    m_meshes.clear();
+    m_meshVelocities.clear();
+    m_meshMaterials.clear();
+    removeAnimations(ColliderType::Mesh);
+}
+
+void ColliderSet::removeAnimations(ColliderType type) {
+    m_animations.erase(std::remove_if(m_animations.begin(), m_animations.end(),
+                                      [type](const Animation& animation) { return animation.handle.type == type; }),
+                       m_animations.end());
+}
+
+void ColliderSet::setMaterial(const ColliderHandle& handle, const ColliderMaterial& material) {
+    if (!handle.isValid()) return;
+
+    switch (handle.type) {
+    case ColliderType::Sphere: m_spheres[handle.index].material = material; break;
+    case ColliderType::Capsule: m_capsules[handle.index].material = material; break;
+    case ColliderType::Box: m_boxes[handle.index].material = material; break;
+    case ColliderType::Plane: m_planes[handle.index].material = material; break;
+    case ColliderType::SDF: m_sdfMaterials[handle.index] = material; break;
+    case ColliderType::Mesh: m_meshMaterials[handle.index] = material; break;
+    }
+}
+
+void ColliderSet::setMotion(const ColliderHandle& handle, const ColliderMotion& motion) {
+    if (!handle.isValid()) return;
+
+    auto existing = std::find_if(m_animations.begin(), m_animations.end(), [&](const Animation& animation) {
+        return animation.handle.type == handle.type && animation.handle.index == handle.index;
+    });
+
+    if (!motion.isAnimated()) {
+        if (existing == m_animations.end()) return;
+        // 停在目前的位置，速度歸零
+        switch (handle.type) {
+        case ColliderType::Sphere: m_spheres[handle.index].velocity = ColliderVelocity(); break;
+        case ColliderType::Capsule: m_capsules[handle.index].velocity = ColliderVelocity(); break;
+        case ColliderType::Box: m_boxes[handle.index].velocity = ColliderVelocity(); break;
+        case ColliderType::Plane: m_planes[handle.index].velocity = ColliderVelocity(); break;
+        case ColliderType::SDF: m_sdfVelocities[handle.index] = ColliderVelocity(); break;
+        case ColliderType::Mesh: m_meshVelocities[handle.index] = ColliderVelocity(); break;
+        }
+        m_animations.erase(existing);
+        return;
+    }
+
+    Animation animation;
+    animation.handle = handle;
+    animation.motion = motion;
+    switch (handle.type) {
+    case ColliderType::Sphere:
+        break;
+    case ColliderType::Capsule: {
+        const CapsuleCollider& capsule = m_capsules[handle.index];
+        animation.halfHeight = 0.5f * static_cast<float>((capsule.pointB - capsule.pointA).length());
+        animation.reach = animation.halfHeight + capsule.radius;
+        break;
+    }
+    case ColliderType::Box:
+        animation.reach = static_cast<float>(m_boxes[handle.index].halfExtents.length());
+        break;
+    case ColliderType::Plane:
+        break;
+    case ColliderType::SDF: {
+        const SDFCollider& sdf = *m_sdfs[handle.index];
+        Vector3 lo = sdf.getBoundsMin(), hi = sdf.getBoundsMax();
+        Vector3 farthest(std::max(std::abs(lo.x()), std::abs(hi.x())), std::max(std::abs(lo.y()), std::abs(hi.y())),
+                         std::max(std::abs(lo.z()), std::abs(hi.z())));
+        animation.reach = static_cast<float>(farthest.length());
+        break;
+    }
+    case ColliderType::Mesh:
+        // 目前（未變換）的頂點即為局部頂點
+        animation.restVertices = m_meshes[handle.index]->getVertices();
+        for (const Vector3& v : animation.restVertices) {
+            animation.reach = std::max(animation.reach, static_cast<float>(v.length()));
+        }
+        break;
+    }
+
+    if (existing != m_animations.end()) {
+        if (handle.type == ColliderType::Mesh) {
+            animation.restVertices.swap(existing->restVertices);
+            animation.reach = existing->reach;
+        }
+        *existing = std::move(animation);
+    } else {
+        m_animations.push_back(std::move(animation));
+    }
+}
+
+void ColliderSet::updateMotion(float time, float deltaTime) {
+    m_animationBound = 0.0f;
+    m_moving = false;
+    std::vector<Vector3> worldVertices;
+
+    for (const Animation& animation : m_animations) {
+        const RigidTransform pose = animation.motion.evaluate(time);
+        const RigidTransform previous = animation.motion.evaluate(time - deltaTime);
+        const ColliderVelocity velocity = animation.motion.velocity(time);
+        const int index = animation.handle.index;
+
+        // 表面點的位移不超過 原點位移 + 旋轉角 × 表面到原點的最大距離
+        Quaternion delta = pose.getRotation() * previous.getRotation().conjugated();
+        Vector3 translation = pose.getTranslation() - previous.getTranslation();
+        float bound = static_cast<float>(translation.length() + delta.toRotationVector().length() * animation.reach);
+
+        switch (animation.handle.type) {
+        case ColliderType::Sphere:
+            m_spheres[index].center = pose.getTranslation();
+            m_spheres[index].velocity = velocity;
+            break;
+        case ColliderType::Capsule:
+            m_capsules[index].pointA = pose.apply(Vector3(0, -animation.halfHeight, 0));
+            m_capsules[index].pointB = pose.apply(Vector3(0, animation.halfHeight, 0));
+            m_capsules[index].velocity = velocity;
+            break;
+        case ColliderType::Box:
+            m_boxes[index].transform = pose;
+            m_boxes[index].velocity = velocity;
+            break;
+        case ColliderType::Plane:
+            m_planes[index].normal = pose.getAxis(1);
+            m_planes[index].offset = static_cast<float>(Vector3::dotProduct(pose.getAxis(1), pose.getTranslation()));
+            m_planes[index].velocity = velocity;
+            bound = static_cast<float>(std::abs(Vector3::dotProduct(pose.getAxis(1), translation)));
+            break;
+        case ColliderType::SDF:
+            m_sdfs[index]->setTransform(pose);
+            m_sdfVelocities[index] = velocity;
+            break;
+        case ColliderType::Mesh:
+            // 拓撲不變，只需 refit 包圍盒
+            worldVertices.resize(animation.restVertices.size());
+            for (std::size_t i = 0; i < worldVertices.size(); ++i) {
+                worldVertices[i] = pose.apply(animation.restVertices[i]);
+            }
+            m_meshes[index]->refit(worldVertices);
+            m_meshVelocities[index] = velocity;
+            break;
+        }
+
+        m_animationBound = std::max(m_animationBound, bound);
+        m_moving = m_moving || bound > 0.0f || velocity.linear.lengthSquared() > 0 || velocity.angular.lengthSquared() > 0;
+    }
+}
+
+void ColliderSet::collide(const Vector3* positions, int count, std::vector<ColliderContact>& contacts) const {
+    PointBlock block;
+    SDFCollider::Sample samples[kBlock];
+
+    for (int blockBegin = 0; blockBegin < count; blockBegin += kBlock) {
+        block.count = std::min(kBlock, count - blockBegin);
+        for (int i = 0; i < block.count; ++i) {
+            const Vector3& p = positions[blockBegin + i];
+            block.x[i] = p.x();
+            block.y[i] = p.y();
+            block.z[i] = p.z();
+        }
+
+        collideSpheres(m_spheres, block, blockBegin, contacts);
+        collideCapsules(m_capsules, block, blockBegin, contacts);
+        collideBoxes(m_boxes, block, blockBegin, contacts);
+        collidePlanes(m_planes, block, blockBegin, contacts);
+
+        for (std::size_t k = 0; k < m_sdfs.size(); ++k) {
+            m_sdfs[k]->queryBatch(positions + blockBegin, block.count, samples);
+            for (int i = 0; i < block.count; ++i) {
+                if (samples[i].distance >= 0.0f) continue;
+                const Vector3& p = positions[blockBegin + i];
+                Vector3 point = p - samples[i].normal * samples[i].distance;
+                contacts.push_back({blockBegin + i, point, samples[i].normal, -samples[i].distance,
+                                    m_sdfVelocities[k].at(point), m_sdfMaterials[k]});
+            }
+        }
+
+        for (std::size_t k = 0; k < m_meshes.size(); ++k) {
+            const std::size_t first = contacts.size();
+            m_meshes[k]->collide(positions + blockBegin, block.count, contacts);
+            for (std::size_t i = first; i < contacts.size(); ++i) {
+                contacts[i].index += blockBegin;
+                contacts[i].velocity = m_meshVelocities[k].at(contacts[i].point);
+                contacts[i].material = m_meshMaterials[k];
+            }
+        }
+    }
+}
+
+float ColliderSet::distance(const Vector3& position, float maxDistance, Vector3& normal, Vector3& velocity,
+                           ColliderMaterial* material) const {
+    Real best = maxDistance;
+    const ColliderVelocity* nearestVelocity = nullptr;
+    const ColliderMaterial* nearestMaterial = nullptr;
+    auto consider = [&](Real distance, const Vector3& direction, const ColliderVelocity& colliderVelocity,
+                        const ColliderMaterial& colliderMaterial) {
+        if (distance < best) {
+            best = distance;
+            normal = direction;
+            nearestVelocity = &colliderVelocity;
+            nearestMaterial = &colliderMaterial;
+        }
+    };
+    auto directionOr = [](const Vector3& offset, Real length, const Vector3& fallback) {
+        return length > Real(1e-6) ? offset / length : fallback;
+    };
+
+    for (const SphereCollider& sphere : m_spheres) {
+        Vector3 offset = position - sphere.center;
+        Real length = offset.length();
+        consider(length - sphere.radius, directionOr(offset, length, Vector3(0, 1, 0)), sphere.velocity, sphere.material);
+    }
+
+    for (const CapsuleCollider& capsule : m_capsules) {
+        Vector3 axis = capsule.pointB - capsule.pointA;
+        Real lengthSquared = axis.lengthSquared();
+        Real t = lengthSquared > 0 ? Vector3::dotProduct(position - capsule.pointA, axis) / lengthSquared : Real(0);
+        Vector3 offset = position - (capsule.pointA + axis * std::min(std::max(t, Real(0)), Real(1)));
+        Real length = offset.length();
+        consider(length - capsule.radius, directionOr(offset, length, Vector3(0, 1, 0)), capsule.velocity, capsule.material);
+    }
+
+    for (const BoxCollider& box : m_boxes) {
+        // 外部為到盒面的精確距離，內部為到最近面的負距離
+        Vector3 local = box.transform.applyInverse(position);
+        Vector3 outside(0, 0, 0);
+        int deepestAxis = 0;
+        Real gaps[3];
+        for (int axis = 0; axis < 3; ++axis) {
+            gaps[axis] = std::abs(local[axis]) - box.halfExtents[axis];
+            outside[axis] = std::max(gaps[axis], Real(0)) * (local[axis] < 0 ? Real(-1) : Real(1));
+            if (gaps[axis] > gaps[deepestAxis]) deepestAxis = axis;
+        }
+        Real outsideLength = outside.length();
+        if (outsideLength > 0) {
+            consider(outsideLength, box.transform.rotate(outside / outsideLength), box.velocity, box.material);
+        } else {
+            consider(gaps[deepestAxis], box.transform.getAxis(deepestAxis) * (local[deepestAxis] < 0 ? Real(-1) : Real(1)),
+                     box.velocity, box.material);
+        }
+    }
+
+    for (const PlaneCollider& plane : m_planes) {
+        consider(Vector3::dotProduct(plane.normal, position) - plane.offset, plane.normal, plane.velocity, plane.material);
+    }
+
+    for (std::size_t k = 0; k < m_sdfs.size(); ++k) {
+        const SDFCollider& sdf = *m_sdfs[k];
+        SDFCollider::Sample sample;
+        if (sdf.query(position, sample)) {
+            consider(sample.distance, sample.normal, m_sdfVelocities[k], m_sdfMaterials[k]);
+            continue;
+        }
+        // 網格外：表面一定在網格範圍內，到範圍的距離是下界
+        const Vector3 local = sdf.getTransform().applyInverse(position);
+        const Vector3 lo = sdf.getBoundsMin();
+        const Vector3 hi = sdf.getBoundsMax();
+        Vector3 offset(0, 0, 0);
+        for (int axis = 0; axis < 3; ++axis) {
+            offset[axis] = std::max(lo[axis] - local[axis], Real(0)) - std::max(local[axis] - hi[axis], Real(0));
+        }
+        Real length = offset.length();
+        consider(length, sdf.getTransform().rotate(directionOr(offset * Real(-1), length, Vector3(0, 1, 0))), m_sdfVelocities[k], m_sdfMaterials[k]);
+    }
+
+    for (std::size_t k = 0; k < m_meshes.size(); ++k) {
+        const MeshCollider& mesh = *m_meshes[k];
+        Vector3 closest;
+        int triangle;
+        if (!mesh.closestPoint(position, static_cast<float>(best) + mesh.getThickness(), closest, triangle)) continue;
+        Vector3 offset = position - closest;
+        Real length = offset.length();
+        consider(length - mesh.getThickness(), directionOr(offset, length, mesh.getFaceNormal(triangle)), m_meshVelocities[k], m_meshMaterials[k]);
+    }
+
+    velocity = nearestVelocity ? nearestVelocity->at(position) : Vector3(0, 0, 0);
+    if (material && nearestMaterial) {
+        *material = *nearestMaterial;
+    }
+    return static_cast<float>(best);
+}
+
+float ColliderSet::getMotionBound() const {
+    float bound = m_animationBound;
+    for (const auto& mesh : m_meshes) {
+        bound = std::max(bound, mesh->getLastDisplacement());
+    }
+    return bound;
+}
+
+} // namespace Physics
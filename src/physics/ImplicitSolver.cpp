@@ -0,0 +1,272 @@
+#include "physics/ImplicitSolver.h"
+#include "physics/ClothSimulation.h"
+#include <cmath>
+#include <algorithm>
+
+namespace Physics {
+
+ImplicitSolver::ImplicitSolver()
+    : m_lastIterations(0)
+    , m_lastResidual(0.0f)
+    , m_scheduler(nullptr)
+    , m_deterministic(false)
+    , m_h(0.0f)
+    , m_contactStiffness(0.0f)
+{
+}
+
+ImplicitSolver::~ImplicitSolver() = default;
+
+void ImplicitSolver::build(const std::vector<ClothParticle*>& particles,
+                           const std::vector<std::unique_ptr<ClothConstraint>>& constraints) {
+    const int particleCount = static_cast<int>(particles.size());
+
+    m_graph.build(particles, constraints);
+
+    m_springDirections.resize(m_graph.getSpringCount());
+    m_springStretch.resize(m_graph.getSpringCount());
+    m_springTransverse.resize(m_graph.getSpringCount());
+
+    m_contactNormals.resize(particleCount);
+    m_fixed.resize(particleCount);
+    m_rhs.resize(particleCount);
+    m_deltaVelocity.resize(particleCount);
+    m_residual.resize(particleCount);
+    m_preconditioned.resize(particleCount);
+    m_direction.resize(particleCount);
+    m_product.resize(particleCount);
+    m_inverseDiagonal.resize(particleCount);
+}
+
+double ImplicitSolver::mergeSlots(int component) const {
+    // 依槽位順序合併，固定分區時結果逐位元可重現
+    double sum = 0.0;
+    for (const SlotSum& slot : m_slotSums) {
+        sum += slot.value[component];
+    }
+    return sum;
+}
+
+void ImplicitSolver::step(std::vector<ClothParticle*>& particles,
+                          const std::vector<OGCContactModel::ContactInfo>& contacts,
+                          float contactStiffness, float deltaTime,
+                          TaskScheduler* scheduler, bool deterministic) {
+    m_scheduler = scheduler;
+    m_deterministic = deterministic;
+    m_h = deltaTime;
+    m_contactStiffness = contactStiffness;
+    m_slotSums.resize(scheduler ? scheduler->getThreadCount() : 1);
+
+    const int particleCount = static_cast<int>(particles.size());
+    if (particleCount == 0 || deltaTime <= 0.0f) return;
+
+    linearize(particles, contacts);
+    buildRightHandSide(particles);
+    solve(particles);
+
+    // v += Δv, x += h v
+    runParallel(m_scheduler, m_deterministic, particleCount, 256, [&](int begin, int end, int) {
+        for (int i = begin; i < end; ++i) {
+            ClothParticle* particle = particles[i];
+            if (!m_fixed[i]) {
+                particle->velocity += m_deltaVelocity[i];
+                particle->position += particle->velocity * m_h;
+            }
+            particle->clearForces();
+        }
+    });
+}
+
+void ImplicitSolver::linearize(const std::vector<ClothParticle*>& particles,
+                               const std::vector<OGCContactModel::ContactInfo>& contacts) {
+    runParallel(m_scheduler, m_deterministic, m_graph.getSpringCount(), 1024, [&](int begin, int end, int) {
+        for (int s = begin; s < end; ++s) {
+            const Spring& spring = m_graph.getSprings()[s];
+            Vector3 delta = particles[spring.particle1]->position - particles[spring.particle2]->position;
+            float length = delta.length();
+
+            if (length < 1e-6f) {
+                m_springDirections[s] = Vector3(0, 0, 0);
+                m_springStretch[s] = 0.0f;
+                m_springTransverse[s] = 0.0f;
+                continue;
+            }
+
+            m_springDirections[s] = delta / length;
+            m_springStretch[s] = length - spring.restLength;
+            // 壓縮中的彈簧橫向剛度為負，捨去以保持系統正定
+            m_springTransverse[s] = std::max(0.0f, 1.0f - spring.restLength / length);
+        }
+    });
+
+    runParallel(m_scheduler, m_deterministic, static_cast<int>(particles.size()), 1024, [&](int begin, int end, int) {
+        for (int i = begin; i < end; ++i) {
+            const ClothParticle* particle = particles[i];
+            m_fixed[i] = particle->pinned || particle->sleeping;
+            m_contactNormals[i] = Vector3(0, 0, 0);
+        }
+    });
+
+    // 只有一個碰撞體時每個粒子最多一個接觸；多個接觸時保留最後一個的法線
+    for (const auto& contact : contacts) {
+        int index = m_graph.findParticle(contact.particle);
+        if (index >= 0 && contact.penetrationDepth > 0.0f) {
+            m_contactNormals[index] = contact.contactNormal;
+        }
+    }
+}
+
+void ImplicitSolver::buildRightHandSide(const std::vector<ClothParticle*>& particles) {
+    const float k = m_settings.springStiffness;
+    const float kd = m_settings.springDamping;
+    const float h = m_h;
+
+    runParallel(m_scheduler, m_deterministic, static_cast<int>(particles.size()), 256, [&](int begin, int end, int) {
+        for (int i = begin; i < end; ++i) {
+            if (m_fixed[i]) {
+                m_rhs[i] = Vector3(0, 0, 0);
+                m_inverseDiagonal[i] = Vector3(0, 0, 0);
+                continue;
+            }
+
+            const ClothParticle* particle = particles[i];
+            Vector3 force = particle->force;
+            Vector3 stiffnessVelocity(0, 0, 0);     // Σ S (v_i - v_j)
+            Vector3 diagonal(particle->mass, particle->mass, particle->mass);
+
+            for (int n = m_graph.neighbourBegin(i); n < m_graph.neighbourEnd(i); ++n) {
+                const Neighbour& neighbour = m_graph.getNeighbour(n);
+                const Vector3 d = m_springDirections[neighbour.spring] * neighbour.sign;
+                const float c = m_springTransverse[neighbour.spring];
+                const Vector3 relativeVelocity = particle->velocity - particles[neighbour.other]->velocity;
+                const float along = Vector3::dotProduct(d, relativeVelocity);
+
+                // 彈簧力與沿方向的阻尼力
+                force -= d * (k * m_springStretch[neighbour.spring] + kd * along);
+
+                stiffnessVelocity += (d * (along * (1.0f - c)) + relativeVelocity * c) * k;
+
+                const Vector3 dSq(d.x() * d.x(), d.y() * d.y(), d.z() * d.z());
+                diagonal += (dSq * (1.0f - c) + Vector3(c, c, c)) * (h * h * k) + dSq * (h * kd);
+            }
+
+            const Vector3& normal = m_contactNormals[i];
+            if (!normal.isNull()) {
+                stiffnessVelocity += normal * (m_contactStiffness * Vector3::dotProduct(normal, particle->velocity));
+                diagonal += Vector3(normal.x() * normal.x(), normal.y() * normal.y(), normal.z() * normal.z())
+                          * (h * h * m_contactStiffness);
+            }
+
+            // b = h (f + h K v)，其中 K = -S
+            m_rhs[i] = (force - stiffnessVelocity * h) * h;
+            m_inverseDiagonal[i] = Vector3(1.0f / diagonal.x(), 1.0f / diagonal.y(), 1.0f / diagonal.z());
+        }
+    });
+}
+
+Vector3 ImplicitSolver::applySystem(const std::vector<ClothParticle*>& particles,
+                                    const std::vector<Vector3>& x, int i) const {
+    // (M - h D - h² K) x 的第 i 列，以相鄰彈簧收集；固定粒子的 x 恆為零
+    if (m_fixed[i]) return Vector3(0, 0, 0);
+
+    const float h = m_h;
+    const float springScale = h * h * m_settings.springStiffness;
+    const float dampingScale = h * m_settings.springDamping;
+
+    Vector3 result = x[i] * particles[i]->mass;
+    for (int n = m_graph.neighbourBegin(i); n < m_graph.neighbourEnd(i); ++n) {
+        const Neighbour& neighbour = m_graph.getNeighbour(n);
+        const Vector3& d = m_springDirections[neighbour.spring];
+        const float c = m_springTransverse[neighbour.spring];
+        const Vector3 u = x[i] - x[neighbour.other];
+        const float along = Vector3::dotProduct(d, u);
+
+        result += (d * (along * (1.0f - c)) + u * c) * springScale + d * (along * dampingScale);
+    }
+
+    const Vector3& normal = m_contactNormals[i];
+    if (!normal.isNull()) {
+        result += normal * (h * h * m_contactStiffness * Vector3::dotProduct(normal, x[i]));
+    }
+    return result;
+}
+
+void ImplicitSolver::solve(const std::vector<ClothParticle*>& particles) {
+    const int particleCount = static_cast<int>(particles.size());
+
+    // x = 0, r = b, z = P⁻¹ r, p = z
+    for (SlotSum& slot : m_slotSums) slot = SlotSum{{0.0, 0.0}};
+    runParallel(m_scheduler, m_deterministic, particleCount, 1024, [&](int begin, int end, int slot) {
+        double rhsNorm = 0.0, rz = 0.0;
+        for (int i = begin; i < end; ++i) {
+            m_deltaVelocity[i] = Vector3(0, 0, 0);
+            m_residual[i] = m_rhs[i];
+            m_preconditioned[i] = m_residual[i] * m_inverseDiagonal[i];
+            m_direction[i] = m_preconditioned[i];
+            rhsNorm += m_rhs[i].lengthSquared();
+            rz += Vector3::dotProduct(m_residual[i], m_preconditioned[i]);
+        }
+        m_slotSums[slot].value[0] += rhsNorm;
+        m_slotSums[slot].value[1] += rz;
+    });
+
+    const double rhsNormSq = mergeSlots(0);
+    double rz = mergeSlots(1);
+    const double toleranceSq = double(m_settings.tolerance) * m_settings.tolerance * rhsNormSq;
+
+    m_lastIterations = 0;
+    m_lastResidual = 0.0f;
+    if (rhsNormSq <= 0.0) return;
+
+    double residualNormSq = rhsNormSq;
+    for (int iteration = 0; iteration < m_settings.maxIterations; ++iteration) {
+        if (residualNormSq <= toleranceSq) break;
+
+        // Ap 與 p·Ap
+        for (SlotSum& slot : m_slotSums) slot = SlotSum{{0.0, 0.0}};
+        runParallel(m_scheduler, m_deterministic, particleCount, 256, [&](int begin, int end, int slot) {
+            double pAp = 0.0;
+            for (int i = begin; i < end; ++i) {
+                m_product[i] = applySystem(particles, m_direction, i);
+                pAp += Vector3::dotProduct(m_direction[i], m_product[i]);
+            }
+            m_slotSums[slot].value[0] += pAp;
+        });
+
+        const double pAp = mergeSlots(0);
+        if (pAp <= 0.0) break;
+        const float alpha = static_cast<float>(rz / pAp);
+
+        // x += αp, r -= αAp, z = P⁻¹ r
+        for (SlotSum& slot : m_slotSums) slot = SlotSum{{0.0, 0.0}};
+        runParallel(m_scheduler, m_deterministic, particleCount, 1024, [&](int begin, int end, int slot) {
+            double rr = 0.0, rzNew = 0.0;
+            for (int i = begin; i < end; ++i) {
+                m_deltaVelocity[i] += m_direction[i] * alpha;
+                m_residual[i] -= m_product[i] * alpha;
+                m_preconditioned[i] = m_residual[i] * m_inverseDiagonal[i];
+                rr += m_residual[i].lengthSquared();
+                rzNew += Vector3::dotProduct(m_residual[i], m_preconditioned[i]);
+            }
+            m_slotSums[slot].value[0] += rr;
+            m_slotSums[slot].value[1] += rzNew;
+        });
+
+        residualNormSq = mergeSlots(0);
+        const double rzNew = mergeSlots(1);
+        const float beta = static_cast<float>(rzNew / rz);
+        rz = rzNew;
+        ++m_lastIterations;
+
+        // p = z + βp
+        runParallel(m_scheduler, m_deterministic, particleCount, 1024, [&](int begin, int end, int) {
+            for (int i = begin; i < end; ++i) {
+                m_direction[i] = m_preconditioned[i] + m_direction[i] * beta;
+            }
+        });
+    }
+
+    m_lastResidual = static_cast<float>(std::sqrt(residualNormSq / rhsNormSq));
+}
+
+} // namespace Physics
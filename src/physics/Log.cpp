@@ -0,0 +1,26 @@
+#include "physics/Log.h"
+#include <iostream>
+
+namespace Physics {
+
+namespace {
+LogHandler& logHandler() {
+    static LogHandler handler;
+    return handler;
+}
+}
+
+void setLogHandler(LogHandler handler) {
+    logHandler() = std::move(handler);
+}
+
+void logMessage(const std::string& message) {
+    const LogHandler& handler = logHandler();
+    if (handler) {
+        handler(message);
+    } else {
+        std::cerr << message << std::endl;
+    }
+}
+
+} // namespace Physics
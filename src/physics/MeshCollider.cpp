@@ -0,0 +1,325 @@
+#include "physics/MeshCollider.h"
+#include "physics/ColliderSet.h"
+#include "physics/Geometry.h"
+#include <cmath>
+#include <algorithm>
+#include <limits>
+
+namespace Physics {
+
+namespace {
+constexpr int kBinCount = 12;       // SAH 分箱數
+constexpr int kMaxLeafSize = 4;     // 葉節點最多三角形數
+constexpr int kMaxDepth = 60;       // 查詢堆疊大小的上限保證
+
+struct Bounds {
+    float lo[3] = {std::numeric_limits<float>::max(), std::numeric_limits<float>::max(), std::numeric_limits<float>::max()};
+    float hi[3] = {-std::numeric_limits<float>::max(), -std::numeric_limits<float>::max(), -std::numeric_limits<float>::max()};
+
+    void grow(const float* otherLo, const float* otherHi) {
+        for (int axis = 0; axis < 3; ++axis) {
+            lo[axis] = std::min(lo[axis], otherLo[axis]);
+            hi[axis] = std::max(hi[axis], otherHi[axis]);
+        }
+    }
+
+    void grow(const Bounds& other) { grow(other.lo, other.hi); }
+
+    float area() const {
+        float dx = hi[0] - lo[0], dy = hi[1] - lo[1], dz = hi[2] - lo[2];
+        if (dx < 0.0f || dy < 0.0f || dz < 0.0f) return 0.0f;
+        return dx * dy + dy * dz + dz * dx;
+    }
+};
+
+// 點到包圍盒的距離平方（點在盒內時為 0）
+float boxDistanceSquared(const float* lo, const float* hi, const float* p) {
+    float result = 0.0f;
+    for (int axis = 0; axis < 3; ++axis) {
+        float d = std::max(std::max(lo[axis] - p[axis], p[axis] - hi[axis]), 0.0f);
+        result += d * d;
+    }
+    return result;
+}
+}
+
+// ============================================================================
+// MeshCollider Implementation
+// ============================================================================
+
+MeshCollider::MeshCollider(const std::vector<Vector3>& vertices, const std::vector<int>& indices, float thickness)
+    : m_vertices(vertices)
+    , m_indices(indices.begin(), indices.begin() + indices.size() / 3 * 3)
+    , m_thickness(std::max(thickness, 0.0f))
+    , m_lastDisplacement(0.0f)
+{
+    build();
+}
+
+void MeshCollider::computeTriangleBounds(int triangle, float* boundsMin, float* boundsMax) const {
+    const Vector3& a = m_vertices[m_indices[triangle * 3]];
+    const Vector3& b = m_vertices[m_indices[triangle * 3 + 1]];
+    const Vector3& c = m_vertices[m_indices[triangle * 3 + 2]];
+    for (int axis = 0; axis < 3; ++axis) {
+        boundsMin[axis] = static_cast<float>(std::min(std::min(a[axis], b[axis]), c[axis]));
+        boundsMax[axis] = static_cast<float>(std::max(std::max(a[axis], b[axis]), c[axis]));
+    }
+}
+
+Vector3 MeshCollider::getFaceNormal(int triangle) const {
+    const Vector3& a = m_vertices[m_indices[triangle * 3]];
+    const Vector3& b = m_vertices[m_indices[triangle * 3 + 1]];
+    const Vector3& c = m_vertices[m_indices[triangle * 3 + 2]];
+    return Vector3::crossProduct(b - a, c - a).normalized();
+}
+
+void MeshCollider::build() {
+    m_nodes.clear();
+    const int triangleCount = getTriangleCount();
+    if (triangleCount == 0) return;
+
+    std::vector<Bounds> triangleBounds(triangleCount);
+    std::vector<float> centroids(triangleCount * 3);
+    for (int t = 0; t < triangleCount; ++t) {
+        computeTriangleBounds(t, triangleBounds[t].lo, triangleBounds[t].hi);
+        for (int axis = 0; axis < 3; ++axis) {
+            centroids[t * 3 + axis] = 0.5f * (triangleBounds[t].lo[axis] + triangleBounds[t].hi[axis]);
+        }
+    }
+
+    std::vector<int> order(triangleCount);
+    for (int t = 0; t < triangleCount; ++t) {
+        order[t] = t;
+    }
+
+    // 以顯式堆疊依前序建立：左子節點先出堆疊，因此緊接在父節點之後
+    struct Task {
+        int begin, end, depth;
+        int parent;     // 右子節點需要回填父節點的 offset，左子節點為 -1
+    };
+    std::vector<Task> tasks;
+    tasks.push_back({0, triangleCount, 0, -1});
+    m_nodes.reserve(2 * triangleCount / kMaxLeafSize + 1);
+
+    while (!tasks.empty()) {
+        Task task = tasks.back();
+        tasks.pop_back();
+
+        const int nodeIndex = static_cast<int>(m_nodes.size());
+        if (task.parent >= 0) {
+            m_nodes[task.parent].offset = nodeIndex;
+        }
+
+        Bounds bounds, centroidBounds;
+        for (int i = task.begin; i < task.end; ++i) {
+            bounds.grow(triangleBounds[order[i]]);
+            const float* c = &centroids[order[i] * 3];
+            centroidBounds.grow(c, c);
+        }
+
+        Node node;
+        for (int axis = 0; axis < 3; ++axis) {
+            node.boundsMin[axis] = bounds.lo[axis];
+            node.boundsMax[axis] = bounds.hi[axis];
+        }
+
+        const int count = task.end - task.begin;
+        int bestAxis = -1, bestSplit = 0;
+        float bestCost = std::numeric_limits<float>::max();
+
+        if (count > 2 && task.depth < kMaxDepth) {
+            // 分箱 SAH：每個軸把質心範圍分成 kBinCount 箱，評估 kBinCount - 1 個切分面
+            for (int axis = 0; axis < 3; ++axis) {
+                const float extent = centroidBounds.hi[axis] - centroidBounds.lo[axis];
+                if (extent <= 0.0f) continue;
+                const float scale = kBinCount / extent;
+
+                Bounds binBounds[kBinCount];
+                int binCounts[kBinCount] = {};
+                for (int i = task.begin; i < task.end; ++i) {
+                    int bin = std::min(kBinCount - 1, static_cast<int>((centroids[order[i] * 3 + axis] - centroidBounds.lo[axis]) * scale));
+                    ++binCounts[bin];
+                    binBounds[bin].grow(triangleBounds[order[i]]);
+                }
+
+                float rightArea[kBinCount];
+                int rightCount[kBinCount];
+                Bounds accumulated;
+                int accumulatedCount = 0;
+                for (int bin = kBinCount - 1; bin > 0; --bin) {
+                    accumulated.grow(binBounds[bin]);
+                    accumulatedCount += binCounts[bin];
+                    rightArea[bin] = accumulated.area();
+                    rightCount[bin] = accumulatedCount;
+                }
+
+                accumulated = Bounds();
+                accumulatedCount = 0;
+                for (int split = 1; split < kBinCount; ++split) {
+                    accumulated.grow(binBounds[split - 1]);
+                    accumulatedCount += binCounts[split - 1];
+                    if (accumulatedCount == 0 || rightCount[split] == 0) continue;
+                    float cost = accumulatedCount * accumulated.area() + rightCount[split] * rightArea[split];
+                    if (cost < bestCost) {
+                        bestCost = cost;
+                        bestAxis = axis;
+                        bestSplit = split;
+                    }
+                }
+            }
+        }
+
+        // 切分不划算（或無法切分）時成為葉節點；三角形過多時退回中位數切分
+        const float leafCost = count * bounds.area();
+        bool makeLeaf = count <= 2 || task.depth >= kMaxDepth || (count <= kMaxLeafSize && bestCost >= leafCost);
+        int middle = task.begin + count / 2;
+        if (!makeLeaf) {
+            if (bestAxis >= 0) {
+                const float scale = kBinCount / (centroidBounds.hi[bestAxis] - centroidBounds.lo[bestAxis]);
+                const float lo = centroidBounds.lo[bestAxis];
+                const int axis = bestAxis, split = bestSplit;
+                middle = static_cast<int>(std::partition(order.begin() + task.begin, order.begin() + task.end, [&](int t) {
+                    return std::min(kBinCount - 1, static_cast<int>((centroids[t * 3 + axis] - lo) * scale)) < split;
+                }) - order.begin());
+            }
+            if (middle == task.begin || middle == task.end) {
+                middle = task.begin + count / 2;
+            }
+        }
+
+        if (makeLeaf) {
+            node.offset = task.begin;
+            node.count = count;
+            m_nodes.push_back(node);
+        } else {
+            node.offset = -1;
+            node.count = 0;
+            m_nodes.push_back(node);
+            tasks.push_back({middle, task.end, task.depth + 1, nodeIndex});
+            tasks.push_back({task.begin, middle, task.depth + 1, -1});
+        }
+    }
+
+    // 三角形依葉節點順序重排，葉節點內的資料連續
+    std::vector<int> reordered(m_indices.size());
+    for (int i = 0; i < triangleCount; ++i) {
+        for (int k = 0; k < 3; ++k) {
+            reordered[i * 3 + k] = m_indices[order[i] * 3 + k];
+        }
+    }
+    m_indices.swap(reordered);
+}
+
+void MeshCollider::refit(const std::vector<Vector3>& vertices) {
+    if (vertices.size() != m_vertices.size()) {
+        // 頂點數改變時新舊頂點無法對應，位移記為 0
+        m_vertices = vertices;
+        m_lastDisplacement = 0.0f;
+        build();
+        return;
+    }
+
+    Real maxDisplacementSquared = 0;
+    for (std::size_t i = 0; i < vertices.size(); ++i) {
+        maxDisplacementSquared = std::max(maxDisplacementSquared, (vertices[i] - m_vertices[i]).lengthSquared());
+    }
+    m_lastDisplacement = static_cast<float>(std::sqrt(maxDisplacementSquared));
+    m_vertices = vertices;
+
+    // 子節點的索引一定大於父節點，反向走訪即為由下而上
+    for (int i = static_cast<int>(m_nodes.size()) - 1; i >= 0; --i) {
+        Node& node = m_nodes[i];
+        Bounds bounds;
+        if (node.count > 0) {
+            for (int t = node.offset; t < node.offset + node.count; ++t) {
+                float lo[3], hi[3];
+                computeTriangleBounds(t, lo, hi);
+                bounds.grow(lo, hi);
+            }
+        } else {
+            bounds.grow(m_nodes[i + 1].boundsMin, m_nodes[i + 1].boundsMax);
+            bounds.grow(m_nodes[node.offset].boundsMin, m_nodes[node.offset].boundsMax);
+        }
+        for (int axis = 0; axis < 3; ++axis) {
+            node.boundsMin[axis] = bounds.lo[axis];
+            node.boundsMax[axis] = bounds.hi[axis];
+        }
+    }
+}
+
+bool MeshCollider::closestPoint(const Vector3& position, float maxDistance, Vector3& closest, int& triangle) const {
+    if (m_nodes.empty()) return false;
+
+    const float p[3] = {static_cast<float>(position.x()), static_cast<float>(position.y()), static_cast<float>(position.z())};
+    float bestDistanceSquared = maxDistance * maxDistance;
+    triangle = -1;
+
+    int stack[kMaxDepth + 4];
+    int stackSize = 0;
+    stack[stackSize++] = 0;
+
+    while (stackSize > 0) {
+        const Node& node = m_nodes[stack[--stackSize]];
+        if (boxDistanceSquared(node.boundsMin, node.boundsMax, p) >= bestDistanceSquared) continue;
+
+        if (node.count > 0) {
+            for (int t = node.offset; t < node.offset + node.count; ++t) {
+                Vector3 candidate = closestPointOnTriangle(position, m_vertices[m_indices[t * 3]],
+                                                           m_vertices[m_indices[t * 3 + 1]], m_vertices[m_indices[t * 3 + 2]]);
+                float distanceSquared = static_cast<float>((candidate - position).lengthSquared());
+                if (distanceSquared < bestDistanceSquared) {
+                    bestDistanceSquared = distanceSquared;
+                    closest = candidate;
+                    triangle = t;
+                }
+            }
+            continue;
+        }
+
+        // 較近的子節點後推入、先走訪，讓搜尋半徑盡快縮小
+        const int left = static_cast<int>(&node - m_nodes.data()) + 1;
+        const int right = node.offset;
+        float leftDistance = boxDistanceSquared(m_nodes[left].boundsMin, m_nodes[left].boundsMax, p);
+        float rightDistance = boxDistanceSquared(m_nodes[right].boundsMin, m_nodes[right].boundsMax, p);
+        if (leftDistance < rightDistance) {
+            if (rightDistance < bestDistanceSquared) stack[stackSize++] = right;
+            if (leftDistance < bestDistanceSquared) stack[stackSize++] = left;
+        } else {
+            if (leftDistance < bestDistanceSquared) stack[stackSize++] = left;
+            if (rightDistance < bestDistanceSquared) stack[stackSize++] = right;
+        }
+    }
+
+    return triangle >= 0;
+}
+
+void MeshCollider::collide(const Vector3* positions, int count, std::vector<ColliderContact>& contacts) const {
+    for (int i = 0; i < count; ++i) {
+        const Vector3& p = positions[i];
+        Vector3 closest;
+        int triangle;
+        if (!closestPoint(p, m_thickness, closest, triangle)) continue;
+
+        Vector3 offset = p - closest;
+        Real distance = offset.length();
+        Vector3 face = getFaceNormal(triangle);
+
+        // 背面的點沿面法線推回正面；正面的點沿最近點方向推到厚度外
+        Vector3 normal;
+        Real depth;
+        if (Vector3::dotProduct(offset, face) < 0) {
+            normal = face;
+            depth = m_thickness + distance;
+        } else {
+            normal = distance > Real(1e-6) ? offset / distance : face;
+            depth = m_thickness - distance;
+        }
+        if (depth <= 0) continue;
+
+        // 網格本身不知道動畫速度與材質，以靜止表面與預設摩擦記錄；ColliderSet 再填入碰撞體的速度與材質
+        contacts.push_back({i, closest + normal * m_thickness, normal, static_cast<float>(depth), Vector3(0, 0, 0),
+                            ColliderMaterial()});
+    }
+}
+
+} // namespace Physics
@@ -1,6 +1,6 @@
 #include "physics/OGCContactModel.h"
 #include "physics/ClothSimulation.h"
-#include <QDebug>
+#include "physics/Log.h"
 #include <algorithm>
 
 namespace Physics {
@@ -10,7 +10,7 @@ OGCContactModel::OGCContactModel(float contactRadius)
     , m_stiffness(1000.0f)
     , m_damping(50.0f)
 {
-    qDebug() << "OGC接觸模型初始化，接觸半徑:" << m_contactRadius;
+    logInfo("OGC接觸模型初始化，接觸半徑: ", m_contactRadius);
 }
 
 void OGCContactModel::processContacts(const std::vector<ContactInfo>& contacts, float deltaTime) {
@@ -23,51 +23,115 @@ void OGCContactModel::processContacts(const std::vector<ContactInfo>& contacts,
 }
 
 void OGCContactModel::applyOGCForce(const ContactInfo& contact, float deltaTime) {
+    if (contact.feature != ContactFeature::Vertex) {
+        applyFeatureForce(contact, deltaTime);
+        return;
+    }
     if (!contact.particle || contact.particle->pinned) return;
     
-    // 計算偏移幾何
-    QVector3D offsetPosition = calculateOffsetGeometry(contact);
-    
-    // 計算接觸力
-    QVector3D contactForce = calculateContactForce(contact);
-    
-    // 計算阻尼力
-    QVector3D dampingForce = calculateDampingForce(contact);
-    
-    // 總力
-    QVector3D totalForce = contactForce + dampingForce;
+    // 計算接觸力與阻尼力（阻尼使用相對於移動碰撞體的速度）
+    Vector3 totalForce, correction;
+    computeResponse(contact.particle->velocity - contact.colliderVelocity, contact.contactNormal,
+                    contact.penetrationDepth, totalForce, correction);
     
     // 應用力到粒子
     contact.particle->addForce(totalForce);
     
     // OGC特有的位置修正
-    if (contact.penetrationDepth > 0) {
-        QVector3D correction = contact.contactNormal * (contact.penetrationDepth * 0.8f);
-        contact.particle->position += correction;
+    contact.particle->position += correction;
+    
+    // 摩擦：正向位移為位置修正加上接觸力在這一步推動的距離
+    ClothParticle* particle = contact.particle;
+    float normalDisplacement = static_cast<float>(correction.length()) +
+        std::max(0.0f, static_cast<float>(Vector3::dotProduct(totalForce, contact.contactNormal))) * particle->invMass * deltaTime * deltaTime;
+    Vector3 predicted = particle->velocity + particle->force * particle->invMass * deltaTime - contact.colliderVelocity;
+    particle->velocity += computeFriction(predicted, contact.contactNormal, normalDisplacement, contact.material, deltaTime);
+}
+
+void OGCContactModel::applyFeatureForce(const ContactInfo& contact, float deltaTime) {
+    const int count = contact.feature == ContactFeature::Edge ? 2 : 3;
+    
+    // 接觸點的速度與有效逆質量（固定的頂點不分配修正）
+    Vector3 velocity(0, 0, 0), predicted(0, 0, 0);
+    float weightSquares = 0.0f, invMass = 0.0f;
+    for (int i = 0; i < count; ++i) {
+        const ClothParticle* particle = contact.particles[i];
+        const float w = contact.weights[i];
+        velocity += particle->velocity * w;
+        predicted += (particle->velocity + particle->force * particle->invMass * deltaTime) * w;
+        if (!particle->pinned) {
+            weightSquares += w * w;
+            invMass += w * w * particle->invMass;
+        }
+    }
+    if (weightSquares <= 0.0f) return;
+    
+    Vector3 totalForce, correction;
+    computeResponse(velocity - contact.colliderVelocity, contact.contactNormal, contact.penetrationDepth,
+                    totalForce, correction);
+    
+    float normalDisplacement = static_cast<float>(correction.length()) +
+        std::max(0.0f, static_cast<float>(Vector3::dotProduct(totalForce, contact.contactNormal))) * invMass * deltaTime * deltaTime;
+    Vector3 friction = computeFriction(predicted - contact.colliderVelocity, contact.contactNormal, normalDisplacement,
+                                       contact.material, deltaTime);
+    
+    // 力依重心座標分配（能量梯度）；位置與速度修正以 w / Σw² 分配，使接觸點本身移動完整的修正量
+    for (int i = 0; i < count; ++i) {
+        ClothParticle* particle = contact.particles[i];
+        if (particle->pinned) continue;
+        const float w = contact.weights[i];
+        particle->addForce(totalForce * w);
+        particle->position += correction * (w / weightSquares);
+        particle->velocity += friction * (w / weightSquares);
+    }
+}
+
+void OGCContactModel::computeResponse(const Vector3& velocity, const Vector3& contactNormal, float penetrationDepth,
+                                      Vector3& force, Vector3& correction) const {
+    force = calculateContactForce(contactNormal, penetrationDepth)
+          + calculateDampingForce(velocity, contactNormal);
+    
+    if (penetrationDepth > 0) {
+        correction = contactNormal * (penetrationDepth * 0.8f);
+    } else {
+        correction = Vector3(0, 0, 0);
     }
 }
 
-QVector3D OGCContactModel::calculateOffsetGeometry(const ContactInfo& contact) {
-    // 在接觸法線方向上偏移接觸半徑的距離
-    return contact.contactPoint + contact.contactNormal * m_contactRadius;
+Vector3 OGCContactModel::computeFriction(const Vector3& velocity, const Vector3& contactNormal, float normalDisplacement,
+                                         const ColliderMaterial& material, float deltaTime) {
+    if (normalDisplacement <= 0 || material.staticFriction <= 0) return Vector3(0, 0, 0);
+    
+    Vector3 tangent = velocity - contactNormal * Vector3::dotProduct(velocity, contactNormal);
+    float slip = static_cast<float>(tangent.length()) * deltaTime;
+    if (slip <= 0) return Vector3(0, 0, 0);
+    
+    // 靜摩擦錐內：取消整個切向位移
+    if (slip <= material.staticFriction * normalDisplacement) {
+        return -tangent;
+    }
+    
+    // 動摩擦：滑動距離減少 μk·d
+    float scale = std::min(1.0f, material.kineticFriction * normalDisplacement / slip);
+    return tangent * -scale;
 }
 
-QVector3D OGCContactModel::calculateContactForce(const ContactInfo& contact) {
+Vector3 OGCContactModel::calculateContactForce(const Vector3& contactNormal, float penetrationDepth) const {
     // 基於穿透深度的彈性力
-    float penetration = std::max(0.0f, contact.penetrationDepth);
-    return contact.contactNormal * (m_stiffness * penetration);
+    float penetration = std::max(0.0f, penetrationDepth);
+    return contactNormal * (m_stiffness * penetration);
 }
 
-QVector3D OGCContactModel::calculateDampingForce(const ContactInfo& contact) {
+Vector3 OGCContactModel::calculateDampingForce(const Vector3& velocity, const Vector3& contactNormal) const {
     // 計算法線方向的速度分量
-    float normalVelocity = QVector3D::dotProduct(contact.particle->velocity, contact.contactNormal);
+    float normalVelocity = Vector3::dotProduct(velocity, contactNormal);
     
-    // 只在粒子向接觸面移動時應用阻尼
+    // 只在粒子向接觸面移動時應用阻尼，方向沿法線向外（抵銷接近速度）
     if (normalVelocity < 0) {
-        return contact.contactNormal * (m_damping * normalVelocity);
+        return contactNormal * (-m_damping * normalVelocity);
     }
     
-    return QVector3D(0, 0, 0);
+    return Vector3(0, 0, 0);
 }
 
 } // namespace Physics
@@ -0,0 +1,292 @@
+#include "physics/ProjectiveSolver.h"
+#include "physics/ClothSimulation.h"
+#include <cmath>
+#include <algorithm>
+
+namespace Physics {
+
+ProjectiveSolver::ProjectiveSolver()
+    : m_factorized(false)
+    , m_factorStiffness(0.0f)
+    , m_factorDeltaTime(0.0f)
+    , m_factorizationCount(0)
+    , m_lastMaxStrain(0.0f)
+    , m_scheduler(nullptr)
+    , m_deterministic(false)
+{
+}
+
+ProjectiveSolver::~ProjectiveSolver() = default;
+
+void ProjectiveSolver::build(const std::vector<ClothParticle*>& particles,
+                             const std::vector<std::unique_ptr<ClothConstraint>>& constraints) {
+    const int particleCount = static_cast<int>(particles.size());
+
+    m_graph.build(particles, constraints);
+
+    m_projections.resize(m_graph.getSpringCount());
+    m_startPositions.resize(particleCount);
+    m_inertia.resize(particleCount);
+
+    // 拓撲改變後必須重新分解
+    m_factorized = false;
+}
+
+bool ProjectiveSolver::needsFactorization(const std::vector<ClothParticle*>& particles,
+                                          float deltaTime) const {
+    if (!m_factorized) return true;
+    if (deltaTime != m_factorDeltaTime || m_settings.stiffness != m_factorStiffness) return true;
+
+    // 固定點直接比對旗標，無論是經由 setParticlePinned() 或直接修改粒子都能偵測
+    for (size_t i = 0; i < particles.size(); ++i) {
+        if (particles[i]->pinned != static_cast<bool>(m_factorPinned[i])) return true;
+    }
+    return false;
+}
+
+void ProjectiveSolver::factorize(const std::vector<ClothParticle*>& particles, float deltaTime) {
+    const int particleCount = static_cast<int>(particles.size());
+    const double w = m_settings.stiffness;
+    const double inverseStepSq = 1.0 / (double(deltaTime) * deltaTime);
+
+    // 固定粒子不是未知數；其餘依粒子順序編號，保持網格的帶狀結構
+    m_factorPinned.resize(particleCount);
+    m_unknownIndex.assign(particleCount, -1);
+    m_unknownParticle.clear();
+    for (int i = 0; i < particleCount; ++i) {
+        m_factorPinned[i] = particles[i]->pinned;
+        if (!particles[i]->pinned) {
+            m_unknownIndex[i] = static_cast<int>(m_unknownParticle.size());
+            m_unknownParticle.push_back(i);
+        }
+    }
+
+    const int unknownCount = static_cast<int>(m_unknownParticle.size());
+
+    // 包絡：每列最左邊的非零行；Cholesky 的填入不會超出包絡
+    m_envelopeFirst.resize(unknownCount);
+    for (int u = 0; u < unknownCount; ++u) {
+        m_envelopeFirst[u] = u;
+    }
+    for (const Spring& spring : m_graph.getSprings()) {
+        int u1 = m_unknownIndex[spring.particle1];
+        int u2 = m_unknownIndex[spring.particle2];
+        if (u1 < 0 || u2 < 0) continue;
+        int row = std::max(u1, u2);
+        m_envelopeFirst[row] = std::min(m_envelopeFirst[row], std::min(u1, u2));
+    }
+
+    m_envelopeOffset.resize(unknownCount + 1);
+    m_envelopeOffset[0] = 0;
+    for (int u = 0; u < unknownCount; ++u) {
+        m_envelopeOffset[u + 1] = m_envelopeOffset[u] + (u - m_envelopeFirst[u] + 1);
+    }
+
+    auto entry = [this](int row, int column) -> double& {
+        return m_factor[m_envelopeOffset[row] + (column - m_envelopeFirst[row])];
+    };
+
+    // 組裝 A = M/h² + w Σ (e_a - e_b)(e_a - e_b)ᵀ 的下三角
+    m_factor.assign(m_envelopeOffset[unknownCount], 0.0);
+    for (int u = 0; u < unknownCount; ++u) {
+        entry(u, u) = particles[m_unknownParticle[u]]->mass * inverseStepSq;
+    }
+    for (const Spring& spring : m_graph.getSprings()) {
+        int u1 = m_unknownIndex[spring.particle1];
+        int u2 = m_unknownIndex[spring.particle2];
+        if (u1 >= 0) entry(u1, u1) += w;
+        if (u2 >= 0) entry(u2, u2) += w;
+        if (u1 >= 0 && u2 >= 0) {
+            entry(std::max(u1, u2), std::min(u1, u2)) -= w;
+        }
+    }
+
+    // 逐列 Cholesky：L_ij = (A_ij - Σ_k L_ik L_jk) / L_jj，k 只需掃過兩列包絡的交集
+    for (int i = 0; i < unknownCount; ++i) {
+        const int firstI = m_envelopeFirst[i];
+        double* rowI = &m_factor[m_envelopeOffset[i]];
+
+        for (int j = firstI; j < i; ++j) {
+            const int firstJ = m_envelopeFirst[j];
+            const double* rowJ = &m_factor[m_envelopeOffset[j]];
+            double sum = rowI[j - firstI];
+            for (int k = std::max(firstI, firstJ); k < j; ++k) {
+                sum -= rowI[k - firstI] * rowJ[k - firstJ];
+            }
+            rowI[j - firstI] = sum / rowJ[j - firstJ];
+        }
+
+        double diagonal = rowI[i - firstI];
+        for (int k = firstI; k < i; ++k) {
+            diagonal -= rowI[k - firstI] * rowI[k - firstI];
+        }
+        // 質量項使矩陣嚴格對角佔優，對角線恆為正
+        rowI[i - firstI] = std::sqrt(diagonal);
+    }
+
+    m_rhs.resize(size_t(unknownCount) * 3);
+    m_factorStiffness = m_settings.stiffness;
+    m_factorDeltaTime = deltaTime;
+    m_factorized = true;
+    ++m_factorizationCount;
+}
+
+void ProjectiveSolver::step(std::vector<ClothParticle*>& particles, float deltaTime,
+                            TaskScheduler* scheduler, bool deterministic) {
+    m_scheduler = scheduler;
+    m_deterministic = deterministic;
+    m_slotMax.resize(scheduler ? scheduler->getThreadCount() : 1);
+
+    const int particleCount = static_cast<int>(particles.size());
+    if (particleCount == 0 || deltaTime <= 0.0f) return;
+
+    if (needsFactorization(particles, deltaTime)) {
+        factorize(particles, deltaTime);
+    }
+
+    // 慣性預測 s = x + h v + h² M⁻¹ f，並以其作為初始猜測；休眠粒子留在原位
+    const float h = deltaTime;
+    runParallel(m_scheduler, m_deterministic, particleCount, 256, [&](int begin, int end, int) {
+        for (int i = begin; i < end; ++i) {
+            ClothParticle* particle = particles[i];
+            m_startPositions[i] = particle->position;
+            if (!particle->pinned && !particle->sleeping) {
+                m_inertia[i] = particle->position + particle->velocity * h + particle->force * (particle->invMass * h * h);
+                particle->position = m_inertia[i];
+            } else {
+                m_inertia[i] = particle->position;
+            }
+        }
+    });
+
+    const int unknownCount = static_cast<int>(m_unknownParticle.size());
+    for (int iteration = 0; iteration < m_settings.iterations; ++iteration) {
+        projectConstraints(particles);
+        buildRightHandSide(particles, deltaTime);
+        substitute();
+
+        // 休眠粒子雖然在系統中，但保持原位，與 PBD 掃描中的處理相同
+        runParallel(m_scheduler, m_deterministic, unknownCount, 512, [&](int begin, int end, int) {
+            for (int u = begin; u < end; ++u) {
+                ClothParticle* particle = particles[m_unknownParticle[u]];
+                if (particle->sleeping) continue;
+                const double* q = &m_rhs[size_t(u) * 3];
+                particle->position = Vector3(static_cast<float>(q[0]), static_cast<float>(q[1]), static_cast<float>(q[2]));
+            }
+        });
+    }
+
+    // v = (q - x) / h
+    runParallel(m_scheduler, m_deterministic, particleCount, 256, [&](int begin, int end, int) {
+        for (int i = begin; i < end; ++i) {
+            ClothParticle* particle = particles[i];
+            if (!particle->pinned && !particle->sleeping) {
+                particle->velocity = (particle->position - m_startPositions[i]) / h;
+            }
+            particle->clearForces();
+        }
+    });
+}
+
+void ProjectiveSolver::projectConstraints(const std::vector<ClothParticle*>& particles) {
+    // 局部步：各約束互不相依
+    for (SlotMax& slot : m_slotMax) slot.value = 0.0f;
+    runParallel(m_scheduler, m_deterministic, m_graph.getSpringCount(), 1024, [&](int begin, int end, int slot) {
+        float maxStrain = 0.0f;
+        for (int s = begin; s < end; ++s) {
+            const Spring& spring = m_graph.getSprings()[s];
+            Vector3 delta = particles[spring.particle1]->position - particles[spring.particle2]->position;
+            float length = delta.length();
+
+            if (length < 1e-6f) {
+                m_projections[s] = Vector3(0, 0, 0);
+                continue;
+            }
+
+            m_projections[s] = delta * (spring.restLength / length);
+            if (spring.restLength > 0.0f) {
+                maxStrain = std::max(maxStrain, std::abs(length - spring.restLength) / spring.restLength);
+            }
+        }
+        m_slotMax[slot].value = std::max(m_slotMax[slot].value, maxStrain);
+    });
+
+    m_lastMaxStrain = 0.0f;
+    for (const SlotMax& slot : m_slotMax) {
+        m_lastMaxStrain = std::max(m_lastMaxStrain, slot.value);
+    }
+}
+
+void ProjectiveSolver::buildRightHandSide(const std::vector<ClothParticle*>& particles,
+                                          float deltaTime) {
+    const float w = m_settings.stiffness;
+    const float inverseStepSq = 1.0f / (deltaTime * deltaTime);
+
+    const int unknownCount = static_cast<int>(m_unknownParticle.size());
+
+    // b = M/h² s + w Σ ±p，相鄰的固定粒子移到右側：+ w q_j
+    runParallel(m_scheduler, m_deterministic, unknownCount, 512, [&](int begin, int end, int) {
+        for (int u = begin; u < end; ++u) {
+            const int i = m_unknownParticle[u];
+            Vector3 b = m_inertia[i] * (particles[i]->mass * inverseStepSq);
+
+            for (int n = m_graph.neighbourBegin(i); n < m_graph.neighbourEnd(i); ++n) {
+                const Neighbour& neighbour = m_graph.getNeighbour(n);
+                b += m_projections[neighbour.spring] * (w * neighbour.sign);
+                if (m_unknownIndex[neighbour.other] < 0) {
+                    b += particles[neighbour.other]->position * w;
+                }
+            }
+
+            double* rhs = &m_rhs[size_t(u) * 3];
+            rhs[0] = b.x();
+            rhs[1] = b.y();
+            rhs[2] = b.z();
+        }
+    });
+}
+
+void ProjectiveSolver::substitute() {
+    // 三個座標共用同一個因子，一次掃描同時處理，因子只需讀取一次
+    const int unknownCount = static_cast<int>(m_unknownParticle.size());
+
+    // 前代 L y = b
+    for (int i = 0; i < unknownCount; ++i) {
+        const int firstI = m_envelopeFirst[i];
+        const double* rowI = &m_factor[m_envelopeOffset[i]];
+        double sum0 = m_rhs[size_t(i) * 3 + 0];
+        double sum1 = m_rhs[size_t(i) * 3 + 1];
+        double sum2 = m_rhs[size_t(i) * 3 + 2];
+        for (int k = firstI; k < i; ++k) {
+            const double l = rowI[k - firstI];
+            sum0 -= l * m_rhs[size_t(k) * 3 + 0];
+            sum1 -= l * m_rhs[size_t(k) * 3 + 1];
+            sum2 -= l * m_rhs[size_t(k) * 3 + 2];
+        }
+        const double inverseDiagonal = 1.0 / rowI[i - firstI];
+        m_rhs[size_t(i) * 3 + 0] = sum0 * inverseDiagonal;
+        m_rhs[size_t(i) * 3 + 1] = sum1 * inverseDiagonal;
+        m_rhs[size_t(i) * 3 + 2] = sum2 * inverseDiagonal;
+    }
+
+    // 回代 Lᵀ x = y：以行為單位，解出 x_i 後立即自前面各列扣除
+    for (int i = unknownCount - 1; i >= 0; --i) {
+        const int firstI = m_envelopeFirst[i];
+        const double* rowI = &m_factor[m_envelopeOffset[i]];
+        const double inverseDiagonal = 1.0 / rowI[i - firstI];
+        const double x0 = m_rhs[size_t(i) * 3 + 0] * inverseDiagonal;
+        const double x1 = m_rhs[size_t(i) * 3 + 1] * inverseDiagonal;
+        const double x2 = m_rhs[size_t(i) * 3 + 2] * inverseDiagonal;
+        m_rhs[size_t(i) * 3 + 0] = x0;
+        m_rhs[size_t(i) * 3 + 1] = x1;
+        m_rhs[size_t(i) * 3 + 2] = x2;
+        for (int k = firstI; k < i; ++k) {
+            const double l = rowI[k - firstI];
+            m_rhs[size_t(k) * 3 + 0] -= l * x0;
+            m_rhs[size_t(k) * 3 + 1] -= l * x1;
+            m_rhs[size_t(k) * 3 + 2] -= l * x2;
+        }
+    }
+}
+
+} // namespace Physics
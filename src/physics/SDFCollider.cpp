@@ -0,0 +1,333 @@
+#include "physics/SDFCollider.h"
+#include "physics/Geometry.h"
+#include <cmath>
+#include <algorithm>
+#include <limits>
+
+namespace Physics {
+
+namespace {
+// 批次查詢的區塊大小（每個區塊的暫存陣列放在堆疊上）
+constexpr int kQueryBlock = 64;
+
+void runRange(TaskScheduler* scheduler, int count, const TaskScheduler::RangeFunction& fn) {
+    if (count <= 0) return;
+    if (!scheduler) {
+        fn(0, count, 0);
+        return;
+    }
+    // 每個切片只由一個任務寫入，分區方式不影響結果
+    scheduler->parallelFor(count, 1, fn, TaskScheduler::Partition::Dynamic);
+}
+}
+
+// ============================================================================
+// SDFCollider Implementation
+// ============================================================================
+
+SDFCollider::SDFCollider(const std::vector<Vector3>& vertices, const std::vector<int>& indices,
+                         float voxelSize, int bandVoxels, TaskScheduler* scheduler)
+    : m_origin(0, 0, 0)
+    , m_voxelSize(std::max(voxelSize, 1e-4f))
+    , m_invVoxelSize(1.0f / m_voxelSize)
+    , m_bandWidth(std::max(bandVoxels, 1) * m_voxelSize)
+    , m_sizeX(0)
+    , m_sizeY(0)
+    , m_sizeZ(0)
+    , m_transformed(false)
+{
+    build(vertices, indices, std::max(bandVoxels, 1), scheduler);
+}
+
+void SDFCollider::setTransform(const RigidTransform& transform) {
+    m_transform = transform;
+    const Quaternion& rotation = transform.getRotation();
+    m_transformed = transform.getTranslation() != Vector3(0, 0, 0) ||
+                    rotation.w != 1 || rotation.x != 0 || rotation.y != 0 || rotation.z != 0;
+}
+
+Vector3 SDFCollider::getBoundsMax() const {
+    return nodePosition(m_sizeX - 1, m_sizeY - 1, m_sizeZ - 1);
+}
+
+Vector3 SDFCollider::nodePosition(int x, int y, int z) const {
+    return m_origin + Vector3(x * m_voxelSize, y * m_voxelSize, z * m_voxelSize);
+}
+
+void SDFCollider::build(const std::vector<Vector3>& vertices, const std::vector<int>& indices,
+                        int bandVoxels, TaskScheduler* scheduler) {
+    const int triangleCount = static_cast<int>(indices.size() / 3);
+    if (vertices.empty() || triangleCount == 0) {
+        m_sizeX = m_sizeY = m_sizeZ = 0;
+        m_distances.clear();
+        return;
+    }
+
+    // 網格範圍：網格包圍盒向外擴張窄帶再加一個體素
+    Vector3 meshMin = vertices[0], meshMax = vertices[0];
+    for (const Vector3& v : vertices) {
+        for (int axis = 0; axis < 3; ++axis) {
+            meshMin[axis] = std::min(meshMin[axis], v[axis]);
+            meshMax[axis] = std::max(meshMax[axis], v[axis]);
+        }
+    }
+    const Real padding = (bandVoxels + 1) * m_voxelSize;
+    m_origin = meshMin - Vector3(padding, padding, padding);
+    int sizes[3];
+    for (int axis = 0; axis < 3; ++axis) {
+        Real extent = meshMax[axis] - meshMin[axis] + 2 * padding;
+        sizes[axis] = static_cast<int>(std::ceil(extent * m_invVoxelSize)) + 1;
+    }
+    m_sizeX = sizes[0];
+    m_sizeY = sizes[1];
+    m_sizeZ = sizes[2];
+    m_distances.assign(static_cast<std::size_t>(m_sizeX) * m_sizeY * m_sizeZ, m_bandWidth);
+
+    // 每個三角形影響的節點範圍（窄帶內）
+    struct TriangleRange {
+        int lo[3];
+        int hi[3];
+        Real minY, maxY;
+    };
+    std::vector<TriangleRange> ranges(triangleCount);
+    std::vector<std::vector<int>> sliceTriangles(m_sizeZ);
+    for (int t = 0; t < triangleCount; ++t) {
+        const Vector3& a = vertices[indices[3 * t]];
+        const Vector3& b = vertices[indices[3 * t + 1]];
+        const Vector3& c = vertices[indices[3 * t + 2]];
+        TriangleRange& range = ranges[t];
+        for (int axis = 0; axis < 3; ++axis) {
+            Real lo = std::min({a[axis], b[axis], c[axis]}) - m_bandWidth - m_origin[axis];
+            Real hi = std::max({a[axis], b[axis], c[axis]}) + m_bandWidth - m_origin[axis];
+            range.lo[axis] = std::max(0, static_cast<int>(std::floor(lo * m_invVoxelSize)));
+            range.hi[axis] = std::min(sizes[axis] - 1, static_cast<int>(std::ceil(hi * m_invVoxelSize)));
+        }
+        range.minY = std::min({a.y(), b.y(), c.y()});
+        range.maxY = std::max({a.y(), b.y(), c.y()});
+        for (int z = range.lo[2]; z <= range.hi[2]; ++z) {
+            sliceTriangles[z].push_back(t);
+        }
+    }
+
+    // 1. 窄帶內的無號距離：每個 Z 切片只由一個任務寫入
+    runRange(scheduler, m_sizeZ, [&](int begin, int end, int) {
+        for (int z = begin; z < end; ++z) {
+            for (int t : sliceTriangles[z]) {
+                const Vector3& a = vertices[indices[3 * t]];
+                const Vector3& b = vertices[indices[3 * t + 1]];
+                const Vector3& c = vertices[indices[3 * t + 2]];
+                const TriangleRange& range = ranges[t];
+                for (int y = range.lo[1]; y <= range.hi[1]; ++y) {
+                    for (int x = range.lo[0]; x <= range.hi[0]; ++x) {
+                        Vector3 p = nodePosition(x, y, z);
+                        float distance = static_cast<float>((p - closestPointOnTriangle(p, a, b, c)).length());
+                        float& stored = m_distances[nodeIndex(x, y, z)];
+                        stored = std::min(stored, distance);
+                    }
+                }
+            }
+        }
+    });
+
+    // 2. 符號：每列節點沿 X 軸射線與網格求交，交點數為奇數的節點在內部。
+    //    射線稍微偏離節點以避開三角形的邊與頂點
+    const Real jitterY = m_voxelSize * Real(1.3e-3);
+    const Real jitterZ = m_voxelSize * Real(0.7e-3);
+    runRange(scheduler, m_sizeZ, [&](int begin, int end, int) {
+        std::vector<Real> hits;
+        for (int z = begin; z < end; ++z) {
+            for (int y = 0; y < m_sizeY; ++y) {
+                Vector3 origin = nodePosition(0, y, z) + Vector3(0, jitterY, jitterZ);
+                hits.clear();
+                for (int t : sliceTriangles[z]) {
+                    const TriangleRange& range = ranges[t];
+                    if (origin.y() < range.minY || origin.y() > range.maxY) continue;
+                    Real hitX;
+                    if (intersectLineX(origin, vertices[indices[3 * t]], vertices[indices[3 * t + 1]],
+                                       vertices[indices[3 * t + 2]], hitX)) {
+                        hits.push_back(hitX);
+                    }
+                }
+                if (hits.empty()) continue;
+                std::sort(hits.begin(), hits.end());
+
+                std::size_t crossed = 0;
+                for (int x = 0; x < m_sizeX; ++x) {
+                    Real nodeX = origin.x() + x * m_voxelSize;
+                    while (crossed < hits.size() && hits[crossed] < nodeX) ++crossed;
+                    if (crossed & 1) {
+                        float& stored = m_distances[nodeIndex(x, y, z)];
+                        stored = -stored;
+                    }
+                }
+            }
+        }
+    });
+
+    // 3. 窄帶外以快速掃描法（fast sweeping）解 Eikonal 方程 |∇d| = 1，
+    //    深入內部的粒子仍能得到有意義的距離與梯度
+    std::vector<unsigned char> frozen(m_distances.size());
+    for (std::size_t i = 0; i < m_distances.size(); ++i) {
+        frozen[i] = std::abs(m_distances[i]) < m_bandWidth;
+    }
+    sweepFarField(frozen);
+}
+
+void SDFCollider::sweepFarField(const std::vector<unsigned char>& frozen) {
+    const float h = m_voxelSize;
+    const int strideY = m_sizeX;
+    const int strideZ = m_sizeX * m_sizeY;
+    const float unknown = std::numeric_limits<float>::max();
+
+    // 以絕對值求解，符號保留在 sign 中
+    std::vector<float> magnitude(m_distances.size());
+    std::vector<signed char> sign(m_distances.size());
+    for (std::size_t i = 0; i < m_distances.size(); ++i) {
+        sign[i] = m_distances[i] < 0.0f ? -1 : 1;
+        magnitude[i] = frozen[i] ? std::abs(m_distances[i]) : unknown;
+    }
+
+    auto neighbourMin = [&](int index, int coordinate, int size, int stride) {
+        float value = unknown;
+        if (coordinate > 0) value = std::min(value, magnitude[index - stride]);
+        if (coordinate < size - 1) value = std::min(value, magnitude[index + stride]);
+        return value;
+    };
+
+    // 八個掃描方向各一次
+    for (int sweep = 0; sweep < 8; ++sweep) {
+        const bool flipX = sweep & 1, flipY = sweep & 2, flipZ = sweep & 4;
+        for (int zi = 0; zi < m_sizeZ; ++zi) {
+            const int z = flipZ ? m_sizeZ - 1 - zi : zi;
+            for (int yi = 0; yi < m_sizeY; ++yi) {
+                const int y = flipY ? m_sizeY - 1 - yi : yi;
+                for (int xi = 0; xi < m_sizeX; ++xi) {
+                    const int x = flipX ? m_sizeX - 1 - xi : xi;
+                    const int index = nodeIndex(x, y, z);
+                    if (frozen[index]) continue;
+
+                    float a[3] = {neighbourMin(index, x, m_sizeX, 1),
+                                  neighbourMin(index, y, m_sizeY, strideY),
+                                  neighbourMin(index, z, m_sizeZ, strideZ)};
+                    std::sort(a, a + 3);
+                    if (a[0] == unknown) continue;
+
+                    // 由一維到三維逐步求解二次方程，取第一個不超過下一個鄰居的解
+                    float value = a[0] + h;
+                    if (value > a[1]) {
+                        float sum = a[0] + a[1];
+                        float discriminant = 2.0f * h * h - (a[0] - a[1]) * (a[0] - a[1]);
+                        value = 0.5f * (sum + std::sqrt(std::max(discriminant, 0.0f)));
+                        if (value > a[2]) {
+                            sum += a[2];
+                            float squares = a[0] * a[0] + a[1] * a[1] + a[2] * a[2];
+                            discriminant = sum * sum - 3.0f * (squares - h * h);
+                            value = (sum + std::sqrt(std::max(discriminant, 0.0f))) / 3.0f;
+                        }
+                    }
+                    magnitude[index] = std::min(magnitude[index], value);
+                }
+            }
+        }
+    }
+
+    for (std::size_t i = 0; i < m_distances.size(); ++i) {
+        if (!frozen[i] && magnitude[i] != unknown) {
+            m_distances[i] = sign[i] * magnitude[i];
+        }
+    }
+}
+
+bool SDFCollider::query(const Vector3& position, Sample& sample) const {
+    queryBatch(&position, 1, &sample);
+    return sample.normal.lengthSquared() > 0;
+}
+
+void SDFCollider::queryBatch(const Vector3* positions, int count, Sample* samples) const {
+    if (m_distances.empty()) {
+        for (int i = 0; i < count; ++i) {
+            samples[i].distance = std::numeric_limits<float>::max();
+            samples[i].normal = Vector3(0, 0, 0);
+        }
+        return;
+    }
+
+    const float maxX = static_cast<float>(m_sizeX - 1);
+    const float maxY = static_cast<float>(m_sizeY - 1);
+    const float maxZ = static_cast<float>(m_sizeZ - 1);
+    const int strideY = m_sizeX;
+    const int strideZ = m_sizeX * m_sizeY;
+    const float outsideDistance = std::numeric_limits<float>::max();
+
+    // 區塊內的結構陣列（SoA）暫存
+    float tx[kQueryBlock], ty[kQueryBlock], tz[kQueryBlock];
+    float inside[kQueryBlock];
+    int base[kQueryBlock];
+    float corner[8][kQueryBlock];
+
+    for (int blockBegin = 0; blockBegin < count; blockBegin += kQueryBlock) {
+        const int n = std::min(kQueryBlock, count - blockBegin);
+        const Vector3* p = positions + blockBegin;
+
+        // 1. 網格座標、格點索引與內插權重
+        for (int i = 0; i < n; ++i) {
+            const Vector3 local = m_transformed ? m_transform.applyInverse(p[i]) : p[i];
+            float fx = static_cast<float>((local.x() - m_origin.x()) * m_invVoxelSize);
+            float fy = static_cast<float>((local.y() - m_origin.y()) * m_invVoxelSize);
+            float fz = static_cast<float>((local.z() - m_origin.z()) * m_invVoxelSize);
+            inside[i] = (fx >= 0.0f && fx <= maxX && fy >= 0.0f && fy <= maxY && fz >= 0.0f && fz <= maxZ) ? 1.0f : 0.0f;
+
+            fx = std::min(std::max(fx, 0.0f), maxX);
+            fy = std::min(std::max(fy, 0.0f), maxY);
+            fz = std::min(std::max(fz, 0.0f), maxZ);
+            int ix = std::min(static_cast<int>(fx), m_sizeX - 2);
+            int iy = std::min(static_cast<int>(fy), m_sizeY - 2);
+            int iz = std::min(static_cast<int>(fz), m_sizeZ - 2);
+            tx[i] = fx - ix;
+            ty[i] = fy - iy;
+            tz[i] = fz - iz;
+            base[i] = iz * strideZ + iy * strideY + ix;
+        }
+
+        // 2. 收集八個格點的距離
+        for (int i = 0; i < n; ++i) {
+            const float* c = m_distances.data() + base[i];
+            corner[0][i] = c[0];
+            corner[1][i] = c[1];
+            corner[2][i] = c[strideY];
+            corner[3][i] = c[strideY + 1];
+            corner[4][i] = c[strideZ];
+            corner[5][i] = c[strideZ + 1];
+            corner[6][i] = c[strideZ + strideY];
+            corner[7][i] = c[strideZ + strideY + 1];
+        }
+
+        // 3. 三線性內插與解析梯度
+        for (int i = 0; i < n; ++i) {
+            const float x1 = tx[i], y1 = ty[i], z1 = tz[i];
+            const float x0 = 1.0f - x1, y0 = 1.0f - y1, z0 = 1.0f - z1;
+            const float c000 = corner[0][i], c100 = corner[1][i], c010 = corner[2][i], c110 = corner[3][i];
+            const float c001 = corner[4][i], c101 = corner[5][i], c011 = corner[6][i], c111 = corner[7][i];
+
+            float distance = z0 * (y0 * (x0 * c000 + x1 * c100) + y1 * (x0 * c010 + x1 * c110))
+                           + z1 * (y0 * (x0 * c001 + x1 * c101) + y1 * (x0 * c011 + x1 * c111));
+            float gx = z0 * (y0 * (c100 - c000) + y1 * (c110 - c010)) + z1 * (y0 * (c101 - c001) + y1 * (c111 - c011));
+            float gy = z0 * (x0 * (c010 - c000) + x1 * (c110 - c100)) + z1 * (x0 * (c011 - c001) + x1 * (c111 - c101));
+            float gz = y0 * (x0 * (c001 - c000) + x1 * (c101 - c100)) + y1 * (x0 * (c011 - c010) + x1 * (c111 - c110));
+
+            float length = std::sqrt(gx * gx + gy * gy + gz * gz);
+            float scale = length > 1e-12f ? inside[i] / length : 0.0f;
+
+            samples[blockBegin + i].distance = inside[i] > 0.0f ? distance : outsideDistance;
+            samples[blockBegin + i].normal = Vector3(gx * scale, gy * scale, gz * scale);
+        }
+
+        if (m_transformed) {
+            for (int i = 0; i < n; ++i) {
+                samples[blockBegin + i].normal = m_transform.rotate(samples[blockBegin + i].normal);
+            }
+        }
+    }
+}
+
+} // namespace Physics
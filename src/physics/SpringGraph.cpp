@@ -0,0 +1,50 @@
+#include "physics/SpringGraph.h"
+#include "physics/ClothSimulation.h"
+
+namespace Physics {
+
+void SpringGraph::build(const std::vector<ClothParticle*>& particles,
+                        const std::vector<std::unique_ptr<ClothConstraint>>& constraints) {
+    const int particleCount = static_cast<int>(particles.size());
+
+    m_particleIndex.clear();
+    m_particleIndex.reserve(particleCount);
+    for (int i = 0; i < particleCount; ++i) {
+        m_particleIndex[particles[i]] = i;
+    }
+
+    m_springs.clear();
+    m_springs.reserve(constraints.size());
+    for (const auto& constraint : constraints) {
+        m_springs.push_back({m_particleIndex[constraint->particle1],
+                             m_particleIndex[constraint->particle2],
+                             constraint->getRestLength()});
+    }
+
+    // 每個粒子的鄰接順序固定，收集結果與執行緒數無關
+    std::vector<int> counts(particleCount, 0);
+    for (const Spring& spring : m_springs) {
+        ++counts[spring.particle1];
+        ++counts[spring.particle2];
+    }
+
+    m_neighbourOffsets.assign(particleCount + 1, 0);
+    for (int i = 0; i < particleCount; ++i) {
+        m_neighbourOffsets[i + 1] = m_neighbourOffsets[i] + counts[i];
+    }
+
+    m_neighbours.resize(m_neighbourOffsets.back());
+    std::vector<int> cursor(m_neighbourOffsets.begin(), m_neighbourOffsets.end() - 1);
+    for (int s = 0; s < static_cast<int>(m_springs.size()); ++s) {
+        const Spring& spring = m_springs[s];
+        m_neighbours[cursor[spring.particle1]++] = {s, spring.particle2, 1.0f};
+        m_neighbours[cursor[spring.particle2]++] = {s, spring.particle1, -1.0f};
+    }
+}
+
+int SpringGraph::findParticle(const ClothParticle* particle) const {
+    auto found = m_particleIndex.find(particle);
+    return found != m_particleIndex.end() ? found->second : -1;
+}
+
+} // namespace Physics
@@ -0,0 +1,318 @@
+#include "physics/TaskScheduler.h"
+#include <algorithm>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace Physics {
+
+namespace {
+// 目前執行緒在各排程器中的槽位（後進入的在尾端）；工作執行緒以自己的槽位開始，
+// 外部執行緒只在 parallelFor 或等待期間綁定槽位 0，巢狀使用其他排程器時依序堆疊
+struct SlotBinding {
+    const TaskScheduler* scheduler;
+    int slot;
+};
+thread_local std::vector<SlotBinding> t_bindings;
+
+const SlotBinding* findBinding(const TaskScheduler* scheduler) {
+    for (auto it = t_bindings.rbegin(); it != t_bindings.rend(); ++it) {
+        if (it->scheduler == scheduler) return &*it;
+    }
+    return nullptr;
+}
+}
+
+/**
+ * @brief 外部執行緒獨占槽位 0 的範圍
+ *
+ * 槽位 0 只有一組佇列與每槽位暫存區，多個外部執行緒共用排程器時依序取得；
+ * 工作執行緒與已綁定的執行緒（巢狀呼叫）直接通過。
+ */
+class TaskScheduler::CallerScope {
+public:
+    explicit CallerScope(TaskScheduler& scheduler)
+        : m_scheduler(scheduler)
+        , m_bound(findBinding(&scheduler) == nullptr)
+    {
+        if (!m_bound) return;
+        m_scheduler.m_callerMutex.lock();
+        t_bindings.push_back({&m_scheduler, 0});
+    }
+
+    ~CallerScope() {
+        if (!m_bound) return;
+        t_bindings.pop_back();
+        m_scheduler.m_callerMutex.unlock();
+    }
+
+    CallerScope(const CallerScope&) = delete;
+    CallerScope& operator=(const CallerScope&) = delete;
+
+private:
+    TaskScheduler& m_scheduler;
+    bool m_bound;
+};
+
+// ============================================================================
+// TaskScheduler Implementation
+// ============================================================================
+
+TaskScheduler::TaskScheduler(int threadCount) {
+    m_config.threadCount = threadCount;
+    start();
+}
+
+TaskScheduler::TaskScheduler(const Config& config)
+    : m_config(config)
+{
+    start();
+}
+
+TaskScheduler::~TaskScheduler() {
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+        m_stopping.store(true);
+    }
+    m_wakeCondition.notify_all();
+
+    for (auto& worker : m_workers) {
+        worker.join();
+    }
+}
+
+void TaskScheduler::start() {
+    m_threadCount = m_config.threadCount > 0 ? m_config.threadCount : hardwareThreadCount();
+
+    for (int slot = 0; slot < m_threadCount; ++slot) {
+        m_queues.push_back(std::make_unique<WorkQueue>());
+    }
+
+    // 槽位 0 屬於呼叫端執行緒，其餘槽位各自對應一個工作執行緒
+    for (int slot = 1; slot < m_threadCount; ++slot) {
+        m_workers.emplace_back(&TaskScheduler::workerLoop, this, slot);
+    }
+}
+
+int TaskScheduler::hardwareThreadCount() {
+    return std::max(1u, std::thread::hardware_concurrency());
+}
+
+void TaskScheduler::staticRange(int count, int slotCount, int slot, int& begin, int& end) {
+    // 使用 64 位元運算避免大範圍時溢位
+    begin = static_cast<int>(static_cast<long long>(count) * slot / slotCount);
+    end = static_cast<int>(static_cast<long long>(count) * (slot + 1) / slotCount);
+}
+
+int TaskScheduler::currentSlot() const {
+    const SlotBinding* binding = findBinding(this);
+    return binding ? binding->slot : 0;
+}
+
+void TaskScheduler::submit(Task task) {
+    const int slot = currentSlot();
+    {
+        std::lock_guard<std::mutex> lock(m_queues[slot]->mutex);
+        m_queues[slot]->tasks.push_back(std::move(task));
+    }
+    m_queuedTasks.fetch_add(1);
+
+    if (m_threadCount > 1) {
+        // 先取得休眠鎖再通知，避免工作執行緒在檢查條件與進入等待之間錯過喚醒
+        { std::lock_guard<std::mutex> lock(m_sleepMutex); }
+        m_wakeCondition.notify_one();
+    }
+}
+
+void TaskScheduler::waitUntilZero(const std::atomic<int>& remaining) {
+    CallerScope scope(*this);
+    const int slot = currentSlot();
+    while (remaining.load(std::memory_order_acquire) > 0) {
+        if (!tryRunOne(slot)) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+void TaskScheduler::parallelFor(int count, int grainSize, const RangeFunction& fn, Partition partition) {
+    if (count <= 0) return;
+    CallerScope scope(*this);
+
+    // 單執行緒時兩種分區都只有一段範圍
+    if (m_threadCount == 1) {
+        fn(0, count, 0);
+        return;
+    }
+
+    std::atomic<int> remaining{0};
+
+    if (partition == Partition::Static) {
+        // 固定分區：每段範圍與槽位的對應只由執行緒數決定
+        remaining.store(m_threadCount, std::memory_order_relaxed);
+        for (int slot = 1; slot < m_threadCount; ++slot) {
+            submit([&fn, &remaining, count, slot, this]() {
+                int begin, end;
+                staticRange(count, m_threadCount, slot, begin, end);
+                if (begin < end) fn(begin, end, slot);
+                remaining.fetch_sub(1, std::memory_order_release);
+            });
+        }
+
+        int begin, end;
+        staticRange(count, m_threadCount, 0, begin, end);
+        if (begin < end) fn(begin, end, 0);
+        remaining.fetch_sub(1, std::memory_order_release);
+        waitUntilZero(remaining);
+    } else {
+        // 動態分區：遞迴二分，後半段放入佇列供其他執行緒竊取，前半段繼續切分
+        const int grain = std::max(1, grainSize);
+        std::function<void(int, int)> runRange = [&](int begin, int end) {
+            while (end - begin > grain) {
+                int middle = begin + ((end - begin) / 2 + grain - 1) / grain * grain;
+                if (middle >= end) break;
+                remaining.fetch_add(1, std::memory_order_relaxed);
+                submit([&runRange, middle, end]() { runRange(middle, end); });
+                end = middle;
+            }
+            fn(begin, end, currentSlot());
+            remaining.fetch_sub(1, std::memory_order_release);
+        };
+
+        remaining.store(1, std::memory_order_relaxed);
+        runRange(0, count);
+
+        // 佇列中的區塊仍引用 runRange，必須在它離開作用域前等待完成
+        waitUntilZero(remaining);
+    }
+}
+
+void TaskScheduler::workerLoop(int slot) {
+    t_bindings.push_back({this, slot});
+
+    if (m_config.pinThreads) {
+        pinCurrentThread(slot);
+    }
+
+    while (!m_stopping.load()) {
+        if (tryRunOne(slot)) continue;
+
+        std::unique_lock<std::mutex> lock(m_sleepMutex);
+        m_wakeCondition.wait(lock, [this]() {
+            return m_stopping.load() || m_queuedTasks.load() > 0;
+        });
+    }
+}
+
+bool TaskScheduler::tryRunOne(int slot) {
+    Task task;
+    if (popLocal(slot, task) || steal(slot, task)) {
+        task();
+        return true;
+    }
+    return false;
+}
+
+bool TaskScheduler::popLocal(int slot, Task& task) {
+    WorkQueue& queue = *m_queues[slot];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.tasks.empty()) return false;
+
+    // 擁有者從尾端取出最新的任務（LIFO，快取區域性較好）
+    task = std::move(queue.tasks.back());
+    queue.tasks.pop_back();
+    m_queuedTasks.fetch_sub(1);
+    return true;
+}
+
+bool TaskScheduler::steal(int thief, Task& task) {
+    for (int offset = 1; offset < m_threadCount; ++offset) {
+        WorkQueue& queue = *m_queues[(thief + offset) % m_threadCount];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.tasks.empty()) continue;
+
+        // 竊取者從前端取出最舊的任務（通常是較大的區塊）
+        task = std::move(queue.tasks.front());
+        queue.tasks.pop_front();
+        m_queuedTasks.fetch_sub(1);
+        return true;
+    }
+    return false;
+}
+
+void TaskScheduler::pinCurrentThread(int slot) {
+#if defined(__linux__)
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    CPU_SET((m_config.firstCore + slot - 1) % hardwareThreadCount(), &cpuSet);
+    pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet);
+#else
+    // macOS 不支援強制綁定核心，保留由系統排程
+    (void)slot;
+#endif
+}
+
+void runParallel(TaskScheduler* scheduler, bool deterministic, int count, int grainSize,
+                 const TaskScheduler::RangeFunction& fn) {
+    if (!scheduler) {
+        if (count > 0) fn(0, count, 0);
+        return;
+    }
+
+    scheduler->parallelFor(count, grainSize, fn,
+                           deterministic ? TaskScheduler::Partition::Static
+                                         : TaskScheduler::Partition::Dynamic);
+}
+
+// ============================================================================
+// TaskGraph Implementation
+// ============================================================================
+
+TaskGraph::NodeId TaskGraph::addTask(TaskScheduler::Task task) {
+    auto node = std::make_unique<Node>();
+    node->task = std::move(task);
+    m_nodes.push_back(std::move(node));
+    return static_cast<NodeId>(m_nodes.size()) - 1;
+}
+
+void TaskGraph::addDependency(NodeId before, NodeId after) {
+    m_nodes[before]->successors.push_back(after);
+    ++m_nodes[after]->dependencyCount;
+}
+
+void TaskGraph::run(TaskScheduler& scheduler) {
+    if (m_nodes.empty()) return;
+
+    std::atomic<int> remaining{static_cast<int>(m_nodes.size())};
+    for (auto& node : m_nodes) {
+        node->pendingDependencies.store(node->dependencyCount, std::memory_order_relaxed);
+    }
+
+    for (NodeId id = 0; id < size(); ++id) {
+        if (m_nodes[id]->dependencyCount == 0) {
+            submitNode(scheduler, id, remaining);
+        }
+    }
+
+    scheduler.waitUntilZero(remaining);
+}
+
+void TaskGraph::submitNode(TaskScheduler& scheduler, NodeId id, std::atomic<int>& remaining) {
+    scheduler.submit([this, &scheduler, id, &remaining]() {
+        Node& node = *m_nodes[id];
+        node.task();
+
+        // 後繼任務的前置計數歸零時才提交
+        for (NodeId next : node.successors) {
+            if (m_nodes[next]->pendingDependencies.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                submitNode(scheduler, next, remaining);
+            }
+        }
+
+        // 最後才遞減，確保等待端返回時所有後繼任務都已提交
+        remaining.fetch_sub(1, std::memory_order_release);
+    });
+}
+
+} // namespace Physics
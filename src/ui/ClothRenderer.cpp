@@ -0,0 +1,281 @@
+#include "ui/ClothRenderer.h"
+#include "physics/ClothSimulation.h"
+#include <cmath>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+#ifdef __APPLE__
+#include <OpenGL/gl3.h>
+#else
+#include <GL/gl.h>
+#endif
+
+namespace UI {
+
+namespace {
+void emitVertex(const Physics::Vector3& position) {
+    glVertex3f(static_cast<float>(position.x()), static_cast<float>(position.y()), static_cast<float>(position.z()));
+}
+
+// 以 u、v 兩個正交方向張成的圓（線框）
+void emitCircle(const Physics::Vector3& center, const Physics::Vector3& u, const Physics::Vector3& v, float radius) {
+    const int segments = 24;
+    glBegin(GL_LINE_LOOP);
+    for (int i = 0; i < segments; ++i) {
+        float angle = 2.0f * M_PI * i / segments;
+        emitVertex(center + u * (radius * cos(angle)) + v * (radius * sin(angle)));
+    }
+    glEnd();
+}
+
+void emitParticles(const Physics::ClothSimulation& simulation) {
+    glBegin(GL_POINTS);
+    for (const auto& particle : simulation.getParticles()) {
+        if (particle) {
+            emitVertex(particle->position);
+        }
+    }
+    glEnd();
+}
+
+void emitConstraints(const Physics::ClothSimulation& simulation) {
+    glBegin(GL_LINES);
+    for (const auto& constraint : simulation.getConstraints()) {
+        if (constraint && constraint->particle1 && constraint->particle2) {
+            emitVertex(constraint->particle1->position);
+            emitVertex(constraint->particle2->position);
+        }
+    }
+    glEnd();
+}
+}
+
+void ClothRenderer::render(const Physics::ClothSimulation& simulation) const {
+    const auto& particles = simulation.getParticles();
+    if (particles.empty()) return;
+    
+    // 使用基本 OpenGL 立即模式渲染布料
+    glPushMatrix();
+    
+    // 停用光照以簡化渲染
+    glDisable(GL_LIGHTING);
+    
+    // 1. 渲染布料粒子
+    glColor3f(1.0f, 0.2f, 0.2f);  // 紅色粒子
+    glPointSize(4.0f);
+    emitParticles(simulation);
+    
+    // 2. 渲染約束線（布料結構）
+    glColor3f(0.4f, 0.4f, 0.8f);  // 藍色連接線
+    glLineWidth(1.0f);
+    emitConstraints(simulation);
+    
+    // 3. 渲染布料表面（半透明）
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    glColor4f(0.2f, 0.8f, 0.6f, 0.6f);  // 半透明綠色布料
+    
+    glBegin(GL_TRIANGLES);
+    for (const auto& triangle : simulation.getTriangles()) {
+        emitVertex(particles[triangle[0]]->position);
+        emitVertex(particles[triangle[1]]->position);
+        emitVertex(particles[triangle[2]]->position);
+    }
+    glEnd();
+    
+    glDisable(GL_BLEND);
+    glPopMatrix();
+}
+
+void ClothRenderer::renderWireframe(const Physics::ClothSimulation& simulation) const {
+    glPushMatrix();
+    glDisable(GL_LIGHTING);
+    
+    glColor3f(0.2f, 0.2f, 0.8f);  // 線框顏色
+    glLineWidth(1.0f);
+    emitConstraints(simulation);
+    
+    glPopMatrix();
+}
+
+void ClothRenderer::renderParticles(const Physics::ClothSimulation& simulation) const {
+    glPushMatrix();
+    glDisable(GL_LIGHTING);
+    
+    glColor3f(1.0f, 0.0f, 0.0f);  // 粒子顏色
+    glPointSize(3.0f);
+    emitParticles(simulation);
+    
+    glPopMatrix();
+}
+
+void ClothRenderer::renderColliders(const Physics::ClothSimulation& simulation) const {
+    const auto& cylinders = simulation.getCylinders();
+    const auto& colliders = simulation.getColliderSet();
+    const auto& sdfColliders = colliders.getSDFs();
+    if (cylinders.empty() && colliders.empty()) return;
+    
+    glPushMatrix();
+    glDisable(GL_LIGHTING);
+    
+    for (const auto& cylinder : cylinders) {
+        if (!cylinder) continue;
+        
+        glPushMatrix();
+        
+        // 移動到圓柱體位置
+        glTranslatef(static_cast<float>(cylinder->center.x()),
+                     static_cast<float>(cylinder->center.y()),
+                     static_cast<float>(cylinder->center.z()));
+        
+        // 設定圓柱體顏色
+        glColor3f(0.8f, 0.4f, 0.2f);  // 橙色圓柱體
+        
+        // 簡單的圓柱體渲染（使用線框）
+        const int segments = 16;
+        const float radius = cylinder->radius;
+        const float height = cylinder->height;
+        
+        // 渲染圓柱體底面
+        glBegin(GL_LINE_LOOP);
+        for (int i = 0; i < segments; ++i) {
+            float angle = 2.0f * M_PI * i / segments;
+            float x = radius * cos(angle);
+            float z = radius * sin(angle);
+            glVertex3f(x, -height/2, z);
+        }
+        glEnd();
+        
+        // 渲染圓柱體頂面
+        glBegin(GL_LINE_LOOP);
+        for (int i = 0; i < segments; ++i) {
+            float angle = 2.0f * M_PI * i / segments;
+            float x = radius * cos(angle);
+            float z = radius * sin(angle);
+            glVertex3f(x, height/2, z);
+        }
+        glEnd();
+        
+        // 渲染圓柱體側面線條
+        glBegin(GL_LINES);
+        for (int i = 0; i < segments; i += 2) {  // 每隔一條線渲染
+            float angle = 2.0f * M_PI * i / segments;
+            float x = radius * cos(angle);
+            float z = radius * sin(angle);
+            glVertex3f(x, -height/2, z);
+            glVertex3f(x, height/2, z);
+        }
+        glEnd();
+        
+        glPopMatrix();
+    }
+    
+    // 解析形狀碰撞體
+    const Physics::Vector3 unitX(1, 0, 0), unitY(0, 1, 0), unitZ(0, 0, 1);
+    glColor3f(0.3f, 0.6f, 0.8f);
+    for (const auto& sphere : colliders.getSpheres()) {
+        emitCircle(sphere.center, unitX, unitY, sphere.radius);
+        emitCircle(sphere.center, unitY, unitZ, sphere.radius);
+        emitCircle(sphere.center, unitZ, unitX, sphere.radius);
+    }
+    
+    for (const auto& capsule : colliders.getCapsules()) {
+        Physics::Vector3 axis = capsule.pointB - capsule.pointA;
+        Physics::Vector3 w = axis.lengthSquared() > 0 ? axis.normalized() : unitY;
+        Physics::Vector3 u = Physics::Vector3::crossProduct(w, std::abs(w.x()) < 0.9f ? unitX : unitY).normalized();
+        Physics::Vector3 v = Physics::Vector3::crossProduct(w, u);
+        emitCircle(capsule.pointA, u, v, capsule.radius);
+        emitCircle(capsule.pointB, u, v, capsule.radius);
+        emitCircle(capsule.pointA + axis * 0.5f, u, w, capsule.radius);
+        
+        glBegin(GL_LINES);
+        for (const Physics::Vector3& side : {u, v, u * -1.0f, v * -1.0f}) {
+            emitVertex(capsule.pointA + side * capsule.radius);
+            emitVertex(capsule.pointB + side * capsule.radius);
+        }
+        glEnd();
+    }
+    
+    for (const auto& box : colliders.getBoxes()) {
+        glBegin(GL_LINES);
+        for (int edge = 0; edge < 12; ++edge) {
+            // 每條邊沿一個局部軸，另外兩軸取 ±halfExtents
+            int axis = edge / 4;
+            Physics::Vector3 a, b;
+            for (int k = 0; k < 3; ++k) {
+                int other = (k - axis + 3) % 3;
+                float sign = other == 1 ? ((edge & 1) ? 1.0f : -1.0f) : ((edge & 2) ? 1.0f : -1.0f);
+                a[k] = (k == axis) ? -box.halfExtents[k] : sign * box.halfExtents[k];
+                b[k] = (k == axis) ? box.halfExtents[k] : a[k];
+            }
+            emitVertex(box.transform.apply(a));
+            emitVertex(box.transform.apply(b));
+        }
+        glEnd();
+    }
+    
+    for (const auto& plane : colliders.getPlanes()) {
+        // 平面畫成原點投影附近的有限網格
+        Physics::Vector3 n = plane.normal;
+        Physics::Vector3 u = Physics::Vector3::crossProduct(n, std::abs(n.x()) < 0.9f ? unitX : unitY).normalized();
+        Physics::Vector3 v = Physics::Vector3::crossProduct(n, u);
+        Physics::Vector3 center = n * plane.offset;
+        const int lines = 10;
+        const float extent = 5.0f;
+        
+        glBegin(GL_LINES);
+        for (int i = -lines; i <= lines; ++i) {
+            float t = extent * i / lines;
+            emitVertex(center + u * t - v * extent);
+            emitVertex(center + u * t + v * extent);
+            emitVertex(center + v * t - u * extent);
+            emitVertex(center + v * t + u * extent);
+        }
+        glEnd();
+    }
+    
+    // 網格碰撞體畫出三角形邊
+    glColor3f(0.5f, 0.7f, 0.4f);
+    for (const auto& mesh : colliders.getMeshes()) {
+        const auto& vertices = mesh->getVertices();
+        const auto& indices = mesh->getIndices();
+        for (std::size_t t = 0; t + 2 < indices.size(); t += 3) {
+            glBegin(GL_LINE_LOOP);
+            emitVertex(vertices[indices[t]]);
+            emitVertex(vertices[indices[t + 1]]);
+            emitVertex(vertices[indices[t + 2]]);
+            glEnd();
+        }
+    }
+    
+    // 距離場碰撞體只畫出網格範圍（局部座標，依目前姿態變換）
+    glColor3f(0.6f, 0.6f, 0.2f);
+    for (const auto& collider : sdfColliders) {
+        const Physics::Vector3 lo = collider->getBoundsMin();
+        const Physics::Vector3 hi = collider->getBoundsMax();
+        const Physics::RigidTransform& transform = collider->getTransform();
+        
+        glBegin(GL_LINES);
+        for (int edge = 0; edge < 12; ++edge) {
+            // 每條邊沿一個軸，另外兩個軸取最小或最大值
+            int axis = edge / 4;
+            int u = (edge & 1), v = (edge >> 1) & 1;
+            Physics::Vector3 a, b;
+            for (int k = 0; k < 3; ++k) {
+                int other = (k - axis + 3) % 3;
+                bool useHigh = other == 1 ? u : (other == 2 ? v : false);
+                a[k] = (k == axis) ? lo[k] : (useHigh ? hi[k] : lo[k]);
+                b[k] = (k == axis) ? hi[k] : a[k];
+            }
+            emitVertex(transform.apply(a));
+            emitVertex(transform.apply(b));
+        }
+        glEnd();
+    }
+    
+    glPopMatrix();
+}
+
+} // namespace UI
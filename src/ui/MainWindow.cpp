@@ -1,9 +1,12 @@
 #include "ui/MainWindow.h"
 #include "ui/OpenGLWidget.h"
+#include "physics/ClothLOD.h"
 #include "physics/ClothSimulation.h"
+#include "physics/TaskScheduler.h"
 #include <QApplication>
 #include <QDebug>
 #include <QTime>
+#include <QVector3D>
 
 namespace UI {
 
@@ -87,12 +90,35 @@ void MainWindow::setupSimulationGroup() {
     // 單步按鈕
     m_stepButton = new QPushButton("單步", m_simulationGroup);
     
+    // 執行緒設定
+    QHBoxLayout* threadLayout = new QHBoxLayout();
+    threadLayout->addWidget(new QLabel("執行緒數:"));
+    m_threadCountSpinBox = new QSpinBox(m_simulationGroup);
+    m_threadCountSpinBox->setRange(1, Physics::TaskScheduler::hardwareThreadCount());
+    m_threadCountSpinBox->setValue(m_clothSimulation->getThreadCount());
+    threadLayout->addWidget(m_threadCountSpinBox);
+    
+    m_pinThreadsCheckBox = new QCheckBox("綁定 CPU 核心", m_simulationGroup);
+    m_pinThreadsCheckBox->setChecked(false);
+    
+    // 自適應約束迭代
+    m_adaptiveIterationsCheckBox = new QCheckBox("自適應迭代次數", m_simulationGroup);
+    m_adaptiveIterationsCheckBox->setChecked(m_clothSimulation->isAdaptiveIterations());
+    
+    // 時間預算：動畫計時器每 16 ms 觸發一次，超過時自動降低品質
+    m_frameBudgetCheckBox = new QCheckBox("時間預算 (16 ms)", m_simulationGroup);
+    m_frameBudgetCheckBox->setChecked(false);
+    
     // 狀態標籤
     m_statusLabel = new QLabel("狀態: 停止", m_simulationGroup);
     
     layout->addWidget(m_startStopButton);
     layout->addWidget(m_resetButton);
     layout->addWidget(m_stepButton);
+    layout->addLayout(threadLayout);
+    layout->addWidget(m_pinThreadsCheckBox);
+    layout->addWidget(m_adaptiveIterationsCheckBox);
+    layout->addWidget(m_frameBudgetCheckBox);
     layout->addWidget(m_statusLabel);
     
     m_controlLayout->addWidget(m_simulationGroup);
@@ -195,6 +221,11 @@ void MainWindow::setupRenderGroup() {
     m_showCollidersCheckBox->setChecked(true);
     layout->addWidget(m_showCollidersCheckBox);
     
+    // 細節層級：相機拉遠時降低布料解析度
+    m_lodCheckBox = new QCheckBox("依相機距離切換解析度 (LOD)", m_renderGroup);
+    m_lodCheckBox->setChecked(false);
+    layout->addWidget(m_lodCheckBox);
+    
     // 相機重置
     m_resetCameraButton = new QPushButton("重置相機", m_renderGroup);
     layout->addWidget(m_resetCameraButton);
@@ -210,11 +241,15 @@ void MainWindow::setupStatsGroup() {
     m_constraintCountLabel = new QLabel("約束數: 0", m_statsGroup);
     m_simulationTimeLabel = new QLabel("模擬時間: 0.0s", m_statsGroup);
     m_fpsLabel = new QLabel("FPS: 0", m_statsGroup);
+    m_solverStatsLabel = new QLabel("迭代: 0", m_statsGroup);
+    m_qualityLabel = new QLabel("品質等級: 0", m_statsGroup);
     
     layout->addWidget(m_particleCountLabel);
     layout->addWidget(m_constraintCountLabel);
     layout->addWidget(m_simulationTimeLabel);
     layout->addWidget(m_fpsLabel);
+    layout->addWidget(m_solverStatsLabel);
+    layout->addWidget(m_qualityLabel);
     
     m_controlLayout->addWidget(m_statsGroup);
 }
@@ -224,6 +259,10 @@ void MainWindow::connectSignals() {
     connect(m_startStopButton, &QPushButton::clicked, this, &MainWindow::onStartStopClicked);
     connect(m_resetButton, &QPushButton::clicked, this, &MainWindow::onResetClicked);
     connect(m_stepButton, &QPushButton::clicked, this, &MainWindow::onStepClicked);
+    connect(m_threadCountSpinBox, QOverload<int>::of(&QSpinBox::valueChanged), this, &MainWindow::onThreadingChanged);
+    connect(m_pinThreadsCheckBox, &QCheckBox::toggled, this, &MainWindow::onThreadingChanged);
+    connect(m_adaptiveIterationsCheckBox, &QCheckBox::toggled, this, &MainWindow::onAdaptiveIterationsChanged);
+    connect(m_frameBudgetCheckBox, &QCheckBox::toggled, this, &MainWindow::onFrameBudgetChanged);
     
     // 場景參數
     connect(m_clothWidthSpinBox, QOverload<int>::of(&QSpinBox::valueChanged), this, &MainWindow::onClothSizeChanged);
@@ -242,6 +281,7 @@ void MainWindow::connectSignals() {
     connect(m_showWireframeCheckBox, &QCheckBox::toggled, this, &MainWindow::onShowWireframeChanged);
     connect(m_showParticlesCheckBox, &QCheckBox::toggled, this, &MainWindow::onShowParticlesChanged);
     connect(m_showCollidersCheckBox, &QCheckBox::toggled, this, &MainWindow::onShowCollidersChanged);
+    connect(m_lodCheckBox, &QCheckBox::toggled, this, &MainWindow::onLODChanged);
     connect(m_resetCameraButton, &QPushButton::clicked, this, &MainWindow::onResetCameraClicked);
 }
 
@@ -278,7 +318,12 @@ void MainWindow::onStartStopClicked() {
 }
 
 void MainWindow::onResetClicked() {
-    m_clothSimulation->reset();
+    // 以第 0 層重建，否則會以目前的層級解析度重建
+    if (m_clothLOD) {
+        m_clothLOD->reset();
+    } else {
+        m_clothSimulation->reset();
+    }
     m_openglWidget->update();
     statusBar()->showMessage("模擬已重置");
 }
@@ -290,11 +335,41 @@ void MainWindow::onStepClicked() {
     }
 }
 
+void MainWindow::onThreadingChanged() {
+    int threadCount = m_threadCountSpinBox->value();
+    
+    if (threadCount > 1) {
+        Physics::TaskScheduler::Config config;
+        config.threadCount = threadCount;
+        config.pinThreads = m_pinThreadsCheckBox->isChecked();
+        m_clothSimulation->setTaskScheduler(std::make_shared<Physics::TaskScheduler>(config));
+    } else {
+        m_clothSimulation->setTaskScheduler(nullptr);
+    }
+    
+    statusBar()->showMessage(QString("模擬執行緒數: %1").arg(threadCount));
+}
+
+void MainWindow::onAdaptiveIterationsChanged(bool enabled) {
+    m_clothSimulation->setAdaptiveIterations(enabled);
+    statusBar()->showMessage(enabled ? "自適應迭代已啟用" : "自適應迭代已停用");
+}
+
+void MainWindow::onFrameBudgetChanged(bool enabled) {
+    m_clothSimulation->setFrameBudget(enabled ? 16.0f : 0.0f);
+    statusBar()->showMessage(enabled ? "時間預算已啟用" : "時間預算已停用");
+}
+
 void MainWindow::onClothSizeChanged() {
     if (!m_isRunning) {
         int width = m_clothWidthSpinBox->value();
         int height = m_clothHeightSpinBox->value();
         m_clothSimulation->initialize(width, height, 0.2f);
+        if (m_clothLOD) {
+            // 新的解析度作為第 0 層
+            m_clothLOD = std::make_shared<Physics::ClothLOD>(m_clothSimulation);
+            m_openglWidget->setClothLOD(m_clothLOD);
+        }
         m_openglWidget->update();
     }
 }
@@ -340,16 +415,52 @@ void MainWindow::onShowCollidersChanged(bool show) {
     m_openglWidget->setShowColliders(show);
 }
 
+void MainWindow::onLODChanged(bool enabled) {
+    // 停用時先回到第 0 層；啟用時以目前的解析度作為第 0 層
+    if (m_clothLOD) {
+        m_clothLOD->setLevel(0);
+        m_clothLOD.reset();
+    }
+    if (enabled) {
+        m_clothLOD = std::make_shared<Physics::ClothLOD>(m_clothSimulation);
+    }
+    m_openglWidget->setClothLOD(m_clothLOD);
+    statusBar()->showMessage(enabled ? "細節層級已啟用" : "細節層級已停用");
+}
+
 void MainWindow::onResetCameraClicked() {
     m_openglWidget->resetCamera();
 }
 
 void MainWindow::updateStatus() {
     if (m_clothSimulation) {
-        m_particleCountLabel->setText(QString("粒子數: %1").arg(m_clothSimulation->getParticleCount()));
+        if (m_clothLOD) {
+            m_particleCountLabel->setText(QString("粒子數: %1 (LOD %2)")
+                                          .arg(m_clothSimulation->getParticleCount())
+                                          .arg(m_clothLOD->getLevel()));
+        } else {
+            m_particleCountLabel->setText(QString("粒子數: %1").arg(m_clothSimulation->getParticleCount()));
+        }
         m_constraintCountLabel->setText(QString("約束數: %1").arg(m_clothSimulation->getConstraintCount()));
         m_simulationTimeLabel->setText(QString("模擬時間: %1s").arg(m_clothSimulation->getSimulationTime(), 0, 'f', 2));
         
+        const Physics::SolverStats& stats = m_clothSimulation->getSolverStats();
+        if (m_clothSimulation->isAdaptiveIterations()) {
+            m_solverStatsLabel->setText(QString("迭代: %1, 最大應變: %2, RMS: %3")
+                                        .arg(stats.iterations)
+                                        .arg(stats.maxResidual, 0, 'g', 3)
+                                        .arg(stats.rmsResidual, 0, 'g', 3));
+        } else {
+            m_solverStatsLabel->setText(QString("迭代: %1").arg(stats.iterations));
+        }
+        
+        const Physics::StepQuality& quality = m_clothSimulation->getStepQuality();
+        m_qualityLabel->setText(QString("品質等級: %1 (子步 %2, 迭代 %3, %4 ms)")
+                                .arg(quality.level)
+                                .arg(quality.substeps)
+                                .arg(quality.constraintIterations)
+                                .arg(quality.stepMilliseconds, 0, 'f', 1));
+        
         // 簡單的 FPS 計算
         static int frameCount = 0;
         static QTime lastTime = QTime::currentTime();
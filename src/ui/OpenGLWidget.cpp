@@ -1,4 +1,5 @@
 #include "ui/OpenGLWidget.h"
+#include "physics/ClothLOD.h"
 #include "physics/ClothSimulation.h"
 #include <QDebug>
 #include <cmath>
@@ -152,6 +153,10 @@ void OpenGLWidget::wheelEvent(QWheelEvent* event) {
 
 void OpenGLWidget::updateAnimation() {
     if (m_clothSimulation && m_animating) {
+        // 相機繞目標點旋轉，到目標的距離即布料的觀看距離
+        if (m_clothLOD) {
+            m_clothLOD->selectByDistance(m_cameraDistance);
+        }
         m_clothSimulation->update(0.016f); // ~60 FPS
         update();
     }
@@ -182,23 +187,14 @@ void OpenGLWidget::renderCloth() {
     
     // 渲染粒子
     if (m_showParticles) {
-        glColor3f(1.0f, 0.2f, 0.2f);
-        glPointSize(4.0f);
-        glBegin(GL_POINTS);
-        
-        for (int i = 0; i < m_clothSimulation->getParticleCount(); ++i) {
-            // 這裡需要訪問粒子位置，但由於封裝性，我們使用渲染方法
-            // 實際實現中應該提供適當的訪問接口
-        }
-        
-        glEnd();
+        m_clothRenderer.renderParticles(*m_clothSimulation);
     }
     
-    // 使用布料模擬的內建渲染方法
+    // 由渲染轉接層繪製布料（物理核心不含 OpenGL 程式碼）
     if (m_showWireframe) {
-        m_clothSimulation->renderWireframe();
+        m_clothRenderer.renderWireframe(*m_clothSimulation);
     } else {
-        m_clothSimulation->render();
+        m_clothRenderer.render(*m_clothSimulation);
     }
     
     glPopMatrix();
@@ -209,8 +205,8 @@ void OpenGLWidget::renderColliders() {
     
     glPushMatrix();
     
-    // 使用布料模擬的碰撞體渲染方法
-    m_clothSimulation->renderColliders();
+    // 由渲染轉接層繪製碰撞體
+    m_clothRenderer.renderColliders(*m_clothSimulation);
     
     glPopMatrix();
 }